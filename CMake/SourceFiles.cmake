@@ -5,20 +5,82 @@ set(MAIN_SOURCE_FILES
 	Application/NamecheapDynamicDNSAutoUpdater.cpp
 	Application/SettingsManager.h
 	Application/SettingsManager.cpp
+	IO/AtomicFileWriter.h
+	IO/AtomicFileWriter.cpp
+	IO/FileWatcher.h
+	IO/FileWatcher.cpp
+	IO/MappedJSONDocument.h
+	IO/MappedJSONDocument.cpp
+	IO/MemoryMappedFile.h
+	IO/MemoryMappedFile.cpp
+	Metrics/ApplicationMetrics.h
+	Metrics/ApplicationMetrics.cpp
+	Metrics/Counter.h
+	Metrics/Counter.cpp
+	Metrics/Histogram.h
+	Metrics/Histogram.cpp
 	Namecheap/NamecheapDomainProfile.h
 	Namecheap/NamecheapDomainProfile.cpp
+	Namecheap/NamecheapDomainProfileArena.h
+	Namecheap/NamecheapDomainProfileArena.cpp
 	Namecheap/NamecheapDomainProfileCollection.h
 	Namecheap/NamecheapDomainProfileCollection.cpp
+	Namecheap/NamecheapDomainProfileCollectionReader.h
+	Namecheap/NamecheapDomainProfileCollectionReader.cpp
 	Namecheap/NamecheapDomainProfileManager.h
 	Namecheap/NamecheapDomainProfileManager.cpp
+	Namecheap/NamecheapDynamicDNSResponse.h
+	Namecheap/NamecheapDynamicDNSResponse.cpp
 	Namecheap/NamecheapDynamicDNSService.h
 	Namecheap/NamecheapDynamicDNSService.cpp
+	Namecheap/NamecheapDynamicDNSUpdateReport.h
+	Namecheap/NamecheapDynamicDNSUpdateReport.cpp
+	Namecheap/NamecheapHostTable.h
+	Namecheap/NamecheapHostTable.cpp
+	Namecheap/NamecheapIPAddressCache.h
+	Namecheap/NamecheapIPAddressCache.cpp
+	Namecheap/NamecheapUpdateJournal.h
+	Namecheap/NamecheapUpdateJournal.cpp
+	Namecheap/NamecheapUpdatePlanner.h
+	Namecheap/NamecheapUpdatePlanner.cpp
+	Network/AddressChangeMonitor.h
+	Network/AddressChangeMonitor.cpp
+	Network/CircuitBreaker.h
+	Network/CircuitBreaker.cpp
+	Network/ExternalIPAddressResolver.h
+	Network/ExternalIPAddressResolver.cpp
+	Network/HTTPEventLoop.h
+	Network/HTTPEventLoop.cpp
+	Network/HTTPSessionPool.h
+	Network/HTTPSessionPool.cpp
+	Network/LoopbackHTTPServer.h
+	Network/LoopbackHTTPServer.cpp
+	Network/RateLimiter.h
+	Network/RateLimiter.cpp
+	Network/RetryPolicy.h
+	Network/RetryPolicy.cpp
+	Network/TokenBucket.h
+	Network/TokenBucket.cpp
+	Scheduling/Task.h
+	Scheduling/TaskScheduler.h
+	Scheduling/TaskScheduler.cpp
 	Main.cpp
 	Project.h
 )
 
+set(BENCHMARK_SOURCE_FILES
+	Benchmarks/BenchmarkRunner.h
+	Benchmarks/BenchmarkRunner.cpp
+	Benchmarks/Main.cpp
+)
+
 list(APPEND SOURCE_FILES ${MAIN_SOURCE_FILES} ${MAIN_SOURCE_FILES_${PLATFORM_UPPER}})
 
+list(APPEND BENCHMARK_TARGET_SOURCE_FILES ${MAIN_SOURCE_FILES} ${MAIN_SOURCE_FILES_${PLATFORM_UPPER}})
+list(REMOVE_ITEM BENCHMARK_TARGET_SOURCE_FILES Main.cpp)
+list(APPEND BENCHMARK_TARGET_SOURCE_FILES ${BENCHMARK_SOURCE_FILES})
+list(TRANSFORM BENCHMARK_TARGET_SOURCE_FILES PREPEND "${_SOURCE_DIRECTORY}/")
+
 list(APPEND SOURCE_FILES ${GUI_SOURCE_FILES})
 
 list(TRANSFORM SOURCE_FILES PREPEND "${_SOURCE_DIRECTORY}/")
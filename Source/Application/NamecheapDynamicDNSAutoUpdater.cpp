@@ -1,5 +1,13 @@
 #include "NamecheapDynamicDNSAutoUpdater.h"
 
+#include "Metrics/ApplicationMetrics.h"
+#include "Namecheap/NamecheapIPAddressCache.h"
+#include "Namecheap/NamecheapUpdateJournal.h"
+#include "Network/CircuitBreaker.h"
+#include "Network/ExternalIPAddressResolver.h"
+#include "Network/HTTPEventLoop.h"
+#include "Network/HTTPSessionPool.h"
+#include "Network/RateLimiter.h"
 #include "Project.h"
 #include "SettingsManager.h"
 
@@ -11,12 +19,24 @@
 
 #include <spdlog/spdlog.h>
 
+#include <csignal>
+#include <filesystem>
+#include <future>
+#include <limits>
+
 static const std::string HTTP_USER_AGENT(Utilities::replaceAll(APPLICATION_NAME, " ", "") + "/" + APPLICATION_VERSION);
+static const std::chrono::minutes SETTINGS_SAVE_INTERVAL(5);
+static const std::string CERTIFICATE_AUTHORITY_STORE_FILE_NAME("cacert.pem");
+
+std::atomic<bool> NamecheapDynamicDNSAutoUpdater::s_terminationRequested(false);
 
 NamecheapDynamicDNSAutoUpdater::NamecheapDynamicDNSAutoUpdater()
 	: Application()
 	, m_initialized(false)
-	, m_domainProfileManager(std::make_shared<NamecheapDomainProfileManager>()) {
+	, m_daemonMode(false)
+	, m_forceUpdate(false)
+	, m_domainProfileManager(std::make_shared<NamecheapDomainProfileManager>())
+	, m_dynamicDNSService(std::make_shared<NamecheapDynamicDNSService>()) {
 	FactoryRegistry & factoryRegistry = FactoryRegistry::getInstance();
 
 	factoryRegistry.setFactory<SettingsManager>([]() {
@@ -62,6 +82,9 @@ bool NamecheapDynamicDNSAutoUpdater::initialize(std::shared_ptr<ArgumentParser>
 			displayLibraryInformation();
 			return false;
 		}
+
+		m_daemonMode = m_arguments->hasArgument("d", "daemon");
+		m_forceUpdate = m_arguments->hasArgument("force");
 	}
 
 	SettingsManager * settings = SettingsManager::getInstance();
@@ -87,11 +110,13 @@ bool NamecheapDynamicDNSAutoUpdater::initialize(std::shared_ptr<ArgumentParser>
 		return false;
 	}
 
+	// both refreshes are blocking calls into the HTTP service, so the certificate download runs alongside the time zone data refresh rather than ahead of it
+	std::future<bool> cacertUpdateFuture;
+
 	if(!settings->downloadThrottlingEnabled || !settings->cacertLastDownloadedTimestamp.has_value() || std::chrono::system_clock::now() - settings->cacertLastDownloadedTimestamp.value() > settings->cacertUpdateFrequency) {
-		if(httpService->updateCertificateAuthorityCertificateAndWait()) {
-			settings->cacertLastDownloadedTimestamp = std::chrono::system_clock::now();
-			settings->save();
-		}
+		cacertUpdateFuture = std::async(std::launch::async, [httpService]() {
+			return httpService->updateCertificateAuthorityCertificateAndWait();
+		});
 	}
 
 	bool timeZoneDataUpdated = false;
@@ -104,7 +129,92 @@ bool NamecheapDynamicDNSAutoUpdater::initialize(std::shared_ptr<ArgumentParser>
 
 	if(timeZoneDataUpdated) {
 		settings->timeZoneDataLastDownloadedTimestamp = std::chrono::system_clock::now();
-		settings->save();
+		settings->markModified();
+	}
+
+	if(cacertUpdateFuture.valid() && cacertUpdateFuture.get()) {
+		settings->cacertLastDownloadedTimestamp = std::chrono::system_clock::now();
+		settings->markModified();
+	}
+
+	if(settings->connectionReuseEnabled) {
+		HTTPSessionPool::Configuration sessionPoolConfiguration;
+		sessionPoolConfiguration.userAgent = HTTP_USER_AGENT;
+		sessionPoolConfiguration.connectionTimeout = settings->connectionTimeout;
+		sessionPoolConfiguration.networkTimeout = settings->networkTimeout;
+		sessionPoolConfiguration.transferTimeout = settings->transferTimeout;
+		sessionPoolConfiguration.http2Enabled = settings->http2Enabled;
+		sessionPoolConfiguration.verboseLoggingEnabled = settings->verboseRequestLogging;
+
+		std::string certificateAuthorityFilePath(Utilities::joinPaths(configuration.certificateAuthorityStoreDirectoryPath, CERTIFICATE_AUTHORITY_STORE_FILE_NAME));
+
+		if(std::filesystem::is_regular_file(std::filesystem::path(certificateAuthorityFilePath))) {
+			sessionPoolConfiguration.certificateAuthorityFilePath = certificateAuthorityFilePath;
+		}
+
+		std::shared_ptr<HTTPSessionPool> sessionPool(std::make_shared<HTTPSessionPool>(sessionPoolConfiguration));
+
+		if(sessionPool->isValid()) {
+			m_dynamicDNSService->setHTTPSessionPool(sessionPool);
+
+			if(settings->asynchronousRequestsEnabled) {
+				std::shared_ptr<HTTPEventLoop> eventLoop(std::make_shared<HTTPEventLoop>(sessionPoolConfiguration, settings->maximumConcurrentUpdateRequests));
+
+				if(eventLoop->isValid()) {
+					m_dynamicDNSService->setHTTPEventLoop(eventLoop);
+				}
+				else {
+					spdlog::warn("Failed to create HTTP event loop, updates will be sent from worker threads.");
+				}
+			}
+
+			if(!settings->ipAddressLookupURLs.empty()) {
+				m_dynamicDNSService->setIPAddressResolver(std::make_shared<ExternalIPAddressResolver>(sessionPool, settings->ipAddressLookupURLs, settings->ipAddressLookupAgreement, settings->ipAddressLookupCacheDuration, settings->ipAddressLookupTimeout));
+			}
+
+			if(!settings->ipv6AddressLookupURLs.empty()) {
+				m_dynamicDNSService->setIPAddressResolver(std::make_shared<ExternalIPAddressResolver>(sessionPool, settings->ipv6AddressLookupURLs, settings->ipAddressLookupAgreement, settings->ipAddressLookupCacheDuration, settings->ipAddressLookupTimeout, IPAddressService::IPAddressType::V6), IPAddressService::IPAddressType::V6);
+			}
+		}
+		else {
+			spdlog::warn("Failed to create HTTP session pool, requests will not share connections.");
+		}
+	}
+
+	m_dynamicDNSService->setBaseURL(settings->dynamicDNSServiceBaseURL);
+	m_dynamicDNSService->setMaximumConcurrentRequests(settings->maximumConcurrentUpdateRequests);
+	m_dynamicDNSService->setRetryPolicy(RetryPolicy(settings->maximumUpdateAttempts, settings->updateRetryInitialDelay, settings->updateRetryMaximumDelay, settings->updateRetryBackoffMultiplier, settings->updateRetryJitter));
+	m_dynamicDNSService->getCircuitBreaker().setFailureThreshold(settings->circuitBreakerFailureThreshold);
+	m_dynamicDNSService->getCircuitBreaker().setResetTimeout(settings->circuitBreakerResetTimeout);
+	m_dynamicDNSService->setRateLimiter(std::make_shared<RateLimiter>(settings->updateRequestsPerSecond, settings->updateRequestBurstSize, settings->domainUpdateRequestsPerSecond, settings->domainUpdateRequestBurstSize));
+	m_dynamicDNSService->setForcedRefreshInterval(settings->forcedRefreshInterval);
+
+	if(!settings->ipAddressCacheFileName.empty()) {
+		std::shared_ptr<NamecheapIPAddressCache> ipAddressCache(std::make_shared<NamecheapIPAddressCache>());
+		ipAddressCache->setFilePath(Utilities::joinPaths(settings->getSettingsDirectoryPath(), settings->ipAddressCacheFileName));
+		ipAddressCache->load();
+
+		m_dynamicDNSService->setIPAddressCache(ipAddressCache);
+
+		if(!settings->updateJournalFileName.empty()) {
+			std::shared_ptr<NamecheapUpdateJournal> updateJournal(std::make_shared<NamecheapUpdateJournal>(Utilities::joinPaths(settings->getSettingsDirectoryPath(), settings->updateJournalFileName)));
+
+			if(updateJournal->open()) {
+				// hosts confirmed before an interrupted update cycle are skipped on the next one rather than being sent again
+				size_t numberOfRecoveredUpdates = updateJournal->replayInto(*ipAddressCache);
+
+				if(numberOfRecoveredUpdates != 0) {
+					spdlog::info("Recovered {} confirmed host update(s) from update journal '{}'.", numberOfRecoveredUpdates, updateJournal->getFilePath());
+				}
+
+				updateJournal->compact(*ipAddressCache);
+
+				m_dynamicDNSService->setUpdateJournal(updateJournal);
+			}
+			else {
+				spdlog::warn("Failed to open update journal '{}', interrupted update cycles will be sent again in full.", updateJournal->getFilePath());
+			}
+		}
 	}
 
 	if(!m_domainProfileManager->initialize(arguments.get())) {
@@ -124,7 +234,7 @@ void NamecheapDynamicDNSAutoUpdater::uninitialize() {
 
 	SettingsManager * settings = SettingsManager::getInstance();
 
-	settings->save(m_arguments.get());
+	settings->save();
 
 	if(m_arguments != nullptr) {
 		m_arguments.reset();
@@ -139,15 +249,189 @@ bool NamecheapDynamicDNSAutoUpdater::run() {
 		return false;
 	}
 
+	if(!m_daemonMode) {
+		return updateDomainProfiles();
+	}
+
+	SettingsManager * settings = SettingsManager::getInstance();
+
+	if(settings->ipAddressUpdateFrequency.count() <= 0) {
+		spdlog::error("Invalid IP address update frequency of {} minutes, expected a value greater than zero.", settings->ipAddressUpdateFrequency.count());
+		return false;
+	}
+
+	installSignalHandlers();
+
+	m_scheduler = std::make_unique<TaskScheduler>();
+
+	m_scheduler->scheduleRepeatingTask([this]() {
+		updateDomainProfiles();
+	}, settings->ipAddressUpdateFrequency);
+
+	// batch settings changes made while running into at most one write per interval, anything left over is written on shutdown
+	m_scheduler->scheduleRepeatingTask([settings]() {
+		settings->saveIfModified();
+	}, SETTINGS_SAVE_INTERVAL, SETTINGS_SAVE_INTERVAL);
+
+	if(settings->watchDomainProfileFiles) {
+		m_domainProfileManager->startWatchingFiles([this](std::shared_ptr<NamecheapDomainProfileCollection> changedDomainProfiles) {
+			// run on the scheduler thread so that updates never overlap, the changed profiles are forced since a changed password or host list must be pushed even if the cached IP address matches,
+			// while the update itself goes through the published collection so that the state of every other host carries over
+			m_scheduler->scheduleTask([this, changedDomainProfiles]() {
+				m_dynamicDNSService->forceUpdate(*changedDomainProfiles);
+				updateDomainProfiles();
+			});
+		});
+	}
+
+	if(settings->monitorAddressChanges) {
+		m_addressChangeMonitor = std::make_unique<AddressChangeMonitor>([this]() {
+			// the periodic update remains as a safety net, this only makes address changes take effect sooner
+			m_scheduler->scheduleTask([this]() {
+				spdlog::info("Network address change detected, checking external IP address.");
+
+				for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+					std::shared_ptr<ExternalIPAddressResolver> ipAddressResolver(m_dynamicDNSService->getIPAddressResolver(ipAddressType));
+
+					if(ipAddressResolver != nullptr) {
+						ipAddressResolver->clearCache();
+					}
+				}
+
+				updateDomainProfiles();
+			});
+		}, settings->monitoredInterfaceName);
+
+		if(!m_addressChangeMonitor->start()) {
+			m_addressChangeMonitor.reset();
+		}
+	}
+
+	startMetricsListener();
+
+	spdlog::info("Running in daemon mode, updating domain profiles every {} minutes{}.", settings->ipAddressUpdateFrequency.count(), m_addressChangeMonitor != nullptr ? " and on network address changes" : "");
+
+	m_scheduler->run(&s_terminationRequested);
+	m_metricsListener.reset();
+	m_addressChangeMonitor.reset();
+	m_domainProfileManager->stopWatchingFiles();
+	m_scheduler.reset();
+
+	spdlog::info("Daemon stopped.");
+
 	return true;
 }
 
+bool NamecheapDynamicDNSAutoUpdater::updateDomainProfiles() {
+	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(m_domainProfileManager->getDomainProfiles());
+
+	if(domainProfiles == nullptr) {
+		return false;
+	}
+
+	return updateDomainProfiles(*domainProfiles, m_forceUpdate.exchange(false));
+}
+
+bool NamecheapDynamicDNSAutoUpdater::updateDomainProfiles(const NamecheapDomainProfileCollection & domainProfiles, bool force) {
+	spdlog::info("Updating IP address for {} Namecheap domain profiles...", domainProfiles.numberOfDomainProfiles());
+
+	NamecheapDynamicDNSUpdateReport report(m_dynamicDNSService->updateIPAddress(domainProfiles, force));
+
+	writeMetricsTextFile();
+
+	if(report.numberOfHostResults() == 0 && report.numberOfSkippedUpdates() == 0) {
+		if(report.numberOfSuspendedUpdates() != 0) {
+			spdlog::error("All {} Namecheap domain hosts are suspended due to permanent errors.", report.numberOfSuspendedUpdates());
+		}
+		else {
+			spdlog::error("Failed to update IP address for any Namecheap domain hosts.");
+		}
+
+		return false;
+	}
+
+	if(!report.isSuccessful()) {
+		spdlog::error("Failed to update IP address for {} of {} Namecheap domain hosts, {} with permanent errors.", report.numberOfFailedUpdates(), report.numberOfHostResults(), report.numberOfPermanentFailures());
+		return false;
+	}
+
+	if(report.numberOfHostResults() == 0) {
+		spdlog::info("IP address is unchanged for all {} Namecheap domain hosts, no updates were sent.", report.numberOfSkippedUpdates());
+	}
+	else {
+		spdlog::info("Successfully updated IP address for {} Namecheap domain hosts in {} ms, {} were already up to date.", report.numberOfHostResults(), report.getDuration().count(), report.numberOfSkippedUpdates());
+	}
+
+	return true;
+}
+
+bool NamecheapDynamicDNSAutoUpdater::startMetricsListener() {
+	SettingsManager * settings = SettingsManager::getInstance();
+
+	if(settings->metricsListenerPort == 0) {
+		return false;
+	}
+
+	if(settings->metricsListenerPort > std::numeric_limits<uint16_t>::max()) {
+		spdlog::error("Invalid metrics listener port {}, expected a value between 1 and {}.", settings->metricsListenerPort, std::numeric_limits<uint16_t>::max());
+		return false;
+	}
+
+	// bound to the loopback interface only, anything further afield should scrape through a reverse proxy or the textfile collector
+	m_metricsListener = std::make_unique<LoopbackHTTPServer>([]() {
+		return ApplicationMetrics::toPrometheusText();
+	}, ApplicationMetrics::PROMETHEUS_CONTENT_TYPE);
+
+	if(!m_metricsListener->start(static_cast<uint16_t>(settings->metricsListenerPort))) {
+		spdlog::error("Failed to start metrics listener on port {}.", settings->metricsListenerPort);
+		m_metricsListener.reset();
+		return false;
+	}
+
+	spdlog::info("Serving metrics at '{}/metrics'.", m_metricsListener->getBaseURL());
+
+	return true;
+}
+
+void NamecheapDynamicDNSAutoUpdater::writeMetricsTextFile() const {
+	SettingsManager * settings = SettingsManager::getInstance();
+
+	if(settings->metricsTextFilePath.empty()) {
+		return;
+	}
+
+	ApplicationMetrics::writeTextFile(settings->metricsTextFilePath);
+}
+
+void NamecheapDynamicDNSAutoUpdater::stop() {
+	if(m_scheduler != nullptr) {
+		m_scheduler->stop();
+	}
+}
+
+void NamecheapDynamicDNSAutoUpdater::installSignalHandlers() {
+	s_terminationRequested = false;
+
+	std::signal(SIGTERM, onTerminationSignal);
+	std::signal(SIGINT, onTerminationSignal);
+}
+
+void NamecheapDynamicDNSAutoUpdater::onTerminationSignal(int) {
+	s_terminationRequested = true;
+}
+
 std::string NamecheapDynamicDNSAutoUpdater::getArgumentHelpInformation() {
 	std::ostringstream argumentHelpStream;
 
 	argumentHelpStream << APPLICATION_NAME << " version " << APPLICATION_VERSION << " arguments:\n";
 	argumentHelpStream << " --file \"Settings.json\" - specifies an alternate settings file to use.\n";
 	argumentHelpStream << " -f \"File.json\" - alias for 'file'.\n";
+	argumentHelpStream << " --profile \"Profile.json\" - specifies a domain profile file to use instead of the ones in settings, can be repeated.\n";
+	argumentHelpStream << " -p \"Profile.json\" - alias for 'profile'.\n";
+	argumentHelpStream << " --load-threads 4 - number of threads used to load domain profile files, 0 uses one per processor core.\n";
+	argumentHelpStream << " --daemon - keeps running and updates domain profiles periodically until terminated.\n";
+	argumentHelpStream << " -d - alias for 'daemon'.\n";
+	argumentHelpStream << " --force - sends updates for all hosts, even if their published IP address is unchanged.\n";
 	argumentHelpStream << " --info - displays dependency library version information.\n";
 	argumentHelpStream << " --help - displays this help message.\n";
 	argumentHelpStream << " -? - alias for 'help'.\n";
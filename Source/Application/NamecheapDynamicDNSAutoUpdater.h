@@ -2,6 +2,10 @@
 #define _NAMECHEAP_DYNAMIC_DNS_AUTO_UPDATER_H_
 
 #include "Namecheap/NamecheapDomainProfileManager.h"
+#include "Namecheap/NamecheapDynamicDNSService.h"
+#include "Network/AddressChangeMonitor.h"
+#include "Network/LoopbackHTTPServer.h"
+#include "Scheduling/TaskScheduler.h"
 
 #include <Application/Application.h>
 #include <Arguments/ArgumentParser.h>
@@ -19,15 +23,32 @@ public:
 	bool initialize(std::shared_ptr<ArgumentParser> arguments);
 	void uninitialize();
 	bool run();
+	bool updateDomainProfiles();
+	void stop();
 
 	static std::string getArgumentHelpInformation();
 	static void displayArgumentHelp();
 	static void displayVersion();
 	static void displayLibraryInformation();
 private:
+	bool updateDomainProfiles(const NamecheapDomainProfileCollection & domainProfiles, bool force);
+	bool startMetricsListener();
+	void writeMetricsTextFile() const;
+	static void installSignalHandlers();
+	static void onTerminationSignal(int signal);
+
 	std::atomic<bool> m_initialized;
+	bool m_daemonMode;
+	// only applies to the next update, a daemon would otherwise resend every host and retry suspended hosts on every cycle
+	std::atomic<bool> m_forceUpdate;
 	std::shared_ptr<ArgumentParser> m_arguments;
 	std::shared_ptr<NamecheapDomainProfileManager> m_domainProfileManager;
+	std::shared_ptr<NamecheapDynamicDNSService> m_dynamicDNSService;
+	std::unique_ptr<TaskScheduler> m_scheduler;
+	std::unique_ptr<AddressChangeMonitor> m_addressChangeMonitor;
+	std::unique_ptr<LoopbackHTTPServer> m_metricsListener;
+
+	static std::atomic<bool> s_terminationRequested;
 
 	NamecheapDynamicDNSAutoUpdater(const NamecheapDynamicDNSAutoUpdater &) = delete;
 	const NamecheapDynamicDNSAutoUpdater & operator = (const NamecheapDynamicDNSAutoUpdater &) = delete;
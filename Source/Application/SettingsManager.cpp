@@ -1,5 +1,9 @@
 #include "SettingsManager.h"
 
+#include "IO/AtomicFileWriter.h"
+#include "IO/MappedJSONDocument.h"
+#include "Metrics/ApplicationMetrics.h"
+
 #include <Arguments/ArgumentParser.h>
 #include <Logging/LogSystem.h>
 #include <Utilities/RapidJSONUtilities.h>
@@ -7,13 +11,9 @@
 #include <Utilities/TimeUtilities.h>
 
 #include <magic_enum.hpp>
-#include <rapidjson/istreamwrapper.h>
-#include <rapidjson/ostreamwrapper.h>
-#include <rapidjson/prettywriter.h>
 #include <spdlog/spdlog.h>
 
 #include <filesystem>
-#include <fstream>
 #include <optional>
 #include <string_view>
 
@@ -40,6 +40,9 @@ static constexpr const char * CURL_CONNECTION_TIMEOUT_PROPERTY_NAME = "connectio
 static constexpr const char * CURL_NETWORK_TIMEOUT_PROPERTY_NAME = "networkTimeout";
 static constexpr const char * CURL_TRANSFER_TIMEOUT_PROPERTY_NAME = "transferTimeout";
 static constexpr const char * CURL_VERBOSE_REQUEST_LOGGING_PROPERTY_NAME = "verboseRequestLogging";
+static constexpr const char * CURL_CONNECTION_REUSE_ENABLED_PROPERTY_NAME = "connectionReuseEnabled";
+static constexpr const char * CURL_ASYNCHRONOUS_REQUESTS_ENABLED_PROPERTY_NAME = "asynchronousRequestsEnabled";
+static constexpr const char * CURL_HTTP2_ENABLED_PROPERTY_NAME = "http2Enabled";
 
 static constexpr const char * FILE_ETAGS_PROPERTY_NAME = "fileETags";
 
@@ -53,6 +56,39 @@ static constexpr const char * TIME_ZONE_DATA_UPDATE_FREQUENCY_PROPERTY_NAME = "t
 static constexpr const char * DOMAIN_PROFILES_PROPERTY_NAME = "domainProfiles";
 static constexpr const char * DOMAIN_PROFILES_IP_ADDRESS_UPDATE_FREQUENCY_PROPERTY_NAME = "ipAddressUpdateFrequency";
 static constexpr const char * DOMAIN_PROFILES_FILE_PATHS_PROPERTY_NAME = "filePaths";
+static constexpr const char * DOMAIN_PROFILES_MAXIMUM_CONCURRENT_UPDATE_REQUESTS_PROPERTY_NAME = "maximumConcurrentUpdateRequests";
+static constexpr const char * DOMAIN_PROFILES_IP_ADDRESS_CACHE_FILE_NAME_PROPERTY_NAME = "ipAddressCacheFileName";
+static constexpr const char * DOMAIN_PROFILES_UPDATE_JOURNAL_FILE_NAME_PROPERTY_NAME = "updateJournalFileName";
+static constexpr const char * DOMAIN_PROFILES_NUMBER_OF_LOADING_THREADS_PROPERTY_NAME = "numberOfLoadingThreads";
+static constexpr const char * DOMAIN_PROFILES_BINARY_SNAPSHOTS_ENABLED_PROPERTY_NAME = "binarySnapshotsEnabled";
+static constexpr const char * DOMAIN_PROFILES_ARENA_STORAGE_ENABLED_PROPERTY_NAME = "arenaStorageEnabled";
+static constexpr const char * DOMAIN_PROFILES_WATCH_FILES_PROPERTY_NAME = "watchFiles";
+static constexpr const char * DOMAIN_PROFILES_MONITOR_ADDRESS_CHANGES_PROPERTY_NAME = "monitorAddressChanges";
+static constexpr const char * DOMAIN_PROFILES_MONITORED_INTERFACE_NAME_PROPERTY_NAME = "monitoredInterfaceName";
+
+static constexpr const char * DYNAMIC_DNS_CATEGORY_NAME = "dynamicDNS";
+static constexpr const char * DYNAMIC_DNS_SERVICE_BASE_URL_PROPERTY_NAME = "serviceBaseURL";
+static constexpr const char * DYNAMIC_DNS_IP_ADDRESS_LOOKUP_URLS_PROPERTY_NAME = "ipAddressLookupURLs";
+static constexpr const char * DYNAMIC_DNS_IPV6_ADDRESS_LOOKUP_URLS_PROPERTY_NAME = "ipv6AddressLookupURLs";
+static constexpr const char * DYNAMIC_DNS_IP_ADDRESS_LOOKUP_AGREEMENT_PROPERTY_NAME = "ipAddressLookupAgreement";
+static constexpr const char * DYNAMIC_DNS_IP_ADDRESS_LOOKUP_CACHE_DURATION_PROPERTY_NAME = "ipAddressLookupCacheDuration";
+static constexpr const char * DYNAMIC_DNS_IP_ADDRESS_LOOKUP_TIMEOUT_PROPERTY_NAME = "ipAddressLookupTimeout";
+static constexpr const char * DYNAMIC_DNS_MAXIMUM_UPDATE_ATTEMPTS_PROPERTY_NAME = "maximumUpdateAttempts";
+static constexpr const char * DYNAMIC_DNS_RETRY_INITIAL_DELAY_PROPERTY_NAME = "retryInitialDelay";
+static constexpr const char * DYNAMIC_DNS_RETRY_MAXIMUM_DELAY_PROPERTY_NAME = "retryMaximumDelay";
+static constexpr const char * DYNAMIC_DNS_RETRY_BACKOFF_MULTIPLIER_PROPERTY_NAME = "retryBackoffMultiplier";
+static constexpr const char * DYNAMIC_DNS_RETRY_JITTER_PROPERTY_NAME = "retryJitter";
+static constexpr const char * DYNAMIC_DNS_CIRCUIT_BREAKER_FAILURE_THRESHOLD_PROPERTY_NAME = "circuitBreakerFailureThreshold";
+static constexpr const char * DYNAMIC_DNS_CIRCUIT_BREAKER_RESET_TIMEOUT_PROPERTY_NAME = "circuitBreakerResetTimeout";
+static constexpr const char * DYNAMIC_DNS_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME = "updateRequestsPerSecond";
+static constexpr const char * DYNAMIC_DNS_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME = "updateRequestBurstSize";
+static constexpr const char * DYNAMIC_DNS_DOMAIN_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME = "domainUpdateRequestsPerSecond";
+static constexpr const char * DYNAMIC_DNS_DOMAIN_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME = "domainUpdateRequestBurstSize";
+static constexpr const char * DYNAMIC_DNS_FORCED_REFRESH_INTERVAL_PROPERTY_NAME = "forcedRefreshInterval";
+
+static constexpr const char * METRICS_CATEGORY_NAME = "metrics";
+static constexpr const char * METRICS_LISTENER_PORT_PROPERTY_NAME = "listenerPort";
+static constexpr const char * METRICS_TEXT_FILE_PATH_PROPERTY_NAME = "textFilePath";
 
 const std::string SettingsManager::FILE_TYPE("Namecheap Dynamic DNS Auto-Updater Settings");
 const uint32_t SettingsManager::FILE_FORMAT_VERSION = 1;
@@ -65,10 +101,40 @@ const std::chrono::seconds SettingsManager::DEFAULT_CONNECTION_TIMEOUT = 15s;
 const std::chrono::seconds SettingsManager::DEFAULT_NETWORK_TIMEOUT = 30s;
 const std::chrono::seconds SettingsManager::DEFAULT_TRANSFER_TIMEOUT = 0s;
 const bool SettingsManager::DEFAULT_VERBOSE_REQUEST_LOGGING = false;
+const bool SettingsManager::DEFAULT_CONNECTION_REUSE_ENABLED = true;
+const bool SettingsManager::DEFAULT_ASYNCHRONOUS_REQUESTS_ENABLED = true;
+const bool SettingsManager::DEFAULT_HTTP2_ENABLED = true;
 const bool SettingsManager::DEFAULT_DOWNLOAD_THROTTLING_ENABLED = true;
 const std::chrono::minutes SettingsManager::DEFAULT_CACERT_UPDATE_FREQUENCY = std::chrono::hours(2 * 24 * 7); // 2 weeks
 const std::chrono::minutes SettingsManager::DEFAULT_TIME_ZONE_DATA_UPDATE_FREQUENCY = std::chrono::hours(1 * 24 * 7); // 1 week
 const std::chrono::minutes SettingsManager::DEFAULT_IP_ADDRESS_UPDATE_FREQUENCY = std::chrono::minutes(30);
+const size_t SettingsManager::DEFAULT_MAXIMUM_CONCURRENT_UPDATE_REQUESTS = 8;
+const std::string SettingsManager::DEFAULT_IP_ADDRESS_CACHE_FILE_NAME("Namecheap Dynamic DNS Auto-Updater IP Address Cache.json");
+const std::string SettingsManager::DEFAULT_UPDATE_JOURNAL_FILE_NAME("Namecheap Dynamic DNS Auto-Updater Update Journal.bin");
+const size_t SettingsManager::DEFAULT_NUMBER_OF_DOMAIN_PROFILE_LOADING_THREADS = 0; // use hardware concurrency
+const bool SettingsManager::DEFAULT_DOMAIN_PROFILE_BINARY_SNAPSHOTS_ENABLED = true;
+const bool SettingsManager::DEFAULT_DOMAIN_PROFILE_ARENA_STORAGE_ENABLED = true;
+const bool SettingsManager::DEFAULT_WATCH_DOMAIN_PROFILE_FILES = true;
+const bool SettingsManager::DEFAULT_MONITOR_ADDRESS_CHANGES = true;
+const std::string SettingsManager::DEFAULT_DYNAMIC_DNS_SERVICE_BASE_URL("https://dynamicdns.park-your-domain.com");
+const std::vector<std::string> SettingsManager::DEFAULT_IP_ADDRESS_LOOKUP_URLS({ "https://api.ipify.org", "https://ipv4.icanhazip.com", "https://checkip.amazonaws.com" });
+const std::vector<std::string> SettingsManager::DEFAULT_IPV6_ADDRESS_LOOKUP_URLS({ "https://api6.ipify.org", "https://ipv6.icanhazip.com" });
+const size_t SettingsManager::DEFAULT_IP_ADDRESS_LOOKUP_AGREEMENT = 1;
+const std::chrono::seconds SettingsManager::DEFAULT_IP_ADDRESS_LOOKUP_CACHE_DURATION = 30s;
+const std::chrono::milliseconds SettingsManager::DEFAULT_IP_ADDRESS_LOOKUP_TIMEOUT = 10s;
+const size_t SettingsManager::DEFAULT_MAXIMUM_UPDATE_ATTEMPTS = 3;
+const std::chrono::milliseconds SettingsManager::DEFAULT_UPDATE_RETRY_INITIAL_DELAY = 1s;
+const std::chrono::milliseconds SettingsManager::DEFAULT_UPDATE_RETRY_MAXIMUM_DELAY = 30s;
+const double SettingsManager::DEFAULT_UPDATE_RETRY_BACKOFF_MULTIPLIER = 2.0;
+const double SettingsManager::DEFAULT_UPDATE_RETRY_JITTER = 0.5;
+const size_t SettingsManager::DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD = 5;
+const std::chrono::seconds SettingsManager::DEFAULT_CIRCUIT_BREAKER_RESET_TIMEOUT = 60s;
+const double SettingsManager::DEFAULT_UPDATE_REQUESTS_PER_SECOND = 5.0;
+const size_t SettingsManager::DEFAULT_UPDATE_REQUEST_BURST_SIZE = 10;
+const double SettingsManager::DEFAULT_DOMAIN_UPDATE_REQUESTS_PER_SECOND = 2.0;
+const size_t SettingsManager::DEFAULT_DOMAIN_UPDATE_REQUEST_BURST_SIZE = 5;
+const std::chrono::minutes SettingsManager::DEFAULT_FORCED_REFRESH_INTERVAL = std::chrono::minutes(0);
+const size_t SettingsManager::DEFAULT_METRICS_LISTENER_PORT = 0;
 
 static bool assignStringSetting(std::string & setting, const rapidjson::Value & categoryValue, const std::string & propertyName) {
 	if(propertyName.empty() || !categoryValue.IsObject() || !categoryValue.HasMember(propertyName.c_str())) {
@@ -118,6 +184,38 @@ static bool assignOptionalTimePointSetting(std::optional<std::chrono::time_point
 	return setting.has_value();
 }
 
+static bool assignUnsignedIntegerSetting(size_t & setting, const rapidjson::Value & categoryValue, const std::string & propertyName) {
+	if(propertyName.empty() || !categoryValue.IsObject() || !categoryValue.HasMember(propertyName.c_str())) {
+		return false;
+	}
+
+	const rapidjson::Value & settingValue = categoryValue[propertyName.c_str()];
+
+	if(!settingValue.IsUint64()) {
+		return false;
+	}
+
+	setting = static_cast<size_t>(settingValue.GetUint64());
+
+	return true;
+}
+
+static bool assignDoubleSetting(double & setting, const rapidjson::Value & categoryValue, const std::string & propertyName) {
+	if(propertyName.empty() || !categoryValue.IsObject() || !categoryValue.HasMember(propertyName.c_str())) {
+		return false;
+	}
+
+	const rapidjson::Value & settingValue = categoryValue[propertyName.c_str()];
+
+	if(!settingValue.IsNumber()) {
+		return false;
+	}
+
+	setting = settingValue.GetDouble();
+
+	return true;
+}
+
 template <typename T>
 static bool assignChronoSetting(T & setting, const rapidjson::Value & categoryValue, const std::string & propertyName) {
 	if(propertyName.empty() || !categoryValue.IsObject() || !categoryValue.HasMember(propertyName.c_str())) {
@@ -146,16 +244,20 @@ static bool assignStringArraySetting(std::vector<std::string> & setting, const r
 		return false;
 	}
 
+	std::vector<std::string> values;
+	values.reserve(settingValue.Size());
+
 	for(rapidjson::Value::ConstValueIterator i = settingValue.Begin(); i != settingValue.End(); ++i) {
 		if(!i->IsString()) {
 			return false;
 		}
-	}
 
-	for(rapidjson::Value::ConstValueIterator i = settingValue.Begin(); i != settingValue.End(); ++i) {
-		setting.emplace_back(i->GetString());
+		values.emplace_back(i->GetString());
 	}
 
+	// replaces rather than extends the current value, which may still hold the defaults
+	setting = std::move(values);
+
 	return true;
 }
 
@@ -168,11 +270,42 @@ SettingsManager::SettingsManager()
 	, networkTimeout(DEFAULT_NETWORK_TIMEOUT)
 	, transferTimeout(DEFAULT_TRANSFER_TIMEOUT)
 	, verboseRequestLogging(DEFAULT_VERBOSE_REQUEST_LOGGING)
+	, connectionReuseEnabled(DEFAULT_CONNECTION_REUSE_ENABLED)
+	, asynchronousRequestsEnabled(DEFAULT_ASYNCHRONOUS_REQUESTS_ENABLED)
+	, http2Enabled(DEFAULT_HTTP2_ENABLED)
 	, downloadThrottlingEnabled(DEFAULT_DOWNLOAD_THROTTLING_ENABLED)
 	, cacertUpdateFrequency(DEFAULT_CACERT_UPDATE_FREQUENCY)
 	, timeZoneDataUpdateFrequency(DEFAULT_TIME_ZONE_DATA_UPDATE_FREQUENCY)
 	, ipAddressUpdateFrequency(DEFAULT_IP_ADDRESS_UPDATE_FREQUENCY)
+	, maximumConcurrentUpdateRequests(DEFAULT_MAXIMUM_CONCURRENT_UPDATE_REQUESTS)
+	, ipAddressCacheFileName(DEFAULT_IP_ADDRESS_CACHE_FILE_NAME)
+	, updateJournalFileName(DEFAULT_UPDATE_JOURNAL_FILE_NAME)
+	, numberOfDomainProfileLoadingThreads(DEFAULT_NUMBER_OF_DOMAIN_PROFILE_LOADING_THREADS)
+	, domainProfileBinarySnapshotsEnabled(DEFAULT_DOMAIN_PROFILE_BINARY_SNAPSHOTS_ENABLED)
+	, domainProfileArenaStorageEnabled(DEFAULT_DOMAIN_PROFILE_ARENA_STORAGE_ENABLED)
+	, watchDomainProfileFiles(DEFAULT_WATCH_DOMAIN_PROFILE_FILES)
+	, monitorAddressChanges(DEFAULT_MONITOR_ADDRESS_CHANGES)
+	, dynamicDNSServiceBaseURL(DEFAULT_DYNAMIC_DNS_SERVICE_BASE_URL)
+	, ipAddressLookupURLs(DEFAULT_IP_ADDRESS_LOOKUP_URLS)
+	, ipv6AddressLookupURLs(DEFAULT_IPV6_ADDRESS_LOOKUP_URLS)
+	, ipAddressLookupAgreement(DEFAULT_IP_ADDRESS_LOOKUP_AGREEMENT)
+	, ipAddressLookupCacheDuration(DEFAULT_IP_ADDRESS_LOOKUP_CACHE_DURATION)
+	, ipAddressLookupTimeout(DEFAULT_IP_ADDRESS_LOOKUP_TIMEOUT)
+	, maximumUpdateAttempts(DEFAULT_MAXIMUM_UPDATE_ATTEMPTS)
+	, updateRetryInitialDelay(DEFAULT_UPDATE_RETRY_INITIAL_DELAY)
+	, updateRetryMaximumDelay(DEFAULT_UPDATE_RETRY_MAXIMUM_DELAY)
+	, updateRetryBackoffMultiplier(DEFAULT_UPDATE_RETRY_BACKOFF_MULTIPLIER)
+	, updateRetryJitter(DEFAULT_UPDATE_RETRY_JITTER)
+	, circuitBreakerFailureThreshold(DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD)
+	, circuitBreakerResetTimeout(DEFAULT_CIRCUIT_BREAKER_RESET_TIMEOUT)
+	, updateRequestsPerSecond(DEFAULT_UPDATE_REQUESTS_PER_SECOND)
+	, updateRequestBurstSize(DEFAULT_UPDATE_REQUEST_BURST_SIZE)
+	, domainUpdateRequestsPerSecond(DEFAULT_DOMAIN_UPDATE_REQUESTS_PER_SECOND)
+	, domainUpdateRequestBurstSize(DEFAULT_DOMAIN_UPDATE_REQUEST_BURST_SIZE)
+	, forcedRefreshInterval(DEFAULT_FORCED_REFRESH_INTERVAL)
+	, metricsListenerPort(DEFAULT_METRICS_LISTENER_PORT)
 	, m_loaded(false)
+	, m_modified(false)
 	, m_filePath(DEFAULT_SETTINGS_FILE_PATH) { }
 
 SettingsManager::~SettingsManager() = default;
@@ -186,12 +319,44 @@ void SettingsManager::reset() {
 	networkTimeout = DEFAULT_NETWORK_TIMEOUT;
 	transferTimeout = DEFAULT_TRANSFER_TIMEOUT;
 	verboseRequestLogging = DEFAULT_VERBOSE_REQUEST_LOGGING;
+	connectionReuseEnabled = DEFAULT_CONNECTION_REUSE_ENABLED;
+	asynchronousRequestsEnabled = DEFAULT_ASYNCHRONOUS_REQUESTS_ENABLED;
+	http2Enabled = DEFAULT_HTTP2_ENABLED;
 	downloadThrottlingEnabled = DEFAULT_DOWNLOAD_THROTTLING_ENABLED;
 	cacertLastDownloadedTimestamp.reset();
 	cacertUpdateFrequency = DEFAULT_CACERT_UPDATE_FREQUENCY;
 	timeZoneDataLastDownloadedTimestamp.reset();
 	timeZoneDataUpdateFrequency = DEFAULT_TIME_ZONE_DATA_UPDATE_FREQUENCY;
 	ipAddressUpdateFrequency = DEFAULT_IP_ADDRESS_UPDATE_FREQUENCY;
+	maximumConcurrentUpdateRequests = DEFAULT_MAXIMUM_CONCURRENT_UPDATE_REQUESTS;
+	ipAddressCacheFileName = DEFAULT_IP_ADDRESS_CACHE_FILE_NAME;
+	updateJournalFileName = DEFAULT_UPDATE_JOURNAL_FILE_NAME;
+	numberOfDomainProfileLoadingThreads = DEFAULT_NUMBER_OF_DOMAIN_PROFILE_LOADING_THREADS;
+	domainProfileBinarySnapshotsEnabled = DEFAULT_DOMAIN_PROFILE_BINARY_SNAPSHOTS_ENABLED;
+	domainProfileArenaStorageEnabled = DEFAULT_DOMAIN_PROFILE_ARENA_STORAGE_ENABLED;
+	watchDomainProfileFiles = DEFAULT_WATCH_DOMAIN_PROFILE_FILES;
+	monitorAddressChanges = DEFAULT_MONITOR_ADDRESS_CHANGES;
+	monitoredInterfaceName.clear();
+	dynamicDNSServiceBaseURL = DEFAULT_DYNAMIC_DNS_SERVICE_BASE_URL;
+	ipAddressLookupURLs = DEFAULT_IP_ADDRESS_LOOKUP_URLS;
+	ipv6AddressLookupURLs = DEFAULT_IPV6_ADDRESS_LOOKUP_URLS;
+	ipAddressLookupAgreement = DEFAULT_IP_ADDRESS_LOOKUP_AGREEMENT;
+	ipAddressLookupCacheDuration = DEFAULT_IP_ADDRESS_LOOKUP_CACHE_DURATION;
+	ipAddressLookupTimeout = DEFAULT_IP_ADDRESS_LOOKUP_TIMEOUT;
+	maximumUpdateAttempts = DEFAULT_MAXIMUM_UPDATE_ATTEMPTS;
+	updateRetryInitialDelay = DEFAULT_UPDATE_RETRY_INITIAL_DELAY;
+	updateRetryMaximumDelay = DEFAULT_UPDATE_RETRY_MAXIMUM_DELAY;
+	updateRetryBackoffMultiplier = DEFAULT_UPDATE_RETRY_BACKOFF_MULTIPLIER;
+	updateRetryJitter = DEFAULT_UPDATE_RETRY_JITTER;
+	circuitBreakerFailureThreshold = DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD;
+	circuitBreakerResetTimeout = DEFAULT_CIRCUIT_BREAKER_RESET_TIMEOUT;
+	updateRequestsPerSecond = DEFAULT_UPDATE_REQUESTS_PER_SECOND;
+	updateRequestBurstSize = DEFAULT_UPDATE_REQUEST_BURST_SIZE;
+	domainUpdateRequestsPerSecond = DEFAULT_DOMAIN_UPDATE_REQUESTS_PER_SECOND;
+	domainUpdateRequestBurstSize = DEFAULT_DOMAIN_UPDATE_REQUEST_BURST_SIZE;
+	forcedRefreshInterval = DEFAULT_FORCED_REFRESH_INTERVAL;
+	metricsListenerPort = DEFAULT_METRICS_LISTENER_PORT;
+	metricsTextFilePath.clear();
 	domainProfileFilePaths.clear();
 	fileETags.clear();
 }
@@ -230,6 +395,9 @@ rapidjson::Document SettingsManager::toJSON() const {
 	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_NETWORK_TIMEOUT_PROPERTY_NAME), rapidjson::Value(networkTimeout.count()), allocator);
 	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_TRANSFER_TIMEOUT_PROPERTY_NAME), rapidjson::Value(transferTimeout.count()), allocator);
 	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_VERBOSE_REQUEST_LOGGING_PROPERTY_NAME), rapidjson::Value(verboseRequestLogging), allocator);
+	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_CONNECTION_REUSE_ENABLED_PROPERTY_NAME), rapidjson::Value(connectionReuseEnabled), allocator);
+	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_ASYNCHRONOUS_REQUESTS_ENABLED_PROPERTY_NAME), rapidjson::Value(asynchronousRequestsEnabled), allocator);
+	curlCategoryValue.AddMember(rapidjson::StringRef(CURL_HTTP2_ENABLED_PROPERTY_NAME), rapidjson::Value(http2Enabled), allocator);
 
 	settingsDocument.AddMember(rapidjson::StringRef(CURL_CATEGORY_NAME), curlCategoryValue, allocator);
 
@@ -256,6 +424,19 @@ rapidjson::Document SettingsManager::toJSON() const {
 	rapidjson::Value domainProfilesValue(rapidjson::kObjectType);
 
 	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_IP_ADDRESS_UPDATE_FREQUENCY_PROPERTY_NAME), rapidjson::Value(ipAddressUpdateFrequency.count()), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_MAXIMUM_CONCURRENT_UPDATE_REQUESTS_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(maximumConcurrentUpdateRequests)), allocator);
+	rapidjson::Value ipAddressCacheFileNameValue(ipAddressCacheFileName.c_str(), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_IP_ADDRESS_CACHE_FILE_NAME_PROPERTY_NAME), ipAddressCacheFileNameValue, allocator);
+
+	rapidjson::Value updateJournalFileNameValue(updateJournalFileName.c_str(), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_UPDATE_JOURNAL_FILE_NAME_PROPERTY_NAME), updateJournalFileNameValue, allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_NUMBER_OF_LOADING_THREADS_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(numberOfDomainProfileLoadingThreads)), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_BINARY_SNAPSHOTS_ENABLED_PROPERTY_NAME), rapidjson::Value(domainProfileBinarySnapshotsEnabled), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_ARENA_STORAGE_ENABLED_PROPERTY_NAME), rapidjson::Value(domainProfileArenaStorageEnabled), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_WATCH_FILES_PROPERTY_NAME), rapidjson::Value(watchDomainProfileFiles), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_MONITOR_ADDRESS_CHANGES_PROPERTY_NAME), rapidjson::Value(monitorAddressChanges), allocator);
+	rapidjson::Value monitoredInterfaceNameValue(monitoredInterfaceName.c_str(), allocator);
+	domainProfilesValue.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_MONITORED_INTERFACE_NAME_PROPERTY_NAME), monitoredInterfaceNameValue, allocator);
 
 	rapidjson::Value domainProfilesFilePathsValue(rapidjson::kArrayType);
 
@@ -268,6 +449,56 @@ rapidjson::Document SettingsManager::toJSON() const {
 
 	settingsDocument.AddMember(rapidjson::StringRef(DOMAIN_PROFILES_PROPERTY_NAME), domainProfilesValue, allocator);
 
+	rapidjson::Value dynamicDNSCategoryValue(rapidjson::kObjectType);
+
+	rapidjson::Value dynamicDNSServiceBaseURLValue(dynamicDNSServiceBaseURL.c_str(), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_SERVICE_BASE_URL_PROPERTY_NAME), dynamicDNSServiceBaseURLValue, allocator);
+
+	rapidjson::Value ipAddressLookupURLsValue(rapidjson::kArrayType);
+
+	for(const std::string & ipAddressLookupURL : ipAddressLookupURLs) {
+		rapidjson::Value ipAddressLookupURLValue(ipAddressLookupURL.c_str(), allocator);
+		ipAddressLookupURLsValue.PushBack(ipAddressLookupURLValue, allocator);
+	}
+
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_IP_ADDRESS_LOOKUP_URLS_PROPERTY_NAME), ipAddressLookupURLsValue, allocator);
+
+	rapidjson::Value ipv6AddressLookupURLsValue(rapidjson::kArrayType);
+
+	for(const std::string & ipv6AddressLookupURL : ipv6AddressLookupURLs) {
+		rapidjson::Value ipv6AddressLookupURLValue(ipv6AddressLookupURL.c_str(), allocator);
+		ipv6AddressLookupURLsValue.PushBack(ipv6AddressLookupURLValue, allocator);
+	}
+
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_IPV6_ADDRESS_LOOKUP_URLS_PROPERTY_NAME), ipv6AddressLookupURLsValue, allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_IP_ADDRESS_LOOKUP_AGREEMENT_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(ipAddressLookupAgreement)), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_IP_ADDRESS_LOOKUP_CACHE_DURATION_PROPERTY_NAME), rapidjson::Value(ipAddressLookupCacheDuration.count()), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_IP_ADDRESS_LOOKUP_TIMEOUT_PROPERTY_NAME), rapidjson::Value(ipAddressLookupTimeout.count()), allocator);
+
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_MAXIMUM_UPDATE_ATTEMPTS_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(maximumUpdateAttempts)), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_RETRY_INITIAL_DELAY_PROPERTY_NAME), rapidjson::Value(updateRetryInitialDelay.count()), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_RETRY_MAXIMUM_DELAY_PROPERTY_NAME), rapidjson::Value(updateRetryMaximumDelay.count()), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_RETRY_BACKOFF_MULTIPLIER_PROPERTY_NAME), rapidjson::Value(updateRetryBackoffMultiplier), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_RETRY_JITTER_PROPERTY_NAME), rapidjson::Value(updateRetryJitter), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_CIRCUIT_BREAKER_FAILURE_THRESHOLD_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(circuitBreakerFailureThreshold)), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_CIRCUIT_BREAKER_RESET_TIMEOUT_PROPERTY_NAME), rapidjson::Value(circuitBreakerResetTimeout.count()), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME), rapidjson::Value(updateRequestsPerSecond), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(updateRequestBurstSize)), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_DOMAIN_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME), rapidjson::Value(domainUpdateRequestsPerSecond), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_DOMAIN_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(domainUpdateRequestBurstSize)), allocator);
+	dynamicDNSCategoryValue.AddMember(rapidjson::StringRef(DYNAMIC_DNS_FORCED_REFRESH_INTERVAL_PROPERTY_NAME), rapidjson::Value(forcedRefreshInterval.count()), allocator);
+
+	settingsDocument.AddMember(rapidjson::StringRef(DYNAMIC_DNS_CATEGORY_NAME), dynamicDNSCategoryValue, allocator);
+
+	rapidjson::Value metricsCategoryValue(rapidjson::kObjectType);
+
+	metricsCategoryValue.AddMember(rapidjson::StringRef(METRICS_LISTENER_PORT_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(metricsListenerPort)), allocator);
+
+	rapidjson::Value metricsTextFilePathValue(metricsTextFilePath.c_str(), allocator);
+	metricsCategoryValue.AddMember(rapidjson::StringRef(METRICS_TEXT_FILE_PATH_PROPERTY_NAME), metricsTextFilePathValue, allocator);
+
+	settingsDocument.AddMember(rapidjson::StringRef(METRICS_CATEGORY_NAME), metricsCategoryValue, allocator);
+
 	rapidjson::Value fileETagsValue(rapidjson::kObjectType);
 
 	for(std::map<std::string, std::string>::const_iterator i = fileETags.begin(); i != fileETags.end(); ++i) {
@@ -363,6 +594,10 @@ bool SettingsManager::parseFrom(const rapidjson::Value & settingsDocument) {
 		if(curlCategoryValue.HasMember(CURL_VERBOSE_REQUEST_LOGGING_PROPERTY_NAME) && curlCategoryValue[CURL_VERBOSE_REQUEST_LOGGING_PROPERTY_NAME].IsBool()) {
 			verboseRequestLogging = curlCategoryValue[CURL_VERBOSE_REQUEST_LOGGING_PROPERTY_NAME].GetBool();
 		}
+
+		assignBooleanSetting(connectionReuseEnabled, curlCategoryValue, CURL_CONNECTION_REUSE_ENABLED_PROPERTY_NAME);
+		assignBooleanSetting(asynchronousRequestsEnabled, curlCategoryValue, CURL_ASYNCHRONOUS_REQUESTS_ENABLED_PROPERTY_NAME);
+		assignBooleanSetting(http2Enabled, curlCategoryValue, CURL_HTTP2_ENABLED_PROPERTY_NAME);
 	}
 
 	if(settingsDocument.HasMember(DOWNLOAD_THROTTLING_CATEGORY_NAME) && settingsDocument[DOWNLOAD_THROTTLING_CATEGORY_NAME].IsObject()) {
@@ -380,6 +615,45 @@ bool SettingsManager::parseFrom(const rapidjson::Value & settingsDocument) {
 
 		assignChronoSetting(ipAddressUpdateFrequency, domainProfilesValue, DOMAIN_PROFILES_IP_ADDRESS_UPDATE_FREQUENCY_PROPERTY_NAME);
 		assignStringArraySetting(domainProfileFilePaths, domainProfilesValue, DOMAIN_PROFILES_FILE_PATHS_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(maximumConcurrentUpdateRequests, domainProfilesValue, DOMAIN_PROFILES_MAXIMUM_CONCURRENT_UPDATE_REQUESTS_PROPERTY_NAME);
+		assignStringSetting(ipAddressCacheFileName, domainProfilesValue, DOMAIN_PROFILES_IP_ADDRESS_CACHE_FILE_NAME_PROPERTY_NAME);
+		assignStringSetting(updateJournalFileName, domainProfilesValue, DOMAIN_PROFILES_UPDATE_JOURNAL_FILE_NAME_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(numberOfDomainProfileLoadingThreads, domainProfilesValue, DOMAIN_PROFILES_NUMBER_OF_LOADING_THREADS_PROPERTY_NAME);
+		assignBooleanSetting(domainProfileBinarySnapshotsEnabled, domainProfilesValue, DOMAIN_PROFILES_BINARY_SNAPSHOTS_ENABLED_PROPERTY_NAME);
+		assignBooleanSetting(domainProfileArenaStorageEnabled, domainProfilesValue, DOMAIN_PROFILES_ARENA_STORAGE_ENABLED_PROPERTY_NAME);
+		assignBooleanSetting(watchDomainProfileFiles, domainProfilesValue, DOMAIN_PROFILES_WATCH_FILES_PROPERTY_NAME);
+		assignBooleanSetting(monitorAddressChanges, domainProfilesValue, DOMAIN_PROFILES_MONITOR_ADDRESS_CHANGES_PROPERTY_NAME);
+		assignStringSetting(monitoredInterfaceName, domainProfilesValue, DOMAIN_PROFILES_MONITORED_INTERFACE_NAME_PROPERTY_NAME);
+	}
+
+	if(settingsDocument.HasMember(DYNAMIC_DNS_CATEGORY_NAME) && settingsDocument[DYNAMIC_DNS_CATEGORY_NAME].IsObject()) {
+		const rapidjson::Value & dynamicDNSCategoryValue = settingsDocument[DYNAMIC_DNS_CATEGORY_NAME];
+
+		assignStringSetting(dynamicDNSServiceBaseURL, dynamicDNSCategoryValue, DYNAMIC_DNS_SERVICE_BASE_URL_PROPERTY_NAME);
+		assignStringArraySetting(ipAddressLookupURLs, dynamicDNSCategoryValue, DYNAMIC_DNS_IP_ADDRESS_LOOKUP_URLS_PROPERTY_NAME);
+		assignStringArraySetting(ipv6AddressLookupURLs, dynamicDNSCategoryValue, DYNAMIC_DNS_IPV6_ADDRESS_LOOKUP_URLS_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(ipAddressLookupAgreement, dynamicDNSCategoryValue, DYNAMIC_DNS_IP_ADDRESS_LOOKUP_AGREEMENT_PROPERTY_NAME);
+		assignChronoSetting(ipAddressLookupCacheDuration, dynamicDNSCategoryValue, DYNAMIC_DNS_IP_ADDRESS_LOOKUP_CACHE_DURATION_PROPERTY_NAME);
+		assignChronoSetting(ipAddressLookupTimeout, dynamicDNSCategoryValue, DYNAMIC_DNS_IP_ADDRESS_LOOKUP_TIMEOUT_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(maximumUpdateAttempts, dynamicDNSCategoryValue, DYNAMIC_DNS_MAXIMUM_UPDATE_ATTEMPTS_PROPERTY_NAME);
+		assignChronoSetting(updateRetryInitialDelay, dynamicDNSCategoryValue, DYNAMIC_DNS_RETRY_INITIAL_DELAY_PROPERTY_NAME);
+		assignChronoSetting(updateRetryMaximumDelay, dynamicDNSCategoryValue, DYNAMIC_DNS_RETRY_MAXIMUM_DELAY_PROPERTY_NAME);
+		assignDoubleSetting(updateRetryBackoffMultiplier, dynamicDNSCategoryValue, DYNAMIC_DNS_RETRY_BACKOFF_MULTIPLIER_PROPERTY_NAME);
+		assignDoubleSetting(updateRetryJitter, dynamicDNSCategoryValue, DYNAMIC_DNS_RETRY_JITTER_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(circuitBreakerFailureThreshold, dynamicDNSCategoryValue, DYNAMIC_DNS_CIRCUIT_BREAKER_FAILURE_THRESHOLD_PROPERTY_NAME);
+		assignChronoSetting(circuitBreakerResetTimeout, dynamicDNSCategoryValue, DYNAMIC_DNS_CIRCUIT_BREAKER_RESET_TIMEOUT_PROPERTY_NAME);
+		assignDoubleSetting(updateRequestsPerSecond, dynamicDNSCategoryValue, DYNAMIC_DNS_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(updateRequestBurstSize, dynamicDNSCategoryValue, DYNAMIC_DNS_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME);
+		assignDoubleSetting(domainUpdateRequestsPerSecond, dynamicDNSCategoryValue, DYNAMIC_DNS_DOMAIN_UPDATE_REQUESTS_PER_SECOND_PROPERTY_NAME);
+		assignUnsignedIntegerSetting(domainUpdateRequestBurstSize, dynamicDNSCategoryValue, DYNAMIC_DNS_DOMAIN_UPDATE_REQUEST_BURST_SIZE_PROPERTY_NAME);
+		assignChronoSetting(forcedRefreshInterval, dynamicDNSCategoryValue, DYNAMIC_DNS_FORCED_REFRESH_INTERVAL_PROPERTY_NAME);
+	}
+
+	if(settingsDocument.HasMember(METRICS_CATEGORY_NAME) && settingsDocument[METRICS_CATEGORY_NAME].IsObject()) {
+		const rapidjson::Value & metricsCategoryValue = settingsDocument[METRICS_CATEGORY_NAME];
+
+		assignUnsignedIntegerSetting(metricsListenerPort, metricsCategoryValue, METRICS_LISTENER_PORT_PROPERTY_NAME);
+		assignStringSetting(metricsTextFilePath, metricsCategoryValue, METRICS_TEXT_FILE_PATH_PROPERTY_NAME);
 	}
 
 	if(settingsDocument.HasMember(FILE_ETAGS_PROPERTY_NAME) && settingsDocument[FILE_ETAGS_PROPERTY_NAME].IsObject()) {
@@ -397,6 +671,14 @@ bool SettingsManager::isLoaded() const {
 	return m_loaded;
 }
 
+bool SettingsManager::isModified() const {
+	return m_modified;
+}
+
+void SettingsManager::markModified() {
+	m_modified = true;
+}
+
 bool SettingsManager::load(const ArgumentParser * arguments, bool autoCreate) {
 	if(arguments != nullptr) {
 		std::string alternateSettingsFilePath(arguments->getFirstValue("f"));
@@ -415,12 +697,26 @@ bool SettingsManager::load(const ArgumentParser * arguments, bool autoCreate) {
 	return loadFrom(m_filePath, autoCreate);
 }
 
-bool SettingsManager::save(bool overwrite) const {
+bool SettingsManager::save(bool overwrite) {
 	if(!Utilities::areStringsEqual(m_filePath, DEFAULT_SETTINGS_FILE_PATH)) {
 		spdlog::debug("Saving settings to alternate file: '{}'...", m_filePath);
 	}
 
-	return saveTo(m_filePath, overwrite);
+	if(!saveTo(m_filePath, overwrite)) {
+		return false;
+	}
+
+	m_modified = false;
+
+	return true;
+}
+
+bool SettingsManager::saveIfModified() {
+	if(!m_modified) {
+		return true;
+	}
+
+	return save();
 }
 
 bool SettingsManager::loadFrom(const std::string & filePath, bool autoCreate) {
@@ -439,23 +735,14 @@ bool SettingsManager::loadFrom(const std::string & filePath, bool autoCreate) {
 		return false;
 	}
 
-	std::ifstream fileStream(filePath);
+	MappedJSONDocument settings;
 
-	if(!fileStream.is_open()) {
-		spdlog::error("Failed to open settings file '{}' for parsing!", filePath);
-		return false;
-	}
-
-	rapidjson::Document settings;
-	rapidjson::IStreamWrapper fileStreamWrapper(fileStream);
-	if(settings.ParseStream(fileStreamWrapper).HasParseError()) {
+	if(!settings.load(filePath)) {
 		spdlog::error("Failed to parse settings file JSON data!");
 		return false;
 	}
 
-	fileStream.close();
-
-	if(!parseFrom(settings)) {
+	if(!parseFrom(settings.getDocument())) {
 		spdlog::error("Failed to parse settings from file '{}'!", filePath);
 		return false;
 	}
@@ -473,21 +760,30 @@ bool SettingsManager::saveTo(const std::string & filePath, bool overwrite) const
 		return false;
 	}
 
-	std::ofstream fileStream(filePath);
+	std::string settingsData(AtomicFileWriter::toPrettyJSONString(toJSON()));
 
-	if(!fileStream.is_open()) {
-		return false;
+	// rewriting identical contents only wears out flash storage, so compare against the file first
+	if(AtomicFileWriter::hasContents(filePath, settingsData)) {
+		spdlog::debug("Settings file '{}' is already up to date.", filePath);
 	}
+	else {
+		if(!AtomicFileWriter::writeTo(filePath, settingsData)) {
+			spdlog::error("Failed to save settings to file '{}'.", filePath);
+			return false;
+		}
 
-	rapidjson::Document settings(toJSON());
-
-	rapidjson::OStreamWrapper fileStreamWrapper(fileStream);
-	rapidjson::PrettyWriter<rapidjson::OStreamWrapper> fileStreamWriter(fileStreamWrapper);
-	fileStreamWriter.SetIndent('\t', 1);
-	settings.Accept(fileStreamWriter);
-	fileStream.close();
+		ApplicationMetrics::settingsSaves.increment();
 
-	spdlog::info("Settings successfully saved to file '{}'.", filePath);
+		spdlog::info("Settings successfully saved to file '{}'.", filePath);
+	}
 
 	return true;
 }
+
+const std::string & SettingsManager::getFilePath() const {
+	return m_filePath;
+}
+
+std::string SettingsManager::getSettingsDirectoryPath() const {
+	return std::filesystem::path(m_filePath).parent_path().string();
+}
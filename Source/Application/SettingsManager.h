@@ -5,6 +5,7 @@
 
 #include <rapidjson/document.h>
 
+#include <atomic>
 #include <chrono>
 #include <optional>
 #include <string>
@@ -22,10 +23,15 @@ public:
 	bool parseFrom(const rapidjson::Value & settingsDocument);
 
 	bool isLoaded() const;
+	bool isModified() const;
+	void markModified();
 	bool load(const ArgumentParser * arguments = nullptr, bool autoCreate = true);
-	bool save(bool overwrite = true) const;
+	bool save(bool overwrite = true);
+	bool saveIfModified();
 	bool loadFrom(const std::string & filePath, bool autoCreate = true);
 	bool saveTo(const std::string & filePath, bool overwrite = true) const;
+	const std::string & getFilePath() const;
+	std::string getSettingsDirectoryPath() const;
 
 	static const std::string FILE_TYPE;
 	static const uint32_t FILE_FORMAT_VERSION;
@@ -38,10 +44,40 @@ public:
 	static const std::chrono::seconds DEFAULT_NETWORK_TIMEOUT;
 	static const std::chrono::seconds DEFAULT_TRANSFER_TIMEOUT;
 	static const bool DEFAULT_VERBOSE_REQUEST_LOGGING;
+	static const bool DEFAULT_CONNECTION_REUSE_ENABLED;
+	static const bool DEFAULT_ASYNCHRONOUS_REQUESTS_ENABLED;
+	static const bool DEFAULT_HTTP2_ENABLED;
 	static const bool DEFAULT_DOWNLOAD_THROTTLING_ENABLED;
 	static const std::chrono::minutes DEFAULT_CACERT_UPDATE_FREQUENCY;
 	static const std::chrono::minutes DEFAULT_TIME_ZONE_DATA_UPDATE_FREQUENCY;
 	static const std::chrono::minutes DEFAULT_IP_ADDRESS_UPDATE_FREQUENCY;
+	static const size_t DEFAULT_MAXIMUM_CONCURRENT_UPDATE_REQUESTS;
+	static const std::string DEFAULT_IP_ADDRESS_CACHE_FILE_NAME;
+	static const std::string DEFAULT_UPDATE_JOURNAL_FILE_NAME;
+	static const size_t DEFAULT_NUMBER_OF_DOMAIN_PROFILE_LOADING_THREADS;
+	static const bool DEFAULT_DOMAIN_PROFILE_BINARY_SNAPSHOTS_ENABLED;
+	static const bool DEFAULT_DOMAIN_PROFILE_ARENA_STORAGE_ENABLED;
+	static const bool DEFAULT_WATCH_DOMAIN_PROFILE_FILES;
+	static const bool DEFAULT_MONITOR_ADDRESS_CHANGES;
+	static const std::string DEFAULT_DYNAMIC_DNS_SERVICE_BASE_URL;
+	static const std::vector<std::string> DEFAULT_IP_ADDRESS_LOOKUP_URLS;
+	static const std::vector<std::string> DEFAULT_IPV6_ADDRESS_LOOKUP_URLS;
+	static const size_t DEFAULT_IP_ADDRESS_LOOKUP_AGREEMENT;
+	static const std::chrono::seconds DEFAULT_IP_ADDRESS_LOOKUP_CACHE_DURATION;
+	static const std::chrono::milliseconds DEFAULT_IP_ADDRESS_LOOKUP_TIMEOUT;
+	static const size_t DEFAULT_MAXIMUM_UPDATE_ATTEMPTS;
+	static const std::chrono::milliseconds DEFAULT_UPDATE_RETRY_INITIAL_DELAY;
+	static const std::chrono::milliseconds DEFAULT_UPDATE_RETRY_MAXIMUM_DELAY;
+	static const double DEFAULT_UPDATE_RETRY_BACKOFF_MULTIPLIER;
+	static const double DEFAULT_UPDATE_RETRY_JITTER;
+	static const size_t DEFAULT_CIRCUIT_BREAKER_FAILURE_THRESHOLD;
+	static const std::chrono::seconds DEFAULT_CIRCUIT_BREAKER_RESET_TIMEOUT;
+	static const double DEFAULT_UPDATE_REQUESTS_PER_SECOND;
+	static const size_t DEFAULT_UPDATE_REQUEST_BURST_SIZE;
+	static const double DEFAULT_DOMAIN_UPDATE_REQUESTS_PER_SECOND;
+	static const size_t DEFAULT_DOMAIN_UPDATE_REQUEST_BURST_SIZE;
+	static const std::chrono::minutes DEFAULT_FORCED_REFRESH_INTERVAL;
+	static const size_t DEFAULT_METRICS_LISTENER_PORT;
 
 	std::string downloadsDirectoryPath;
 	std::string dataDirectoryPath;
@@ -51,12 +87,50 @@ public:
 	std::chrono::seconds networkTimeout;
 	std::chrono::seconds transferTimeout;
 	bool verboseRequestLogging;
+	bool connectionReuseEnabled;
+	// sends updates from a single event loop thread, only takes effect when connection reuse is enabled
+	bool asynchronousRequestsEnabled;
+	bool http2Enabled;
 	bool downloadThrottlingEnabled;
 	std::optional<std::chrono::time_point<std::chrono::system_clock>> cacertLastDownloadedTimestamp;
 	std::chrono::minutes cacertUpdateFrequency;
 	std::optional<std::chrono::time_point<std::chrono::system_clock>> timeZoneDataLastDownloadedTimestamp;
 	std::chrono::minutes timeZoneDataUpdateFrequency;
 	std::chrono::minutes ipAddressUpdateFrequency;
+	size_t maximumConcurrentUpdateRequests;
+	std::string ipAddressCacheFileName;
+	// only used alongside the ip address cache, which holds the journal's compacted state
+	std::string updateJournalFileName;
+	size_t numberOfDomainProfileLoadingThreads;
+	bool domainProfileBinarySnapshotsEnabled;
+	bool domainProfileArenaStorageEnabled;
+	bool watchDomainProfileFiles;
+	bool monitorAddressChanges;
+	std::string monitoredInterfaceName;
+	std::string dynamicDNSServiceBaseURL;
+	std::vector<std::string> ipAddressLookupURLs;
+	// a configured list replaces the defaults, an empty list disables ipv6 address lookups
+	std::vector<std::string> ipv6AddressLookupURLs;
+	size_t ipAddressLookupAgreement;
+	std::chrono::seconds ipAddressLookupCacheDuration;
+	std::chrono::milliseconds ipAddressLookupTimeout;
+	size_t maximumUpdateAttempts;
+	std::chrono::milliseconds updateRetryInitialDelay;
+	std::chrono::milliseconds updateRetryMaximumDelay;
+	double updateRetryBackoffMultiplier;
+	double updateRetryJitter;
+	size_t circuitBreakerFailureThreshold;
+	std::chrono::seconds circuitBreakerResetTimeout;
+	// zero or less disables the corresponding limit
+	double updateRequestsPerSecond;
+	size_t updateRequestBurstSize;
+	double domainUpdateRequestsPerSecond;
+	size_t domainUpdateRequestBurstSize;
+	// hosts are updated again once this long has passed since they were last updated, even if the ip address is unchanged, zero disables forced refreshes
+	std::chrono::minutes forcedRefreshInterval;
+	// zero disables the loopback metrics listener
+	size_t metricsListenerPort;
+	std::string metricsTextFilePath;
 
 	std::vector<std::string> domainProfileFilePaths;
 	std::map<std::string, std::string> fileETags;
@@ -66,6 +140,8 @@ private:
 	const SettingsManager & operator = (const SettingsManager &) = delete;
 
 	bool m_loaded;
+	// cleared once save writes the settings file successfully
+	std::atomic<bool> m_modified;
 	std::string m_filePath;
 };
 
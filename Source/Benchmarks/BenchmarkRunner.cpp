@@ -0,0 +1,208 @@
+#include "BenchmarkRunner.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <fmt/core.h>
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+static constexpr const char * BENCHMARKS_PROPERTY_NAME = "benchmarks";
+static constexpr const char * NAME_PROPERTY_NAME = "name";
+static constexpr const char * NUMBER_OF_ITERATIONS_PROPERTY_NAME = "iterations";
+static constexpr const char * ITEMS_PER_ITERATION_PROPERTY_NAME = "itemsPerIteration";
+static constexpr const char * MINIMUM_PROPERTY_NAME = "minimumNanoseconds";
+static constexpr const char * MEDIAN_PROPERTY_NAME = "medianNanoseconds";
+static constexpr const char * MEAN_PROPERTY_NAME = "meanNanoseconds";
+static constexpr const char * MAXIMUM_PROPERTY_NAME = "maximumNanoseconds";
+static constexpr const char * ITEMS_PER_SECOND_PROPERTY_NAME = "itemsPerSecond";
+
+const std::chrono::milliseconds BenchmarkRunner::DEFAULT_MINIMUM_DURATION(500);
+const size_t BenchmarkRunner::DEFAULT_MINIMUM_ITERATIONS = 3;
+const size_t BenchmarkRunner::DEFAULT_MAXIMUM_ITERATIONS = 10000;
+
+static std::string formatDuration(std::chrono::nanoseconds duration) {
+	if(duration < std::chrono::microseconds(10)) {
+		return fmt::format("{} ns", duration.count());
+	}
+	else if(duration < std::chrono::milliseconds(10)) {
+		return fmt::format("{:.2f} us", duration.count() / 1000.0);
+	}
+	else if(duration < std::chrono::seconds(10)) {
+		return fmt::format("{:.2f} ms", duration.count() / 1000000.0);
+	}
+
+	return fmt::format("{:.2f} s", duration.count() / 1000000000.0);
+}
+
+double BenchmarkRunner::Result::getItemsPerSecond() const {
+	if(median.count() == 0) {
+		return 0.0;
+	}
+
+	return static_cast<double>(itemsPerIteration) * 1000000000.0 / static_cast<double>(median.count());
+}
+
+BenchmarkRunner::BenchmarkRunner()
+	: m_minimumDuration(DEFAULT_MINIMUM_DURATION)
+	, m_minimumIterations(DEFAULT_MINIMUM_ITERATIONS)
+	, m_maximumIterations(DEFAULT_MAXIMUM_ITERATIONS) { }
+
+BenchmarkRunner::~BenchmarkRunner() { }
+
+const std::string & BenchmarkRunner::getFilter() const {
+	return m_filter;
+}
+
+void BenchmarkRunner::setFilter(const std::string & filter) {
+	m_filter = Utilities::toLowerCase(filter);
+}
+
+std::chrono::milliseconds BenchmarkRunner::getMinimumDuration() const {
+	return m_minimumDuration;
+}
+
+void BenchmarkRunner::setMinimumDuration(std::chrono::milliseconds minimumDuration) {
+	m_minimumDuration = std::max(minimumDuration, std::chrono::milliseconds(0));
+}
+
+size_t BenchmarkRunner::getMinimumIterations() const {
+	return m_minimumIterations;
+}
+
+void BenchmarkRunner::setMinimumIterations(size_t minimumIterations) {
+	m_minimumIterations = std::max(minimumIterations, static_cast<size_t>(1));
+	m_maximumIterations = std::max(m_maximumIterations, m_minimumIterations);
+}
+
+size_t BenchmarkRunner::getMaximumIterations() const {
+	return m_maximumIterations;
+}
+
+void BenchmarkRunner::setMaximumIterations(size_t maximumIterations) {
+	m_maximumIterations = std::max(maximumIterations, m_minimumIterations);
+}
+
+size_t BenchmarkRunner::numberOfBenchmarks() const {
+	return m_benchmarks.size();
+}
+
+void BenchmarkRunner::addBenchmark(const std::string & name, Function function, size_t itemsPerIteration, Function setUp) {
+	if(name.empty() || function == nullptr) {
+		return;
+	}
+
+	m_benchmarks.push_back({ name, function, std::max(itemsPerIteration, static_cast<size_t>(1)), setUp });
+}
+
+std::vector<BenchmarkRunner::Result> BenchmarkRunner::run() const {
+	std::vector<Result> results;
+
+	fmt::print("{:<56} {:>10} {:>12} {:>12} {:>12} {:>12} {:>14}\n", "Benchmark", "Iterations", "Median", "Mean", "Minimum", "Maximum", "Items/s");
+
+	for(const Benchmark & benchmark : m_benchmarks) {
+		if(!m_filter.empty() && Utilities::toLowerCase(benchmark.name).find(m_filter) == std::string::npos) {
+			continue;
+		}
+
+		Result result(runBenchmark(benchmark));
+
+		fmt::print("{:<56} {:>10} {:>12} {:>12} {:>12} {:>12} {:>14.0f}\n", result.name, result.numberOfIterations, formatDuration(result.median), formatDuration(result.mean), formatDuration(result.minimum), formatDuration(result.maximum), result.getItemsPerSecond());
+
+		results.emplace_back(std::move(result));
+	}
+
+	return results;
+}
+
+BenchmarkRunner::Result BenchmarkRunner::runBenchmark(const Benchmark & benchmark) const {
+	std::vector<std::chrono::nanoseconds> iterationDurations;
+	std::chrono::nanoseconds totalDuration(0);
+
+	// one untimed warm up pass so that first touch costs such as page faults and cold caches are not measured
+	if(benchmark.setUp != nullptr) {
+		benchmark.setUp();
+	}
+
+	benchmark.function();
+
+	while(iterationDurations.size() < m_maximumIterations && (iterationDurations.size() < m_minimumIterations || totalDuration < m_minimumDuration)) {
+		if(benchmark.setUp != nullptr) {
+			benchmark.setUp();
+		}
+
+		std::chrono::steady_clock::time_point iterationStartTime(std::chrono::steady_clock::now());
+
+		benchmark.function();
+
+		std::chrono::nanoseconds iterationDuration(std::chrono::steady_clock::now() - iterationStartTime);
+		iterationDurations.push_back(iterationDuration);
+		totalDuration += iterationDuration;
+	}
+
+	std::sort(iterationDurations.begin(), iterationDurations.end());
+
+	Result result;
+	result.name = benchmark.name;
+	result.numberOfIterations = iterationDurations.size();
+	result.itemsPerIteration = benchmark.itemsPerIteration;
+	result.minimum = iterationDurations.front();
+	result.median = iterationDurations[iterationDurations.size() / 2];
+	result.mean = totalDuration / iterationDurations.size();
+	result.maximum = iterationDurations.back();
+
+	return result;
+}
+
+rapidjson::Document BenchmarkRunner::resultsToJSON(const std::vector<Result> & results) {
+	rapidjson::Document resultsDocument(rapidjson::kObjectType);
+	rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & allocator = resultsDocument.GetAllocator();
+
+	rapidjson::Value benchmarksValue(rapidjson::kArrayType);
+	benchmarksValue.Reserve(static_cast<rapidjson::SizeType>(results.size()), allocator);
+
+	for(const Result & result : results) {
+		rapidjson::Value benchmarkValue(rapidjson::kObjectType);
+
+		rapidjson::Value nameValue(result.name.c_str(), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(NAME_PROPERTY_NAME), nameValue, allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(NUMBER_OF_ITERATIONS_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(result.numberOfIterations)), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(ITEMS_PER_ITERATION_PROPERTY_NAME), rapidjson::Value(static_cast<uint64_t>(result.itemsPerIteration)), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(MINIMUM_PROPERTY_NAME), rapidjson::Value(static_cast<int64_t>(result.minimum.count())), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(MEDIAN_PROPERTY_NAME), rapidjson::Value(static_cast<int64_t>(result.median.count())), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(MEAN_PROPERTY_NAME), rapidjson::Value(static_cast<int64_t>(result.mean.count())), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(MAXIMUM_PROPERTY_NAME), rapidjson::Value(static_cast<int64_t>(result.maximum.count())), allocator);
+		benchmarkValue.AddMember(rapidjson::StringRef(ITEMS_PER_SECOND_PROPERTY_NAME), rapidjson::Value(result.getItemsPerSecond()), allocator);
+
+		benchmarksValue.PushBack(benchmarkValue, allocator);
+	}
+
+	resultsDocument.AddMember(rapidjson::StringRef(BENCHMARKS_PROPERTY_NAME), benchmarksValue, allocator);
+
+	return resultsDocument;
+}
+
+bool BenchmarkRunner::saveResultsTo(const std::vector<Result> & results, const std::string & filePath) {
+	std::ofstream fileStream(filePath);
+
+	if(!fileStream.is_open()) {
+		spdlog::error("Failed to open benchmark results file '{}' for writing.", filePath);
+		return false;
+	}
+
+	rapidjson::Document resultsDocument(resultsToJSON(results));
+
+	rapidjson::OStreamWrapper fileStreamWrapper(fileStream);
+	rapidjson::PrettyWriter<rapidjson::OStreamWrapper> fileStreamWriter(fileStreamWrapper);
+	fileStreamWriter.SetIndent('\t', 1);
+	resultsDocument.Accept(fileStreamWriter);
+	fileStream.close();
+
+	spdlog::info("Benchmark results saved to file '{}'.", filePath);
+
+	return true;
+}
@@ -0,0 +1,70 @@
+#ifndef _BENCHMARK_RUNNER_H_
+#define _BENCHMARK_RUNNER_H_
+
+#include <rapidjson/document.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+class BenchmarkRunner final {
+public:
+	typedef std::function<void()> Function;
+
+	struct Result {
+		std::string name;
+		size_t numberOfIterations = 0;
+		size_t itemsPerIteration = 1;
+		std::chrono::nanoseconds minimum = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds median = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds mean = std::chrono::nanoseconds(0);
+		std::chrono::nanoseconds maximum = std::chrono::nanoseconds(0);
+
+		double getItemsPerSecond() const;
+	};
+
+	BenchmarkRunner();
+	~BenchmarkRunner();
+
+	const std::string & getFilter() const;
+	void setFilter(const std::string & filter);
+	std::chrono::milliseconds getMinimumDuration() const;
+	void setMinimumDuration(std::chrono::milliseconds minimumDuration);
+	size_t getMinimumIterations() const;
+	void setMinimumIterations(size_t minimumIterations);
+	size_t getMaximumIterations() const;
+	void setMaximumIterations(size_t maximumIterations);
+
+	size_t numberOfBenchmarks() const;
+	void addBenchmark(const std::string & name, Function function, size_t itemsPerIteration = 1, Function setUp = nullptr);
+	std::vector<Result> run() const;
+
+	static rapidjson::Document resultsToJSON(const std::vector<Result> & results);
+	static bool saveResultsTo(const std::vector<Result> & results, const std::string & filePath);
+
+	static const std::chrono::milliseconds DEFAULT_MINIMUM_DURATION;
+	static const size_t DEFAULT_MINIMUM_ITERATIONS;
+	static const size_t DEFAULT_MAXIMUM_ITERATIONS;
+
+private:
+	struct Benchmark {
+		std::string name;
+		Function function;
+		size_t itemsPerIteration;
+		Function setUp;
+	};
+
+	Result runBenchmark(const Benchmark & benchmark) const;
+
+	std::vector<Benchmark> m_benchmarks;
+	std::string m_filter;
+	std::chrono::milliseconds m_minimumDuration;
+	size_t m_minimumIterations;
+	size_t m_maximumIterations;
+
+	BenchmarkRunner(const BenchmarkRunner &) = delete;
+	const BenchmarkRunner & operator = (const BenchmarkRunner &) = delete;
+};
+
+#endif // _BENCHMARK_RUNNER_H_
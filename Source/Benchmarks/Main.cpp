@@ -0,0 +1,229 @@
+#include "BenchmarkRunner.h"
+#include "Namecheap/NamecheapDomainProfile.h"
+#include "Namecheap/NamecheapDomainProfileCollection.h"
+#include "Namecheap/NamecheapDynamicDNSService.h"
+#include "Network/HTTPSessionPool.h"
+#include "Network/LoopbackHTTPServer.h"
+
+#include <Application/ComponentRegistry.h>
+#include <Arguments/ArgumentParser.h>
+#include <Logging/LogSystem.h>
+#include <Network/HTTPService.h>
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <memory>
+
+static const std::vector<size_t> DOMAIN_PROFILE_COLLECTION_SIZES({ 10, 100, 1000, 10000, 100000 });
+static const std::vector<size_t> UPDATE_FAN_OUT_CONCURRENCY_LEVELS({ 1, 8, 32 });
+static constexpr size_t NUMBER_OF_HOSTS_PER_DOMAIN_PROFILE = 3;
+static constexpr size_t NUMBER_OF_PROFILE_PARSES_PER_ITERATION = 1000;
+static constexpr size_t NUMBER_OF_FAN_OUT_DOMAIN_PROFILES = 64;
+static const std::string BENCHMARK_IP_ADDRESS("203.0.113.1");
+static const std::string NAMECHEAP_SUCCESS_RESPONSE_BODY("<?xml version=\"1.0\" encoding=\"utf-16\"?><interface-response><Command>SETDNSHOST</Command><Language>eng</Language><IP>203.0.113.1</IP><ErrCount>0</ErrCount><errors /><ResponseCount>0</ResponseCount><responses /><Done>true</Done><debug><![CDATA[]]></debug></interface-response>");
+
+static std::unique_ptr<NamecheapDomainProfile> createSyntheticDomainProfile(size_t index) {
+	std::vector<std::string> hosts({ "@", "www", "mail" });
+	hosts.resize(NUMBER_OF_HOSTS_PER_DOMAIN_PROFILE, "host");
+
+	return std::make_unique<NamecheapDomainProfile>(std::move(hosts), fmt::format("benchmark-{}.example.com", index), fmt::format("{:032x}", index * 2654435761u));
+}
+
+static std::shared_ptr<NamecheapDomainProfileCollection> createSyntheticDomainProfileCollection(size_t numberOfDomainProfiles) {
+	std::vector<std::shared_ptr<NamecheapDomainProfile>> domainProfiles;
+	domainProfiles.reserve(numberOfDomainProfiles);
+
+	for(size_t i = 0; i < numberOfDomainProfiles; i++) {
+		domainProfiles.emplace_back(createSyntheticDomainProfile(i));
+	}
+
+	return std::make_shared<NamecheapDomainProfileCollection>(std::move(domainProfiles));
+}
+
+static void addDomainProfileBenchmarks(BenchmarkRunner & benchmarkRunner) {
+	std::shared_ptr<rapidjson::Document> domainProfileDocument(std::make_shared<rapidjson::Document>(rapidjson::kObjectType));
+	std::unique_ptr<NamecheapDomainProfile> domainProfile(createSyntheticDomainProfile(0));
+	domainProfileDocument->CopyFrom(domainProfile->toJSON(domainProfileDocument->GetAllocator()), domainProfileDocument->GetAllocator());
+
+	benchmarkRunner.addBenchmark("NamecheapDomainProfile::parseFrom", [domainProfileDocument]() {
+		for(size_t i = 0; i < NUMBER_OF_PROFILE_PARSES_PER_ITERATION; i++) {
+			if(NamecheapDomainProfile::parseFrom(*domainProfileDocument) == nullptr) {
+				spdlog::error("Failed to parse synthetic domain profile.");
+				return;
+			}
+		}
+	}, NUMBER_OF_PROFILE_PARSES_PER_ITERATION);
+}
+
+static bool addDomainProfileCollectionBenchmarks(BenchmarkRunner & benchmarkRunner, const std::filesystem::path & workingDirectoryPath, size_t maximumNumberOfDomainProfiles) {
+	for(size_t numberOfDomainProfiles : DOMAIN_PROFILE_COLLECTION_SIZES) {
+		if(numberOfDomainProfiles > maximumNumberOfDomainProfiles) {
+			break;
+		}
+
+		std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(createSyntheticDomainProfileCollection(numberOfDomainProfiles));
+		std::string domainProfilesFilePath((workingDirectoryPath / fmt::format("Domain Profiles {}.json", numberOfDomainProfiles)).string());
+		std::string outputFilePath((workingDirectoryPath / fmt::format("Domain Profiles {} Output.json", numberOfDomainProfiles)).string());
+
+		if(!domainProfiles->saveToJSON(domainProfilesFilePath) || !domainProfiles->saveToBinarySnapshot(NamecheapDomainProfileCollection::getBinarySnapshotFilePath(domainProfilesFilePath), true, domainProfilesFilePath)) {
+			spdlog::error("Failed to write synthetic domain profiles file '{}'.", domainProfilesFilePath);
+			return false;
+		}
+
+		benchmarkRunner.addBenchmark(fmt::format("NamecheapDomainProfileCollection::loadFrom/json/{}", numberOfDomainProfiles), [domainProfilesFilePath]() {
+			NamecheapDomainProfileCollection loadedDomainProfiles;
+			loadedDomainProfiles.loadFrom(domainProfilesFilePath, false, false);
+		}, numberOfDomainProfiles);
+
+		benchmarkRunner.addBenchmark(fmt::format("NamecheapDomainProfileCollection::loadFrom/snapshot/{}", numberOfDomainProfiles), [domainProfilesFilePath]() {
+			NamecheapDomainProfileCollection loadedDomainProfiles;
+			loadedDomainProfiles.loadFrom(domainProfilesFilePath, false, true);
+		}, numberOfDomainProfiles);
+
+		benchmarkRunner.addBenchmark(fmt::format("NamecheapDomainProfileCollection::toJSON/{}", numberOfDomainProfiles), [domainProfiles]() {
+			domainProfiles->toJSON();
+		}, numberOfDomainProfiles);
+
+		benchmarkRunner.addBenchmark(fmt::format("NamecheapDomainProfileCollection::saveToJSON/{}", numberOfDomainProfiles), [domainProfiles, outputFilePath]() {
+			domainProfiles->saveToJSON(outputFilePath);
+		}, numberOfDomainProfiles);
+	}
+
+	return true;
+}
+
+static bool addUpdateFanOutBenchmarks(BenchmarkRunner & benchmarkRunner, std::shared_ptr<LoopbackHTTPServer> stubServer) {
+	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(createSyntheticDomainProfileCollection(NUMBER_OF_FAN_OUT_DOMAIN_PROFILES));
+	size_t numberOfHosts = NUMBER_OF_FAN_OUT_DOMAIN_PROFILES * NUMBER_OF_HOSTS_PER_DOMAIN_PROFILE;
+
+	HTTPSessionPool::Configuration sessionPoolConfiguration;
+	sessionPoolConfiguration.connectionTimeout = std::chrono::seconds(5);
+	sessionPoolConfiguration.networkTimeout = std::chrono::seconds(5);
+
+	for(bool pooled : { false, true }) {
+		for(size_t concurrencyLevel : UPDATE_FAN_OUT_CONCURRENCY_LEVELS) {
+			std::shared_ptr<NamecheapDynamicDNSService> dynamicDNSService(std::make_shared<NamecheapDynamicDNSService>());
+			dynamicDNSService->setBaseURL(stubServer->getBaseURL());
+			dynamicDNSService->setMaximumConcurrentRequests(concurrencyLevel);
+			dynamicDNSService->setRetryPolicy(RetryPolicy(1));
+
+			if(pooled) {
+				dynamicDNSService->setHTTPSessionPool(std::make_shared<HTTPSessionPool>(sessionPoolConfiguration));
+			}
+
+			benchmarkRunner.addBenchmark(fmt::format("NamecheapDynamicDNSService::setIPAddress/hosts={}/concurrency={}{}", numberOfHosts, concurrencyLevel, pooled ? "/pooled" : ""), [dynamicDNSService, domainProfiles, stubServer]() {
+				NamecheapDynamicDNSUpdateReport report(dynamicDNSService->setIPAddress(*domainProfiles, BENCHMARK_IP_ADDRESS, true));
+
+				if(!report.isSuccessful()) {
+					spdlog::error("Update fan-out against stub server failed for {} of {} hosts.", report.numberOfFailedUpdates(), report.numberOfHostResults());
+				}
+			}, numberOfHosts);
+		}
+	}
+
+	return true;
+}
+
+static void displayArgumentHelp() {
+	fmt::print("Usage: NamecheapDynamicDNSAutoUpdaterBenchmarks [options]\n");
+	fmt::print(" --filter <text> - Only run benchmarks whose name contains the given text.\n");
+	fmt::print(" --min-time <ms> - Minimum measured time per benchmark, defaults to {} ms.\n", BenchmarkRunner::DEFAULT_MINIMUM_DURATION.count());
+	fmt::print(" --max-profiles <count> - Largest synthetic domain profile collection to generate, defaults to {}.\n", DOMAIN_PROFILE_COLLECTION_SIZES.back());
+	fmt::print(" --output <file> - Write benchmark results to a JSON file for regression comparisons.\n");
+	fmt::print(" --no-network - Skip the update fan-out benchmarks.\n");
+}
+
+int main(int argc, char * argv[]) {
+	ArgumentParser arguments(argc, argv);
+
+	if(arguments.hasArgument("?", "help")) {
+		displayArgumentHelp();
+		return 0;
+	}
+
+	ComponentRegistry::getInstance().registerGlobalComponents();
+
+	// loading and saving logs at info level, which would otherwise dominate the measured time
+	LogSystem::getInstance()->setLevel(spdlog::level::warn);
+
+	BenchmarkRunner benchmarkRunner;
+	benchmarkRunner.setFilter(arguments.getFirstValue("filter"));
+
+	size_t maximumNumberOfDomainProfiles = DOMAIN_PROFILE_COLLECTION_SIZES.back();
+
+	try {
+		std::string minimumDurationValue(arguments.getFirstValue("min-time"));
+
+		if(!minimumDurationValue.empty()) {
+			benchmarkRunner.setMinimumDuration(std::chrono::milliseconds(std::stoul(minimumDurationValue)));
+		}
+
+		std::string maximumNumberOfDomainProfilesValue(arguments.getFirstValue("max-profiles"));
+
+		if(!maximumNumberOfDomainProfilesValue.empty()) {
+			maximumNumberOfDomainProfiles = std::stoul(maximumNumberOfDomainProfilesValue);
+		}
+	}
+	catch(const std::exception &) {
+		spdlog::error("Invalid numeric benchmark argument.");
+		return 1;
+	}
+
+	std::filesystem::path workingDirectoryPath(std::filesystem::temp_directory_path() / "NamecheapDynamicDNSAutoUpdaterBenchmarks");
+	std::error_code errorCode;
+	std::filesystem::create_directories(workingDirectoryPath, errorCode);
+
+	if(errorCode) {
+		spdlog::error("Failed to create benchmark working directory '{}': {}", workingDirectoryPath.string(), errorCode.message());
+		return 1;
+	}
+
+	addDomainProfileBenchmarks(benchmarkRunner);
+
+	if(!addDomainProfileCollectionBenchmarks(benchmarkRunner, workingDirectoryPath, maximumNumberOfDomainProfiles)) {
+		return 1;
+	}
+
+	std::shared_ptr<LoopbackHTTPServer> stubServer;
+
+	if(!arguments.hasArgument("no-network")) {
+		HTTPService * httpService = HTTPService::getInstance();
+
+		HTTPConfiguration configuration = {
+			(workingDirectoryPath / "cURL").string(),
+			"",
+			std::chrono::seconds(5),
+			std::chrono::seconds(5),
+			std::chrono::seconds(0)
+		};
+
+		stubServer = std::make_shared<LoopbackHTTPServer>(200, "text/xml", NAMECHEAP_SUCCESS_RESPONSE_BODY);
+
+		if(!httpService->initialize(configuration) || !stubServer->start()) {
+			spdlog::warn("Failed to initialize local stub server, skipping update fan-out benchmarks.");
+		}
+		else {
+			addUpdateFanOutBenchmarks(benchmarkRunner, stubServer);
+		}
+	}
+
+	std::vector<BenchmarkRunner::Result> results(benchmarkRunner.run());
+
+	if(stubServer != nullptr) {
+		stubServer->stop();
+	}
+
+	std::string outputFilePath(arguments.getFirstValue("output"));
+
+	if(!outputFilePath.empty()) {
+		BenchmarkRunner::saveResultsTo(results, outputFilePath);
+	}
+
+	std::filesystem::remove_all(workingDirectoryPath, errorCode);
+
+	ComponentRegistry::getInstance().deleteAllGlobalComponents();
+
+	return 0;
+}
@@ -0,0 +1,151 @@
+#include "AtomicFileWriter.h"
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <filesystem>
+#include <fstream>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+static const std::string TEMPORARY_FILE_EXTENSION("tmp");
+
+bool AtomicFileWriter::writeTo(const std::string & filePath, std::string_view data, [[maybe_unused]] const std::string & permissionsFilePath) {
+	if(filePath.empty()) {
+		return false;
+	}
+
+	std::string temporaryFilePath(getTemporaryFilePath(filePath));
+
+#if _WIN32
+	HANDLE fileHandle = CreateFileA(temporaryFilePath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if(fileHandle == INVALID_HANDLE_VALUE) {
+		spdlog::error("Failed to create temporary file '{}'.", temporaryFilePath);
+		return false;
+	}
+
+	size_t numberOfBytesWritten = 0;
+	bool writeSucceeded = true;
+
+	while(numberOfBytesWritten < data.size()) {
+		DWORD chunkSize = static_cast<DWORD>(std::min(data.size() - numberOfBytesWritten, static_cast<size_t>(MAXDWORD)));
+		DWORD chunkBytesWritten = 0;
+
+		if(!WriteFile(fileHandle, data.data() + numberOfBytesWritten, chunkSize, &chunkBytesWritten, nullptr) || chunkBytesWritten == 0) {
+			writeSucceeded = false;
+			break;
+		}
+
+		numberOfBytesWritten += chunkBytesWritten;
+	}
+
+	writeSucceeded = writeSucceeded && FlushFileBuffers(fileHandle);
+	CloseHandle(fileHandle);
+
+	if(!writeSucceeded || !MoveFileExA(temporaryFilePath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+		spdlog::error("Failed to write file '{}'.", filePath);
+		DeleteFileA(temporaryFilePath.c_str());
+		return false;
+	}
+#else
+	// keep the permissions of the file being replaced or the given file, settings and files derived from domain profiles can contain credentials
+	mode_t fileMode = 0644;
+	struct stat fileStatus;
+
+	if(stat(permissionsFilePath.empty() ? filePath.c_str() : permissionsFilePath.c_str(), &fileStatus) == 0) {
+		fileMode = fileStatus.st_mode & 07777;
+	}
+
+	int fileDescriptor = open(temporaryFilePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, fileMode);
+
+	if(fileDescriptor < 0) {
+		spdlog::error("Failed to create temporary file '{}'.", temporaryFilePath);
+		return false;
+	}
+
+	size_t numberOfBytesWritten = 0;
+	bool writeSucceeded = true;
+
+	while(numberOfBytesWritten < data.size()) {
+		ssize_t chunkBytesWritten = write(fileDescriptor, data.data() + numberOfBytesWritten, data.size() - numberOfBytesWritten);
+
+		if(chunkBytesWritten < 0 && errno == EINTR) {
+			continue;
+		}
+
+		if(chunkBytesWritten <= 0) {
+			writeSucceeded = false;
+			break;
+		}
+
+		numberOfBytesWritten += static_cast<size_t>(chunkBytesWritten);
+	}
+
+	writeSucceeded = fsync(fileDescriptor) == 0 && writeSucceeded;
+	writeSucceeded = close(fileDescriptor) == 0 && writeSucceeded;
+
+	if(!writeSucceeded || rename(temporaryFilePath.c_str(), filePath.c_str()) != 0) {
+		spdlog::error("Failed to write file '{}'.", filePath);
+		unlink(temporaryFilePath.c_str());
+		return false;
+	}
+
+	// flush the directory entry as well, otherwise the rename itself may not survive a power loss
+	std::string directoryPath(std::filesystem::path(filePath).parent_path().string());
+	int directoryFileDescriptor = open(directoryPath.empty() ? "." : directoryPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+
+	if(directoryFileDescriptor >= 0) {
+		fsync(directoryFileDescriptor);
+		close(directoryFileDescriptor);
+	}
+#endif // _WIN32
+
+	return true;
+}
+
+bool AtomicFileWriter::writeJSONTo(const std::string & filePath, const rapidjson::Value & value) {
+	return writeTo(filePath, toPrettyJSONString(value));
+}
+
+std::string AtomicFileWriter::toPrettyJSONString(const rapidjson::Value & value) {
+	rapidjson::StringBuffer stringBuffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> stringBufferWriter(stringBuffer);
+	stringBufferWriter.SetIndent('\t', 1);
+	value.Accept(stringBufferWriter);
+
+	return std::string(stringBuffer.GetString(), stringBuffer.GetSize());
+}
+
+bool AtomicFileWriter::hasContents(const std::string & filePath, std::string_view data) {
+	std::error_code errorCode;
+	uintmax_t fileSize = std::filesystem::file_size(std::filesystem::path(filePath), errorCode);
+
+	if(errorCode || fileSize != data.size()) {
+		return false;
+	}
+
+	std::ifstream fileStream(filePath, std::ios::binary);
+
+	if(!fileStream.is_open()) {
+		return false;
+	}
+
+	std::string fileContents(data.size(), '\0');
+	fileStream.read(fileContents.data(), static_cast<std::streamsize>(fileContents.size()));
+
+	return !fileStream.fail() && fileContents == data;
+}
+
+std::string AtomicFileWriter::getTemporaryFilePath(const std::string & filePath) {
+	return filePath + "." + TEMPORARY_FILE_EXTENSION;
+}
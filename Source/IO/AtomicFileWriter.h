@@ -0,0 +1,24 @@
+#ifndef _ATOMIC_FILE_WRITER_H_
+#define _ATOMIC_FILE_WRITER_H_
+
+#include <rapidjson/document.h>
+
+#include <string>
+#include <string_view>
+
+// replaces files by writing to a temporary file in the same directory, flushing it to disk and renaming it over the original,
+// so readers and crashes only ever observe the complete previous or complete new contents
+class AtomicFileWriter final {
+public:
+	// new files take the permissions of the file at permissions file path when given, otherwise those of the file being replaced
+	static bool writeTo(const std::string & filePath, std::string_view data, const std::string & permissionsFilePath = {});
+	static bool writeJSONTo(const std::string & filePath, const rapidjson::Value & value);
+	static std::string toPrettyJSONString(const rapidjson::Value & value);
+	static bool hasContents(const std::string & filePath, std::string_view data);
+	static std::string getTemporaryFilePath(const std::string & filePath);
+
+private:
+	AtomicFileWriter() = delete;
+};
+
+#endif // _ATOMIC_FILE_WRITER_H_
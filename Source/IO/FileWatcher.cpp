@@ -0,0 +1,236 @@
+#include "FileWatcher.h"
+
+#include <spdlog/spdlog.h>
+
+#if __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif // __linux__
+
+const std::chrono::milliseconds FileWatcher::DEFAULT_DEBOUNCE_INTERVAL(500);
+const std::chrono::milliseconds FileWatcher::POLL_INTERVAL(250);
+
+bool FileWatcher::FileStatus::operator == (const FileStatus & fileStatus) const {
+	return exists == fileStatus.exists &&
+		   lastWriteTime == fileStatus.lastWriteTime &&
+		   size == fileStatus.size;
+}
+
+bool FileWatcher::FileStatus::operator != (const FileStatus & fileStatus) const {
+	return !operator == (fileStatus);
+}
+
+FileWatcher::FileWatcher(ChangeCallback changeCallback, std::chrono::milliseconds debounceInterval)
+	: m_changeCallback(changeCallback)
+	, m_debounceInterval(debounceInterval)
+	, m_running(false)
+#if __linux__
+	, m_inotifyFileDescriptor(-1)
+#endif // __linux__
+{ }
+
+FileWatcher::~FileWatcher() {
+	stop();
+}
+
+size_t FileWatcher::numberOfWatchedFiles() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_watchedFiles.size();
+}
+
+bool FileWatcher::isWatchingFile(const std::string & filePath) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_watchedFiles.find(getWatchedFilePath(filePath)) != m_watchedFiles.cend();
+}
+
+bool FileWatcher::watchFile(const std::string & filePath) {
+	if(filePath.empty()) {
+		return false;
+	}
+
+	if(m_running) {
+		spdlog::error("Cannot watch file '{}' after file watcher has started.", filePath);
+		return false;
+	}
+
+	std::string watchedFilePath(getWatchedFilePath(filePath));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_watchedFiles.emplace(watchedFilePath, getFileStatus(watchedFilePath));
+
+	return true;
+}
+
+bool FileWatcher::isRunning() const {
+	return m_running;
+}
+
+bool FileWatcher::start() {
+	if(m_running) {
+		return true;
+	}
+
+	if(m_changeCallback == nullptr) {
+		return false;
+	}
+
+#if __linux__
+	m_inotifyFileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if(m_inotifyFileDescriptor < 0) {
+		spdlog::warn("Failed to initialize inotify, falling back to polling for file changes.");
+	}
+	else {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::set<std::filesystem::path> watchedDirectoryPaths;
+
+		for(std::map<std::string, FileStatus>::const_iterator i = m_watchedFiles.cbegin(); i != m_watchedFiles.cend(); ++i) {
+			std::filesystem::path directoryPath(std::filesystem::path(i->first).parent_path());
+
+			if(!watchedDirectoryPaths.insert(directoryPath).second) {
+				continue;
+			}
+
+			int watchDescriptor = inotify_add_watch(m_inotifyFileDescriptor, directoryPath.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE);
+
+			if(watchDescriptor < 0) {
+				spdlog::warn("Failed to watch directory '{}' for file changes.", directoryPath.string());
+				continue;
+			}
+
+			m_watchedDirectories[watchDescriptor] = directoryPath;
+		}
+	}
+#endif // __linux__
+
+	m_running = true;
+	m_watchThread = std::thread(&FileWatcher::run, this);
+
+	return true;
+}
+
+void FileWatcher::stop() {
+	if(!m_running) {
+		return;
+	}
+
+	m_running = false;
+
+	if(m_watchThread.joinable()) {
+		m_watchThread.join();
+	}
+
+#if __linux__
+	if(m_inotifyFileDescriptor >= 0) {
+		close(m_inotifyFileDescriptor);
+		m_inotifyFileDescriptor = -1;
+	}
+
+	m_watchedDirectories.clear();
+#endif // __linux__
+}
+
+std::string FileWatcher::getWatchedFilePath(const std::string & filePath) {
+	std::error_code errorCode;
+	std::filesystem::path absoluteFilePath(std::filesystem::absolute(std::filesystem::path(filePath), errorCode));
+
+	return (errorCode ? std::filesystem::path(filePath) : absoluteFilePath).lexically_normal().string();
+}
+
+FileWatcher::FileStatus FileWatcher::getFileStatus(const std::string & filePath) {
+	FileStatus fileStatus;
+	std::error_code errorCode;
+
+	fileStatus.exists = std::filesystem::is_regular_file(std::filesystem::path(filePath), errorCode);
+
+	if(fileStatus.exists) {
+		fileStatus.lastWriteTime = std::filesystem::last_write_time(std::filesystem::path(filePath), errorCode);
+		fileStatus.size = std::filesystem::file_size(std::filesystem::path(filePath), errorCode);
+	}
+
+	return fileStatus;
+}
+
+void FileWatcher::run() {
+	std::set<std::string> pendingFilePaths;
+	std::chrono::steady_clock::time_point lastChangeTime;
+
+	while(m_running) {
+		std::set<std::string> changedFilePaths;
+
+		collectChangedFiles(changedFilePaths);
+
+		if(!changedFilePaths.empty()) {
+			pendingFilePaths.insert(changedFilePaths.begin(), changedFilePaths.end());
+			lastChangeTime = std::chrono::steady_clock::now();
+		}
+
+		// saving a file often produces a burst of events, so wait for the files to settle before reporting them once
+		if(pendingFilePaths.empty() || std::chrono::steady_clock::now() - lastChangeTime < m_debounceInterval) {
+			continue;
+		}
+
+		std::vector<std::string> settledFilePaths(pendingFilePaths.begin(), pendingFilePaths.end());
+		pendingFilePaths.clear();
+
+		m_changeCallback(settledFilePaths);
+	}
+}
+
+void FileWatcher::collectChangedFiles(std::set<std::string> & changedFilePaths) {
+#if __linux__
+	if(m_inotifyFileDescriptor >= 0) {
+		pollfd inotifyPollEntry;
+		inotifyPollEntry.fd = m_inotifyFileDescriptor;
+		inotifyPollEntry.events = POLLIN;
+		inotifyPollEntry.revents = 0;
+
+		if(poll(&inotifyPollEntry, 1, static_cast<int>(POLL_INTERVAL.count())) <= 0) {
+			return;
+		}
+
+		alignas(inotify_event) char eventBuffer[4096];
+		ssize_t numberOfBytesRead = 0;
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		while((numberOfBytesRead = read(m_inotifyFileDescriptor, eventBuffer, sizeof(eventBuffer))) > 0) {
+			for(ssize_t eventOffset = 0; eventOffset < numberOfBytesRead;) {
+				const inotify_event * event = reinterpret_cast<const inotify_event *>(eventBuffer + eventOffset);
+				eventOffset += sizeof(inotify_event) + event->len;
+
+				std::map<int, std::filesystem::path>::const_iterator watchedDirectoryIterator(m_watchedDirectories.find(event->wd));
+
+				if(event->len == 0 || watchedDirectoryIterator == m_watchedDirectories.cend()) {
+					continue;
+				}
+
+				std::string filePath((watchedDirectoryIterator->second / event->name).string());
+
+				if(m_watchedFiles.find(filePath) != m_watchedFiles.cend()) {
+					changedFilePaths.insert(filePath);
+				}
+			}
+		}
+
+		return;
+	}
+#endif // __linux__
+
+	std::this_thread::sleep_for(POLL_INTERVAL);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	for(std::map<std::string, FileStatus>::iterator i = m_watchedFiles.begin(); i != m_watchedFiles.end(); ++i) {
+		FileStatus fileStatus(getFileStatus(i->first));
+
+		if(fileStatus != i->second) {
+			i->second = fileStatus;
+			changedFilePaths.insert(i->first);
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#ifndef _FILE_WATCHER_H_
+#define _FILE_WATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+class FileWatcher final {
+public:
+	typedef std::function<void(const std::vector<std::string> & changedFilePaths)> ChangeCallback;
+
+	FileWatcher(ChangeCallback changeCallback, std::chrono::milliseconds debounceInterval = DEFAULT_DEBOUNCE_INTERVAL);
+	~FileWatcher();
+
+	size_t numberOfWatchedFiles() const;
+	bool isWatchingFile(const std::string & filePath) const;
+	bool watchFile(const std::string & filePath);
+	bool isRunning() const;
+	bool start();
+	void stop();
+
+	static std::string getWatchedFilePath(const std::string & filePath);
+
+	static const std::chrono::milliseconds DEFAULT_DEBOUNCE_INTERVAL;
+	static const std::chrono::milliseconds POLL_INTERVAL;
+
+private:
+	struct FileStatus {
+		bool exists = false;
+		std::filesystem::file_time_type lastWriteTime;
+		uintmax_t size = 0;
+
+		bool operator == (const FileStatus & fileStatus) const;
+		bool operator != (const FileStatus & fileStatus) const;
+	};
+
+	static FileStatus getFileStatus(const std::string & filePath);
+	void run();
+	void collectChangedFiles(std::set<std::string> & changedFilePaths);
+
+	ChangeCallback m_changeCallback;
+	std::chrono::milliseconds m_debounceInterval;
+	// watched file paths mapped to their status when last checked, only used by the polling fallback
+	std::map<std::string, FileStatus> m_watchedFiles;
+	std::atomic<bool> m_running;
+	std::thread m_watchThread;
+	mutable std::mutex m_mutex;
+#if __linux__
+	int m_inotifyFileDescriptor;
+	// inotify watch descriptors mapped to the directory they watch, editors often replace files by renaming so directories are watched instead of files
+	std::map<int, std::filesystem::path> m_watchedDirectories;
+#endif // __linux__
+
+	FileWatcher(const FileWatcher &) = delete;
+	const FileWatcher & operator = (const FileWatcher &) = delete;
+};
+
+#endif // _FILE_WATCHER_H_
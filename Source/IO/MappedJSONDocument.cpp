@@ -0,0 +1,68 @@
+#include "MappedJSONDocument.h"
+
+#include <rapidjson/error/en.h>
+#include <spdlog/spdlog.h>
+
+MappedJSONDocument::MappedJSONDocument()
+	: m_loaded(false)
+	, m_inSitu(false) { }
+
+MappedJSONDocument::~MappedJSONDocument() = default;
+
+bool MappedJSONDocument::isLoaded() const {
+	return m_loaded;
+}
+
+bool MappedJSONDocument::load(const std::string & filePath) {
+	unload();
+
+	if(!m_file.open(filePath, MemoryMappedFile::AccessMode::CopyOnWrite)) {
+		return false;
+	}
+
+	if(m_file.getSize() == 0) {
+		spdlog::error("JSON file '{}' is empty.", filePath);
+		m_file.close();
+		return false;
+	}
+
+	// in situ parsing decodes strings directly inside the private mapping, which requires the data to be null terminated
+	if(m_file.isNullTerminated()) {
+		m_document.ParseInsitu(reinterpret_cast<char *>(m_file.getWritableData()));
+		m_inSitu = true;
+	}
+	else {
+		m_document.Parse(reinterpret_cast<const char *>(m_file.getData()), m_file.getSize());
+		m_inSitu = false;
+	}
+
+	if(m_document.HasParseError()) {
+		spdlog::error("Failed to parse JSON file '{}' at offset {}: {}", filePath, m_document.GetErrorOffset(), rapidjson::GetParseError_En(m_document.GetParseError()));
+		unload();
+		return false;
+	}
+
+	// non in situ documents hold copies of all of their strings, so the mapping is no longer needed
+	if(!m_inSitu) {
+		m_file.close();
+	}
+
+	m_loaded = true;
+
+	return true;
+}
+
+void MappedJSONDocument::unload() {
+	m_document = rapidjson::Document();
+	m_file.close();
+	m_loaded = false;
+	m_inSitu = false;
+}
+
+bool MappedJSONDocument::isInSitu() const {
+	return m_inSitu;
+}
+
+const rapidjson::Document & MappedJSONDocument::getDocument() const {
+	return m_document;
+}
@@ -0,0 +1,31 @@
+#ifndef _MAPPED_JSON_DOCUMENT_H_
+#define _MAPPED_JSON_DOCUMENT_H_
+
+#include "MemoryMappedFile.h"
+
+#include <rapidjson/document.h>
+
+#include <string>
+
+class MappedJSONDocument final {
+public:
+	MappedJSONDocument();
+	~MappedJSONDocument();
+
+	bool isLoaded() const;
+	bool load(const std::string & filePath);
+	void unload();
+	bool isInSitu() const;
+	const rapidjson::Document & getDocument() const;
+
+private:
+	MemoryMappedFile m_file;
+	rapidjson::Document m_document;
+	bool m_loaded;
+	bool m_inSitu;
+
+	MappedJSONDocument(const MappedJSONDocument &) = delete;
+	const MappedJSONDocument & operator = (const MappedJSONDocument &) = delete;
+};
+
+#endif // _MAPPED_JSON_DOCUMENT_H_
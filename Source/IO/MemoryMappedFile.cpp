@@ -0,0 +1,241 @@
+#include "MemoryMappedFile.h"
+
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif // _WIN32
+
+static size_t getPageSize() {
+#if _WIN32
+	SYSTEM_INFO systemInformation;
+	GetSystemInfo(&systemInformation);
+
+	return static_cast<size_t>(systemInformation.dwPageSize);
+#else
+	long pageSize = sysconf(_SC_PAGESIZE);
+
+	return pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+#endif // _WIN32
+}
+
+MemoryMappedFile::MemoryMappedFile()
+	: m_accessMode(AccessMode::ReadOnly)
+	, m_data(nullptr)
+	, m_size(0)
+	, m_nullTerminated(false)
+	, m_open(false)
+#if _WIN32
+	, m_fileHandle(INVALID_HANDLE_VALUE)
+	, m_mappingHandle(nullptr)
+#endif // _WIN32
+{ }
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile && file) noexcept
+	: m_filePath(std::move(file.m_filePath))
+	, m_accessMode(file.m_accessMode)
+	, m_data(file.m_data)
+	, m_size(file.m_size)
+	, m_nullTerminated(file.m_nullTerminated)
+	, m_open(file.m_open)
+#if _WIN32
+	, m_fileHandle(file.m_fileHandle)
+	, m_mappingHandle(file.m_mappingHandle)
+#endif // _WIN32
+{
+	file.m_data = nullptr;
+	file.m_size = 0;
+	file.m_nullTerminated = false;
+	file.m_open = false;
+#if _WIN32
+	file.m_fileHandle = INVALID_HANDLE_VALUE;
+	file.m_mappingHandle = nullptr;
+#endif // _WIN32
+}
+
+MemoryMappedFile & MemoryMappedFile::operator = (MemoryMappedFile && file) noexcept {
+	if(this != &file) {
+		close();
+
+		m_filePath = std::move(file.m_filePath);
+		m_accessMode = file.m_accessMode;
+		m_data = file.m_data;
+		m_size = file.m_size;
+		m_nullTerminated = file.m_nullTerminated;
+		m_open = file.m_open;
+#if _WIN32
+		m_fileHandle = file.m_fileHandle;
+		m_mappingHandle = file.m_mappingHandle;
+		file.m_fileHandle = INVALID_HANDLE_VALUE;
+		file.m_mappingHandle = nullptr;
+#endif // _WIN32
+
+		file.m_data = nullptr;
+		file.m_size = 0;
+		file.m_nullTerminated = false;
+		file.m_open = false;
+	}
+
+	return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+	close();
+}
+
+bool MemoryMappedFile::isOpen() const {
+	return m_open;
+}
+
+bool MemoryMappedFile::open(const std::string & filePath, AccessMode accessMode) {
+	close();
+
+	if(filePath.empty()) {
+		return false;
+	}
+
+	std::error_code errorCode;
+	uintmax_t fileSize = std::filesystem::file_size(std::filesystem::path(filePath), errorCode);
+
+	if(errorCode) {
+		spdlog::error("Failed to determine size of file '{}' for memory mapping: {}", filePath, errorCode.message());
+		return false;
+	}
+
+	m_filePath = filePath;
+	m_accessMode = accessMode;
+	m_size = static_cast<size_t>(fileSize);
+
+	// empty files cannot be mapped, but are still valid to read
+	if(m_size == 0) {
+		m_open = true;
+		return true;
+	}
+
+#if _WIN32
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if(fileHandle == INVALID_HANDLE_VALUE) {
+		spdlog::error("Failed to open file '{}' for memory mapping.", filePath);
+		return false;
+	}
+
+	HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, accessMode == AccessMode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
+
+	if(mappingHandle == nullptr) {
+		spdlog::error("Failed to create memory mapping for file '{}'.", filePath);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	void * data = MapViewOfFile(mappingHandle, accessMode == AccessMode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+
+	if(data == nullptr) {
+		spdlog::error("Failed to map view of file '{}'.", filePath);
+		CloseHandle(mappingHandle);
+		CloseHandle(fileHandle);
+		return false;
+	}
+
+	m_fileHandle = fileHandle;
+	m_mappingHandle = mappingHandle;
+#else
+	int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+
+	if(fileDescriptor == -1) {
+		spdlog::error("Failed to open file '{}' for memory mapping.", filePath);
+		return false;
+	}
+
+	void * data = mmap(nullptr, m_size, accessMode == AccessMode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+	// the mapping keeps its own reference to the file
+	::close(fileDescriptor);
+
+	if(data == MAP_FAILED) {
+		spdlog::error("Failed to memory map file '{}'.", filePath);
+		return false;
+	}
+
+#ifdef POSIX_MADV_SEQUENTIAL
+	posix_madvise(data, m_size, POSIX_MADV_SEQUENTIAL);
+#endif // POSIX_MADV_SEQUENTIAL
+#endif // _WIN32
+
+	m_data = static_cast<uint8_t *>(data);
+
+	// the remainder of the last mapped page is zero filled, so unless the file ends exactly on a page boundary the contents are null terminated
+	m_nullTerminated = m_size % getPageSize() != 0;
+	m_open = true;
+
+	return true;
+}
+
+void MemoryMappedFile::close() {
+	if(m_data != nullptr) {
+#if _WIN32
+		UnmapViewOfFile(m_data);
+#else
+		munmap(m_data, m_size);
+#endif // _WIN32
+	}
+
+#if _WIN32
+	if(m_mappingHandle != nullptr) {
+		CloseHandle(m_mappingHandle);
+		m_mappingHandle = nullptr;
+	}
+
+	if(m_fileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_fileHandle);
+		m_fileHandle = INVALID_HANDLE_VALUE;
+	}
+#endif // _WIN32
+
+	m_data = nullptr;
+	m_size = 0;
+	m_nullTerminated = false;
+	m_open = false;
+}
+
+const std::string & MemoryMappedFile::getFilePath() const {
+	return m_filePath;
+}
+
+MemoryMappedFile::AccessMode MemoryMappedFile::getAccessMode() const {
+	return m_accessMode;
+}
+
+const uint8_t * MemoryMappedFile::getData() const {
+	return m_data;
+}
+
+uint8_t * MemoryMappedFile::getWritableData() {
+	if(m_accessMode != AccessMode::CopyOnWrite) {
+		return nullptr;
+	}
+
+	return m_data;
+}
+
+size_t MemoryMappedFile::getSize() const {
+	return m_size;
+}
+
+std::string_view MemoryMappedFile::getContents() const {
+	if(m_data == nullptr) {
+		return {};
+	}
+
+	return std::string_view(reinterpret_cast<const char *>(m_data), m_size);
+}
+
+bool MemoryMappedFile::isNullTerminated() const {
+	return m_nullTerminated;
+}
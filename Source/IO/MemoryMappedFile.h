@@ -0,0 +1,48 @@
+#ifndef _MEMORY_MAPPED_FILE_H_
+#define _MEMORY_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class MemoryMappedFile final {
+public:
+	enum class AccessMode {
+		ReadOnly,
+		CopyOnWrite
+	};
+
+	MemoryMappedFile();
+	MemoryMappedFile(MemoryMappedFile && file) noexcept;
+	MemoryMappedFile & operator = (MemoryMappedFile && file) noexcept;
+	~MemoryMappedFile();
+
+	bool isOpen() const;
+	bool open(const std::string & filePath, AccessMode accessMode = AccessMode::ReadOnly);
+	void close();
+
+	const std::string & getFilePath() const;
+	AccessMode getAccessMode() const;
+	const uint8_t * getData() const;
+	uint8_t * getWritableData();
+	size_t getSize() const;
+	std::string_view getContents() const;
+	bool isNullTerminated() const;
+
+private:
+	std::string m_filePath;
+	AccessMode m_accessMode;
+	uint8_t * m_data;
+	size_t m_size;
+	bool m_nullTerminated;
+	bool m_open;
+#if _WIN32
+	void * m_fileHandle;
+	void * m_mappingHandle;
+#endif // _WIN32
+
+	MemoryMappedFile(const MemoryMappedFile &) = delete;
+	const MemoryMappedFile & operator = (const MemoryMappedFile &) = delete;
+};
+
+#endif // _MEMORY_MAPPED_FILE_H_
@@ -0,0 +1,139 @@
+#include "ApplicationMetrics.h"
+
+#include "IO/AtomicFileWriter.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+static const std::string METRIC_NAME_PREFIX("namecheap_ddns_");
+
+Histogram ApplicationMetrics::ipAddressLookupDuration;
+Counter ApplicationMetrics::ipAddressLookupFailures;
+Histogram ApplicationMetrics::updateRequestDuration;
+Histogram ApplicationMetrics::updateRateLimitDelay;
+Counter ApplicationMetrics::successfulUpdates;
+Counter ApplicationMetrics::retryableUpdateFailures;
+Counter ApplicationMetrics::permanentUpdateFailures;
+Counter ApplicationMetrics::skippedUpdates;
+Histogram ApplicationMetrics::domainProfileLoadDuration;
+Histogram ApplicationMetrics::domainProfileParseDuration;
+Counter ApplicationMetrics::domainProfileLoadFailures;
+Counter ApplicationMetrics::settingsSaves;
+std::mutex ApplicationMetrics::s_lastSuccessfulUpdateMutex;
+std::map<std::string, std::chrono::time_point<std::chrono::system_clock>> ApplicationMetrics::s_lastSuccessfulUpdateTimestamps;
+
+const std::string ApplicationMetrics::PROMETHEUS_CONTENT_TYPE("text/plain; version=0.0.4; charset=utf-8");
+
+static std::string escapeLabelValue(std::string_view labelValue) {
+	std::string escapedLabelValue;
+	escapedLabelValue.reserve(labelValue.length());
+
+	for(char character : labelValue) {
+		switch(character) {
+			case '\\':
+				escapedLabelValue.append("\\\\");
+				break;
+			case '"':
+				escapedLabelValue.append("\\\"");
+				break;
+			case '\n':
+				escapedLabelValue.append("\\n");
+				break;
+			default:
+				escapedLabelValue.push_back(character);
+				break;
+		}
+	}
+
+	return escapedLabelValue;
+}
+
+static void appendMetricHeader(std::string & output, std::string_view name, std::string_view type, std::string_view help) {
+	output.append(fmt::format("# HELP {}{} {}\n# TYPE {}{} {}\n", METRIC_NAME_PREFIX, name, help, METRIC_NAME_PREFIX, name, type));
+}
+
+static void appendCounter(std::string & output, std::string_view name, std::string_view help, const Counter & counter) {
+	appendMetricHeader(output, name, "counter", help);
+	output.append(fmt::format("{}{} {}\n", METRIC_NAME_PREFIX, name, counter.getValue()));
+}
+
+static void appendHistogram(std::string & output, std::string_view name, std::string_view help, const Histogram & histogram) {
+	Histogram::Snapshot snapshot(histogram.getSnapshot());
+
+	appendMetricHeader(output, name, "histogram", help);
+
+	for(size_t i = 0; i < snapshot.bucketUpperBounds.size(); i++) {
+		output.append(fmt::format("{}{}_bucket{{le=\"{}\"}} {}\n", METRIC_NAME_PREFIX, name, snapshot.bucketUpperBounds[i], snapshot.cumulativeBucketCounts[i]));
+	}
+
+	output.append(fmt::format("{}{}_bucket{{le=\"+Inf\"}} {}\n", METRIC_NAME_PREFIX, name, snapshot.count));
+	output.append(fmt::format("{}{}_sum {}\n", METRIC_NAME_PREFIX, name, snapshot.sum));
+	output.append(fmt::format("{}{}_count {}\n", METRIC_NAME_PREFIX, name, snapshot.count));
+}
+
+void ApplicationMetrics::recordSuccessfulUpdate(std::string_view domain, std::chrono::time_point<std::chrono::system_clock> timestamp) {
+	std::lock_guard<std::mutex> lock(s_lastSuccessfulUpdateMutex);
+
+	std::chrono::time_point<std::chrono::system_clock> & lastSuccessfulUpdateTimestamp = s_lastSuccessfulUpdateTimestamps[Utilities::toLowerCase(std::string(domain))];
+	lastSuccessfulUpdateTimestamp = std::max(lastSuccessfulUpdateTimestamp, timestamp);
+}
+
+std::string ApplicationMetrics::toPrometheusText() {
+	std::string output;
+
+	appendHistogram(output, "ip_address_lookup_duration_seconds", "Time taken to determine the external IP address.", ipAddressLookupDuration);
+	appendCounter(output, "ip_address_lookup_failures_total", "External IP address lookups which did not produce an address.", ipAddressLookupFailures);
+	appendHistogram(output, "update_request_duration_seconds", "Time taken to update a single host, including retries and rate limiting.", updateRequestDuration);
+	appendHistogram(output, "update_rate_limit_delay_seconds", "Time update requests spent waiting for the rate limiter.", updateRateLimitDelay);
+
+	appendMetricHeader(output, "updates_total", "counter", "Host updates sent, by result.");
+	output.append(fmt::format("{}updates_total{{result=\"success\"}} {}\n", METRIC_NAME_PREFIX, successfulUpdates.getValue()));
+	output.append(fmt::format("{}updates_total{{result=\"retryable\"}} {}\n", METRIC_NAME_PREFIX, retryableUpdateFailures.getValue()));
+	output.append(fmt::format("{}updates_total{{result=\"permanent\"}} {}\n", METRIC_NAME_PREFIX, permanentUpdateFailures.getValue()));
+
+	appendCounter(output, "updates_skipped_total", "Host updates skipped because the host already points to the current IP address.", skippedUpdates);
+	appendHistogram(output, "domain_profile_load_duration_seconds", "Time taken to load a domain profile file, from a binary snapshot or JSON.", domainProfileLoadDuration);
+	appendHistogram(output, "domain_profile_parse_duration_seconds", "Time taken to parse the JSON document of a domain profile file.", domainProfileParseDuration);
+	appendCounter(output, "domain_profile_load_failures_total", "Domain profile files which failed to load.", domainProfileLoadFailures);
+	appendCounter(output, "settings_saves_total", "Writes of the settings file.", settingsSaves);
+
+	std::lock_guard<std::mutex> lock(s_lastSuccessfulUpdateMutex);
+
+	if(s_lastSuccessfulUpdateTimestamps.empty()) {
+		return output;
+	}
+
+	std::chrono::time_point<std::chrono::system_clock> currentTimestamp(std::chrono::system_clock::now());
+
+	appendMetricHeader(output, "last_successful_update_timestamp_seconds", "gauge", "Unix time of the last successful update, by domain.");
+
+	for(std::map<std::string, std::chrono::time_point<std::chrono::system_clock>>::const_iterator i = s_lastSuccessfulUpdateTimestamps.cbegin(); i != s_lastSuccessfulUpdateTimestamps.cend(); ++i) {
+		output.append(fmt::format("{}last_successful_update_timestamp_seconds{{domain=\"{}\"}} {}\n", METRIC_NAME_PREFIX, escapeLabelValue(i->first), std::chrono::duration_cast<std::chrono::seconds>(i->second.time_since_epoch()).count()));
+	}
+
+	appendMetricHeader(output, "seconds_since_last_successful_update", "gauge", "Time elapsed since the last successful update, by domain.");
+
+	for(std::map<std::string, std::chrono::time_point<std::chrono::system_clock>>::const_iterator i = s_lastSuccessfulUpdateTimestamps.cbegin(); i != s_lastSuccessfulUpdateTimestamps.cend(); ++i) {
+		output.append(fmt::format("{}seconds_since_last_successful_update{{domain=\"{}\"}} {}\n", METRIC_NAME_PREFIX, escapeLabelValue(i->first), std::chrono::duration_cast<std::chrono::seconds>(currentTimestamp - i->second).count()));
+	}
+
+	return output;
+}
+
+bool ApplicationMetrics::writeTextFile(const std::string & filePath) {
+	if(filePath.empty()) {
+		return false;
+	}
+
+	// the textfile collector may read at any moment, so it must never observe a partially written file
+	if(!AtomicFileWriter::writeTo(filePath, toPrometheusText())) {
+		spdlog::error("Failed to write metrics to file '{}'.", filePath);
+		return false;
+	}
+
+	return true;
+}
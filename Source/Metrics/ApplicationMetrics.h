@@ -0,0 +1,44 @@
+#ifndef _APPLICATION_METRICS_H_
+#define _APPLICATION_METRICS_H_
+
+#include "Counter.h"
+#include "Histogram.h"
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// process wide metrics, rendered in the Prometheus text exposition format for the loopback listener or a node exporter textfile collector,
+// counters and histograms are lock-free so they can be recorded from concurrent update and loading workers
+class ApplicationMetrics final {
+public:
+	static Histogram ipAddressLookupDuration;
+	static Counter ipAddressLookupFailures;
+	static Histogram updateRequestDuration;
+	static Histogram updateRateLimitDelay;
+	static Counter successfulUpdates;
+	static Counter retryableUpdateFailures;
+	static Counter permanentUpdateFailures;
+	static Counter skippedUpdates;
+	static Histogram domainProfileLoadDuration;
+	static Histogram domainProfileParseDuration;
+	static Counter domainProfileLoadFailures;
+	static Counter settingsSaves;
+
+	// takes a lock, so it should only be called once dispatched updates have completed rather than from the workers themselves
+	static void recordSuccessfulUpdate(std::string_view domain, std::chrono::time_point<std::chrono::system_clock> timestamp = std::chrono::system_clock::now());
+	static std::string toPrometheusText();
+	static bool writeTextFile(const std::string & filePath);
+
+	static const std::string PROMETHEUS_CONTENT_TYPE;
+
+private:
+	static std::mutex s_lastSuccessfulUpdateMutex;
+	static std::map<std::string, std::chrono::time_point<std::chrono::system_clock>> s_lastSuccessfulUpdateTimestamps;
+
+	ApplicationMetrics() = delete;
+};
+
+#endif // _APPLICATION_METRICS_H_
@@ -0,0 +1,18 @@
+#include "Counter.h"
+
+Counter::Counter()
+	: m_value(0) { }
+
+Counter::~Counter() = default;
+
+uint64_t Counter::getValue() const {
+	return m_value.load(std::memory_order_relaxed);
+}
+
+void Counter::increment(uint64_t amount) {
+	m_value.fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Counter::reset() {
+	m_value.store(0, std::memory_order_relaxed);
+}
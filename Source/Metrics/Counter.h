@@ -0,0 +1,24 @@
+#ifndef _COUNTER_H_
+#define _COUNTER_H_
+
+#include <atomic>
+#include <cstdint>
+
+// monotonically increasing metric which can be incremented from any thread without locking
+class Counter final {
+public:
+	Counter();
+	~Counter();
+
+	uint64_t getValue() const;
+	void increment(uint64_t amount = 1);
+	void reset();
+
+private:
+	std::atomic<uint64_t> m_value;
+
+	Counter(const Counter &) = delete;
+	const Counter & operator = (const Counter &) = delete;
+};
+
+#endif // _COUNTER_H_
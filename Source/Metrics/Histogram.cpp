@@ -0,0 +1,59 @@
+#include "Histogram.h"
+
+#include <algorithm>
+
+Histogram::Histogram(std::span<const double> bucketUpperBounds)
+	: m_bucketUpperBounds(bucketUpperBounds.begin(), bucketUpperBounds.end())
+	, m_bucketCounts(std::make_unique<std::atomic<uint64_t>[]>(bucketUpperBounds.size() + 1))
+	, m_count(0)
+	, m_sum(0.0) {
+	std::sort(m_bucketUpperBounds.begin(), m_bucketUpperBounds.end());
+
+	reset();
+}
+
+Histogram::~Histogram() = default;
+
+const std::vector<double> & Histogram::getBucketUpperBounds() const {
+	return m_bucketUpperBounds;
+}
+
+void Histogram::observe(double value) {
+	size_t bucketIndex = std::lower_bound(m_bucketUpperBounds.cbegin(), m_bucketUpperBounds.cend(), value) - m_bucketUpperBounds.cbegin();
+
+	m_bucketCounts[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+	m_sum.fetch_add(value, std::memory_order_relaxed);
+	m_count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Histogram::observeDuration(std::chrono::nanoseconds duration) {
+	observe(std::chrono::duration<double>(duration).count());
+}
+
+Histogram::Snapshot Histogram::getSnapshot() const {
+	Snapshot snapshot;
+	snapshot.bucketUpperBounds = m_bucketUpperBounds;
+	snapshot.cumulativeBucketCounts.reserve(m_bucketUpperBounds.size());
+
+	// buckets are read individually, so a snapshot taken during an observation may be off by that one observation
+	uint64_t cumulativeCount = 0;
+
+	for(size_t i = 0; i < m_bucketUpperBounds.size(); i++) {
+		cumulativeCount += m_bucketCounts[i].load(std::memory_order_relaxed);
+		snapshot.cumulativeBucketCounts.push_back(cumulativeCount);
+	}
+
+	snapshot.count = std::max(m_count.load(std::memory_order_relaxed), cumulativeCount);
+	snapshot.sum = m_sum.load(std::memory_order_relaxed);
+
+	return snapshot;
+}
+
+void Histogram::reset() {
+	for(size_t i = 0; i <= m_bucketUpperBounds.size(); i++) {
+		m_bucketCounts[i].store(0, std::memory_order_relaxed);
+	}
+
+	m_count.store(0, std::memory_order_relaxed);
+	m_sum.store(0.0, std::memory_order_relaxed);
+}
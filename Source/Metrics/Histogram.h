@@ -0,0 +1,48 @@
+#ifndef _HISTOGRAM_H_
+#define _HISTOGRAM_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+// distribution of observed values over fixed buckets, every observation is a handful of relaxed atomic operations
+// so concurrent threads can record into the same histogram without locking
+class Histogram final {
+public:
+	struct Snapshot {
+		std::vector<double> bucketUpperBounds;
+		// counts are cumulative, each bucket includes every observation less than or equal to its upper bound
+		std::vector<uint64_t> cumulativeBucketCounts;
+		uint64_t count = 0;
+		double sum = 0.0;
+	};
+
+	Histogram(std::span<const double> bucketUpperBounds = DEFAULT_DURATION_BUCKET_UPPER_BOUNDS);
+	~Histogram();
+
+	const std::vector<double> & getBucketUpperBounds() const;
+	void observe(double value);
+	void observeDuration(std::chrono::nanoseconds duration);
+	Snapshot getSnapshot() const;
+	void reset();
+
+	// in seconds, covering everything from a local file parse to a request which ran into its timeout,
+	// constant initialized so that histograms with static storage duration can safely use it
+	static constexpr std::array<double, 14> DEFAULT_DURATION_BUCKET_UPPER_BOUNDS{ { 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0 } };
+
+private:
+	std::vector<double> m_bucketUpperBounds;
+	// one count per bucket followed by the overflow bucket for values above the largest upper bound
+	std::unique_ptr<std::atomic<uint64_t>[]> m_bucketCounts;
+	std::atomic<uint64_t> m_count;
+	std::atomic<double> m_sum;
+
+	Histogram(const Histogram &) = delete;
+	const Histogram & operator = (const Histogram &) = delete;
+};
+
+#endif // _HISTOGRAM_H_
@@ -5,63 +5,232 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
+#include <cctype>
+#include <functional>
+#include <unordered_map>
+#include <utility>
 
 static constexpr const char * JSON_HOSTS_PROPERTY_NAME = "hosts";
 static constexpr const char * JSON_HOST_PROPERTY_NAME = "host";
 static constexpr const char * JSON_DOMAIN_PROPERTY_NAME = "domain";
 static constexpr const char * JSON_PASSWORD_PROPERTY_NAME = "password";
-static const std::array<std::string_view, 4> JSON_PROPERTY_NAMES({
+static constexpr const char * JSON_ADDRESS_FAMILY_PROPERTY_NAME = "addressFamily";
+static const std::array<std::string_view, 5> JSON_PROPERTY_NAMES({
 	JSON_HOSTS_PROPERTY_NAME,
 	JSON_HOST_PROPERTY_NAME,
 	JSON_DOMAIN_PROPERTY_NAME,
-	JSON_PASSWORD_PROPERTY_NAME
+	JSON_PASSWORD_PROPERTY_NAME,
+	JSON_ADDRESS_FAMILY_PROPERTY_NAME
+});
+static const std::array<std::string_view, 2> JSON_HOST_PROPERTY_NAMES({
+	JSON_HOST_PROPERTY_NAME,
+	JSON_ADDRESS_FAMILY_PROPERTY_NAME
 });
 
-NamecheapDomainProfile::NamecheapDomainProfile(std::vector<std::string> && hosts, std::string_view domain, std::string_view password)
-	: m_hosts(std::move(hosts))
-	, m_domain(domain)
-	, m_password(password)
+static constexpr const char * WHITESPACE_CHARACTERS = " \t\n\v\f\r";
+
+// returns a trimmed view into the JSON string value, so that the profile only copies each string once
+static std::string_view getTrimmedStringView(const rapidjson::Value & stringValue) {
+	std::string_view string(stringValue.GetString(), stringValue.GetStringLength());
+	size_t startIndex = string.find_first_not_of(WHITESPACE_CHARACTERS);
+
+	if(startIndex == std::string_view::npos) {
+		return {};
+	}
+
+	return string.substr(startIndex, string.find_last_not_of(WHITESPACE_CHARACTERS) - startIndex + 1);
+}
+
+// parses an optional address family property, leaving the address family unchanged when the property is not present
+static bool parseAddressFamilyProperty(const rapidjson::Value & value, NamecheapDomainProfile::AddressFamily & addressFamily) {
+	if(!value.HasMember(JSON_ADDRESS_FAMILY_PROPERTY_NAME)) {
+		return true;
+	}
+
+	const rapidjson::Value & addressFamilyValue = value[JSON_ADDRESS_FAMILY_PROPERTY_NAME];
+
+	if(!addressFamilyValue.IsString()) {
+		spdlog::error("Invalid Namecheap domain profile '{}' property type: '{}', expected: 'string'.", JSON_ADDRESS_FAMILY_PROPERTY_NAME, Utilities::typeToString(addressFamilyValue.GetType()));
+		return false;
+	}
+
+	std::optional<NamecheapDomainProfile::AddressFamily> optionalAddressFamily(NamecheapDomainProfile::parseAddressFamily(getTrimmedStringView(addressFamilyValue)));
+
+	if(!optionalAddressFamily.has_value()) {
+		spdlog::error("Invalid Namecheap domain profile '{}' property value: '{}', expected 'v4', 'v6' or 'both'.", JSON_ADDRESS_FAMILY_PROPERTY_NAME, addressFamilyValue.GetString());
+		return false;
+	}
+
+	addressFamily = optionalAddressFamily.value();
+
+	return true;
+}
+
+struct NamecheapDomainProfile::Storage {
+	// every string of the profile back to back, so that a profile costs a fixed number of allocations regardless of its number of hosts
+	std::string stringData;
+	std::vector<std::string_view> hosts;
+	std::vector<AddressFamily> hostAddressFamilies;
+};
+
+static std::vector<std::string_view> getHostViews(const std::vector<std::string> & hosts) {
+	return std::vector<std::string_view>(hosts.cbegin(), hosts.cend());
+}
+
+NamecheapDomainProfile::NamecheapDomainProfile(std::vector<std::string> && hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::vector<AddressFamily> && hostAddressFamilies)
+	: m_addressFamily(addressFamily)
+{
+	assignUniqueHosts(getHostViews(hosts), domain, password, addressFamily, hostAddressFamilies);
+}
+
+NamecheapDomainProfile::NamecheapDomainProfile(const std::vector<std::string> & hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, const std::vector<AddressFamily> & hostAddressFamilies)
+	: m_addressFamily(addressFamily)
+{
+	assignUniqueHosts(getHostViews(hosts), domain, password, addressFamily, hostAddressFamilies);
+}
+
+NamecheapDomainProfile::NamecheapDomainProfile(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const AddressFamily> hostAddressFamilies)
+	: m_addressFamily(addressFamily)
 {
+	assignUniqueHosts(hosts, domain, password, addressFamily, hostAddressFamilies);
 }
 
-NamecheapDomainProfile::NamecheapDomainProfile(const std::vector<std::string> & hosts, std::string_view domain, std::string_view password)
+NamecheapDomainProfile::NamecheapDomainProfile(std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const std::string_view> hosts, std::span<const AddressFamily> hostAddressFamilies)
 	: m_hosts(hosts)
 	, m_domain(domain)
 	, m_password(password)
-{
-}
+	, m_addressFamily(addressFamily)
+	, m_hostAddressFamilies(hostAddressFamilies) { }
 
 NamecheapDomainProfile::NamecheapDomainProfile(NamecheapDomainProfile && domainProfile) noexcept
-	: m_hosts(std::move(domainProfile.m_hosts))
-	, m_domain(std::move(domainProfile.m_domain))
-	, m_password(std::move(domainProfile.m_password)) { }
+	: m_hosts(std::exchange(domainProfile.m_hosts, {}))
+	, m_domain(std::exchange(domainProfile.m_domain, {}))
+	, m_password(std::exchange(domainProfile.m_password, {}))
+	, m_addressFamily(domainProfile.m_addressFamily)
+	, m_hostAddressFamilies(std::exchange(domainProfile.m_hostAddressFamilies, {}))
+	, m_storage(std::move(domainProfile.m_storage)) { }
 
 NamecheapDomainProfile::NamecheapDomainProfile(const NamecheapDomainProfile & domainProfile)
-	: m_hosts(domainProfile.m_hosts)
-	, m_domain(domainProfile.m_domain)
-	, m_password(domainProfile.m_password) { }
+	: m_addressFamily(domainProfile.m_addressFamily)
+{
+	assign(domainProfile.m_hosts, domainProfile.m_domain, domainProfile.m_password, domainProfile.m_addressFamily, domainProfile.m_hostAddressFamilies);
+}
 
 NamecheapDomainProfile & NamecheapDomainProfile::operator = (NamecheapDomainProfile && domainProfile) noexcept {
 	if(this != &domainProfile) {
-		m_hosts = std::move(domainProfile.m_hosts);
-		m_domain = std::move(domainProfile.m_domain);
-		m_password = std::move(domainProfile.m_password);
+		// the views remain valid since the storage they point into is moved rather than copied
+		m_hosts = std::exchange(domainProfile.m_hosts, {});
+		m_domain = std::exchange(domainProfile.m_domain, {});
+		m_password = std::exchange(domainProfile.m_password, {});
+		m_addressFamily = domainProfile.m_addressFamily;
+		m_hostAddressFamilies = std::exchange(domainProfile.m_hostAddressFamilies, {});
+		m_storage = std::move(domainProfile.m_storage);
 	}
 
 	return *this;
 }
 
 NamecheapDomainProfile & NamecheapDomainProfile::operator = (const NamecheapDomainProfile & domainProfile) {
-	m_hosts = domainProfile.m_hosts;
-	m_domain = domainProfile.m_domain;
-	m_password = domainProfile.m_password;
+	if(this != &domainProfile) {
+		assign(domainProfile.m_hosts, domainProfile.m_domain, domainProfile.m_password, domainProfile.m_addressFamily, domainProfile.m_hostAddressFamilies);
+	}
 
 	return *this;
 }
 
 NamecheapDomainProfile::~NamecheapDomainProfile() = default;
 
+void NamecheapDomainProfile::assign(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const AddressFamily> hostAddressFamilies) {
+	size_t stringDataSize = domain.size() + password.size();
+
+	for(const std::string_view host : hosts) {
+		stringDataSize += host.size();
+	}
+
+	// the new storage is filled before the current one is released, since the arguments may point into it
+	std::unique_ptr<Storage> storage(std::make_unique<Storage>());
+	storage->stringData.reserve(stringDataSize);
+	storage->hosts.reserve(hosts.size());
+
+	std::function<std::string_view(std::string_view)> addString([&storage](std::string_view string) {
+		size_t offset = storage->stringData.size();
+		storage->stringData.append(string);
+
+		return std::string_view(storage->stringData.data() + offset, string.size());
+	});
+
+	for(const std::string_view host : hosts) {
+		storage->hosts.push_back(addString(host));
+	}
+
+	m_domain = addString(domain);
+	m_password = addString(password);
+	storage->hostAddressFamilies.assign(hostAddressFamilies.begin(), hostAddressFamilies.end());
+	m_hosts = storage->hosts;
+	m_addressFamily = addressFamily;
+	m_hostAddressFamilies = storage->hostAddressFamilies;
+	m_storage = std::move(storage);
+}
+
+void NamecheapDomainProfile::assignUniqueHosts(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const AddressFamily> hostAddressFamilies) {
+	if(hosts.size() < 2) {
+		assign(hosts, domain, password, addressFamily, hostAddressFamilies);
+		return;
+	}
+
+	// maps each host to its index in the unique hosts, host names are case insensitive
+	std::unordered_map<std::string_view, size_t, HostHash, HostEqual> hostIndices;
+	hostIndices.reserve(hosts.size());
+	std::vector<std::string_view> uniqueHosts;
+	std::vector<AddressFamily> uniqueHostAddressFamilies;
+
+	for(size_t i = 0; i < hosts.size(); i++) {
+		std::pair<std::unordered_map<std::string_view, size_t, HostHash, HostEqual>::iterator, bool> hostIndex(hostIndices.emplace(hosts[i], uniqueHosts.size()));
+
+		if(hostIndex.second) {
+			uniqueHosts.push_back(hosts[i]);
+
+			if(!hostAddressFamilies.empty()) {
+				uniqueHostAddressFamilies.push_back(hostAddressFamilies[i]);
+			}
+
+			continue;
+		}
+
+		spdlog::warn("Namecheap domain profile for domain '{}' lists host '{}' more than once, ignoring duplicate host #{}.", domain, hosts[i], i + 1);
+
+		// a repeated host with a different address family override is updated for both address families
+		if(!hostAddressFamilies.empty()) {
+			uniqueHostAddressFamilies[hostIndex.first->second] = static_cast<AddressFamily>(static_cast<uint8_t>(uniqueHostAddressFamilies[hostIndex.first->second]) | static_cast<uint8_t>(hostAddressFamilies[i]));
+		}
+	}
+
+	if(uniqueHosts.size() == hosts.size()) {
+		assign(hosts, domain, password, addressFamily, hostAddressFamilies);
+		return;
+	}
+
+	assign(uniqueHosts, domain, password, addressFamily, uniqueHostAddressFamilies);
+}
+
+size_t NamecheapDomainProfile::HostHash::operator () (std::string_view host) const {
+	// FNV-1a over the case folded host, so that lookups match the case insensitive equality
+	size_t hash = static_cast<size_t>(14695981039346656037ULL);
+
+	for(char character : host) {
+		hash ^= static_cast<size_t>(std::tolower(static_cast<unsigned char>(character)));
+		hash *= static_cast<size_t>(1099511628211ULL);
+	}
+
+	return hash;
+}
+
+bool NamecheapDomainProfile::HostEqual::operator () (std::string_view hostA, std::string_view hostB) const {
+	return Utilities::areStringsEqualIgnoreCase(hostA, hostB);
+}
+
 size_t NamecheapDomainProfile::numberOfHosts() const {
 	return m_hosts.size();
 }
@@ -71,60 +240,141 @@ bool NamecheapDomainProfile::hasHost(std::string_view host) const {
 }
 
 size_t NamecheapDomainProfile::indexOfHost(std::string_view host) const {
-	std::vector<std::string>::const_iterator hostIterator(std::find(m_hosts.cbegin(), m_hosts.cend(), host));
+	std::span<const std::string_view>::iterator hostIterator(std::find(m_hosts.begin(), m_hosts.end(), host));
 
-	if(hostIterator == m_hosts.cend()) {
+	if(hostIterator == m_hosts.end()) {
 		return std::numeric_limits<size_t>::max();
 	}
 
-	return hostIterator - m_hosts.cbegin();
+	return hostIterator - m_hosts.begin();
 }
 
-const std::string & NamecheapDomainProfile::getHost(size_t index) const {
+std::string_view NamecheapDomainProfile::getHost(size_t index) const {
 	if(index >= m_hosts.size()) {
-		return Utilities::emptyString;
+		return {};
 	}
 
 	return m_hosts[index];
 }
 
-const std::vector<std::string> NamecheapDomainProfile::getHosts() const {
+std::span<const std::string_view> NamecheapDomainProfile::getHosts() const {
 	return m_hosts;
 }
 
-const std::string & NamecheapDomainProfile::getDomain() const {
+std::string_view NamecheapDomainProfile::getDomain() const {
 	return m_domain;
 }
 
-const std::string & NamecheapDomainProfile::getPassword() const {
+std::string_view NamecheapDomainProfile::getPassword() const {
 	return m_password;
 }
 
+NamecheapDomainProfile::AddressFamily NamecheapDomainProfile::getAddressFamily() const {
+	return m_addressFamily;
+}
+
+NamecheapDomainProfile::AddressFamily NamecheapDomainProfile::getHostAddressFamily(size_t index) const {
+	if(index >= m_hostAddressFamilies.size()) {
+		return m_addressFamily;
+	}
+
+	return m_hostAddressFamilies[index];
+}
+
+bool NamecheapDomainProfile::usesAddressFamily(AddressFamily addressFamily) const {
+	for(size_t i = 0; i < m_hosts.size(); i++) {
+		if(includesAddressFamily(getHostAddressFamily(i), addressFamily)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool NamecheapDomainProfile::isArenaView() const {
+	return m_storage == nullptr;
+}
+
+bool NamecheapDomainProfile::includesAddressFamily(AddressFamily addressFamily, AddressFamily includedAddressFamily) {
+	return (static_cast<uint8_t>(addressFamily) & static_cast<uint8_t>(includedAddressFamily)) == static_cast<uint8_t>(includedAddressFamily);
+}
+
+std::string_view NamecheapDomainProfile::addressFamilyToString(AddressFamily addressFamily) {
+	switch(addressFamily) {
+		case AddressFamily::IPv4:
+			return "v4";
+		case AddressFamily::IPv6:
+			return "v6";
+		case AddressFamily::Both:
+			return "both";
+	}
+
+	return {};
+}
+
+std::optional<NamecheapDomainProfile::AddressFamily> NamecheapDomainProfile::parseAddressFamily(std::string_view addressFamily) {
+	if(Utilities::areStringsEqualIgnoreCase(addressFamily, "v4") || Utilities::areStringsEqualIgnoreCase(addressFamily, "ipv4")) {
+		return AddressFamily::IPv4;
+	}
+	else if(Utilities::areStringsEqualIgnoreCase(addressFamily, "v6") || Utilities::areStringsEqualIgnoreCase(addressFamily, "ipv6")) {
+		return AddressFamily::IPv6;
+	}
+	else if(Utilities::areStringsEqualIgnoreCase(addressFamily, "both")) {
+		return AddressFamily::Both;
+	}
+
+	return {};
+}
+
 rapidjson::Value NamecheapDomainProfile::toJSON(rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & allocator) const {
 	rapidjson::Value domainProfileValue(rapidjson::kObjectType);
 
-	if(m_hosts.size() == 1) {
-		rapidjson::Value hostValue(m_hosts.front().c_str(), allocator);
+	bool hostAddressFamiliesDiffer = false;
+
+	for(size_t i = 0; i < m_hostAddressFamilies.size(); i++) {
+		if(m_hostAddressFamilies[i] != m_addressFamily) {
+			hostAddressFamiliesDiffer = true;
+			break;
+		}
+	}
+
+	if(m_hosts.size() == 1 && !hostAddressFamiliesDiffer) {
+		rapidjson::Value hostValue(m_hosts.front().data(), static_cast<rapidjson::SizeType>(m_hosts.front().size()), allocator);
 		domainProfileValue.AddMember(rapidjson::StringRef(JSON_HOST_PROPERTY_NAME), hostValue, allocator);
 	}
 	else {
 		rapidjson::Value hostsValue(rapidjson::kArrayType);
 		hostsValue.Reserve(m_hosts.size(), allocator);
 
-		for(const std::string & host : m_hosts) {
-			rapidjson::Value hostValue(host.c_str(), allocator);
-			hostsValue.PushBack(hostValue, allocator);
+		for(size_t i = 0; i < m_hosts.size(); i++) {
+			rapidjson::Value hostValue(m_hosts[i].data(), static_cast<rapidjson::SizeType>(m_hosts[i].size()), allocator);
+			AddressFamily hostAddressFamily = getHostAddressFamily(i);
+
+			// hosts which differ from the profile address family are written as objects
+			if(hostAddressFamily != m_addressFamily) {
+				rapidjson::Value hostObjectValue(rapidjson::kObjectType);
+				hostObjectValue.AddMember(rapidjson::StringRef(JSON_HOST_PROPERTY_NAME), hostValue, allocator);
+				hostObjectValue.AddMember(rapidjson::StringRef(JSON_ADDRESS_FAMILY_PROPERTY_NAME), rapidjson::StringRef(addressFamilyToString(hostAddressFamily).data()), allocator);
+				hostsValue.PushBack(hostObjectValue, allocator);
+			}
+			else {
+				hostsValue.PushBack(hostValue, allocator);
+			}
 		}
 
 		domainProfileValue.AddMember(rapidjson::StringRef(JSON_HOSTS_PROPERTY_NAME), hostsValue, allocator);
 	}
 
-	rapidjson::Value domainValue(m_domain.c_str(), allocator);
+	rapidjson::Value domainValue(m_domain.data(), static_cast<rapidjson::SizeType>(m_domain.size()), allocator);
 	domainProfileValue.AddMember(rapidjson::StringRef(JSON_DOMAIN_PROPERTY_NAME), domainValue, allocator);
 
-	rapidjson::Value passwordValue(m_password.c_str(), allocator);
+	rapidjson::Value passwordValue(m_password.data(), static_cast<rapidjson::SizeType>(m_password.size()), allocator);
 	domainProfileValue.AddMember(rapidjson::StringRef(JSON_PASSWORD_PROPERTY_NAME), passwordValue, allocator);
 
+	if(m_addressFamily != AddressFamily::IPv4) {
+		domainProfileValue.AddMember(rapidjson::StringRef(JSON_ADDRESS_FAMILY_PROPERTY_NAME), rapidjson::StringRef(addressFamilyToString(m_addressFamily).data()), allocator);
+	}
+
 	return domainProfileValue;
 }
 
@@ -152,8 +402,9 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 		}
 	}
 
-	// parse domain profile host(s)
-	std::vector<std::string> hosts;
+	// parse domain profile host(s), the views point into the JSON document which outlives the profile construction
+	std::vector<std::string_view> hosts;
+	std::vector<std::pair<size_t, AddressFamily>> hostAddressFamilyOverrides;
 
 	if(domainProfileValue.HasMember(JSON_HOST_PROPERTY_NAME)) {
 		const rapidjson::Value & hostValue = domainProfileValue[JSON_HOST_PROPERTY_NAME];
@@ -163,7 +414,7 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 			return nullptr;
 		}
 
-		hosts.emplace_back(Utilities::trimString(hostValue.GetString()));
+		hosts.emplace_back(getTrimmedStringView(hostValue));
 	}
 	else if(domainProfileValue.HasMember(JSON_HOSTS_PROPERTY_NAME)) {
 		const rapidjson::Value & hostsValue = domainProfileValue[JSON_HOSTS_PROPERTY_NAME];
@@ -173,15 +424,41 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 			return nullptr;
 		}
 
+		hosts.reserve(hostsValue.Size());
+
 		for(rapidjson::Value::ConstValueIterator i = hostsValue.Begin(); i != hostsValue.End(); ++i) {
 			const rapidjson::Value & hostValue = *i;
 
-			if(!hostValue.IsString()) {
-				spdlog::error("Invalid Namecheap domain profile host #{} property type: '{}', expected: 'string'.", hosts.size() + 1, Utilities::typeToString(hostValue.GetType()));
+			if(hostValue.IsString()) {
+				hosts.emplace_back(getTrimmedStringView(hostValue));
+				continue;
+			}
+
+			// hosts can also be objects which override the profile address family
+			if(!hostValue.IsObject() || !hostValue.HasMember(JSON_HOST_PROPERTY_NAME) || !hostValue[JSON_HOST_PROPERTY_NAME].IsString()) {
+				spdlog::error("Invalid Namecheap domain profile host #{} property type: '{}', expected: 'string' or 'object' with a '{}' string property.", hosts.size() + 1, Utilities::typeToString(hostValue.GetType()), JSON_HOST_PROPERTY_NAME);
+				return nullptr;
+			}
+
+			for(rapidjson::Value::ConstMemberIterator j = hostValue.MemberBegin(); j != hostValue.MemberEnd(); ++j) {
+				if(std::find(JSON_HOST_PROPERTY_NAMES.cbegin(), JSON_HOST_PROPERTY_NAMES.cend(), std::string_view(j->name.GetString())) == JSON_HOST_PROPERTY_NAMES.cend()) {
+					spdlog::warn("Namecheap domain profile host #{} has unexpected property '{}'.", hosts.size() + 1, j->name.GetString());
+				}
+			}
+
+			AddressFamily hostAddressFamily = AddressFamily::IPv4;
+
+			if(!hostValue.HasMember(JSON_ADDRESS_FAMILY_PROPERTY_NAME)) {
+				hosts.emplace_back(getTrimmedStringView(hostValue[JSON_HOST_PROPERTY_NAME]));
+				continue;
+			}
+
+			if(!parseAddressFamilyProperty(hostValue, hostAddressFamily)) {
 				return nullptr;
 			}
 
-			hosts.emplace_back(Utilities::trimString(hostValue.GetString()));
+			hostAddressFamilyOverrides.emplace_back(hosts.size(), hostAddressFamily);
+			hosts.emplace_back(getTrimmedStringView(hostValue[JSON_HOST_PROPERTY_NAME]));
 		}
 	}
 	else {
@@ -194,7 +471,7 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 		return nullptr;
 	}
 
-	for(const std::string & host : hosts) {
+	for(const std::string_view host : hosts) {
 		if(host.empty()) {
 			spdlog::error("Namecheap domain profile host #{} is empty, expected non-empty string.");
 			return nullptr;
@@ -202,7 +479,7 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 	}
 
 	// parse domain profile domain
-	std::string domain;
+	std::string_view domain;
 
 	if(domainProfileValue.HasMember(JSON_DOMAIN_PROPERTY_NAME)) {
 		const rapidjson::Value & domainValue = domainProfileValue[JSON_DOMAIN_PROPERTY_NAME];
@@ -212,7 +489,7 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 			return nullptr;
 		}
 
-		domain = Utilities::trimString(domainValue.GetString());
+		domain = getTrimmedStringView(domainValue);
 	}
 	else {
 		spdlog::error("Namecheap domain profile is missing '{}' property.", JSON_DOMAIN_PROPERTY_NAME);
@@ -220,7 +497,7 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 	}
 
 	// parse domain profile password
-	std::string password;
+	std::string_view password;
 
 	if(domainProfileValue.HasMember(JSON_PASSWORD_PROPERTY_NAME)) {
 		const rapidjson::Value & passwordValue = domainProfileValue[JSON_PASSWORD_PROPERTY_NAME];
@@ -230,14 +507,31 @@ std::unique_ptr<NamecheapDomainProfile> NamecheapDomainProfile::parseFrom(const
 			return nullptr;
 		}
 
-		password = Utilities::trimString(passwordValue.GetString());
+		password = getTrimmedStringView(passwordValue);
 	}
 	else {
 		spdlog::error("Namecheap domain profile is missing '{}' property.", JSON_PASSWORD_PROPERTY_NAME);
 		return nullptr;
 	}
 
-	return std::make_unique<NamecheapDomainProfile>(std::move(hosts), std::move(domain), std::move(password));
+	// parse domain profile address family
+	AddressFamily addressFamily = AddressFamily::IPv4;
+
+	if(!parseAddressFamilyProperty(domainProfileValue, addressFamily)) {
+		return nullptr;
+	}
+
+	std::vector<AddressFamily> hostAddressFamilies;
+
+	if(!hostAddressFamilyOverrides.empty()) {
+		hostAddressFamilies.resize(hosts.size(), addressFamily);
+
+		for(const std::pair<size_t, AddressFamily> & hostAddressFamilyOverride : hostAddressFamilyOverrides) {
+			hostAddressFamilies[hostAddressFamilyOverride.first] = hostAddressFamilyOverride.second;
+		}
+	}
+
+	return std::make_unique<NamecheapDomainProfile>(std::span<const std::string_view>(hosts), domain, password, addressFamily, std::span<const AddressFamily>(hostAddressFamilies));
 }
 
 std::vector<std::unique_ptr<NamecheapDomainProfile>> parseFromList(const rapidjson::Value & domainProfileListValue) {
@@ -266,7 +560,7 @@ std::vector<std::unique_ptr<NamecheapDomainProfile>> parseFromList(const rapidjs
 }
 
 bool NamecheapDomainProfile::isValid() const {
-	for(const std::string & host : m_hosts) {
+	for(const std::string_view host : m_hosts) {
 		if(host.empty()) {
 			return false;
 		}
@@ -274,7 +568,8 @@ bool NamecheapDomainProfile::isValid() const {
 
 	return !m_hosts.empty() &&
 		   !m_domain.empty() &&
-		   !m_password.empty();
+		   !m_password.empty() &&
+		   (m_hostAddressFamilies.empty() || m_hostAddressFamilies.size() == m_hosts.size());
 }
 
 bool NamecheapDomainProfile::isValid(const NamecheapDomainProfile * domainProfile) {
@@ -288,12 +583,14 @@ bool NamecheapDomainProfile::operator == (const NamecheapDomainProfile & domainP
 	}
 
 	for(size_t i = 0; i < m_hosts.size(); i++) {
-		if(!Utilities::areStringsEqual(m_hosts[i], domainProfile.m_hosts[i])) {
+		if(!Utilities::areStringsEqual(m_hosts[i], domainProfile.m_hosts[i]) ||
+		   getHostAddressFamily(i) != domainProfile.getHostAddressFamily(i)) {
 			return false;
 		}
 	}
 
-	return Utilities::areStringsEqual(m_domain, domainProfile.m_domain) &&
+	return m_addressFamily == domainProfile.m_addressFamily &&
+		   Utilities::areStringsEqual(m_domain, domainProfile.m_domain) &&
 		   Utilities::areStringsEqual(m_password, domainProfile.m_password);
 }
 
@@ -3,15 +3,32 @@
 
 #include <rapidjson/document.h>
 
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+class NamecheapDomainProfileArena;
+
+// hosts, domain and password are views into storage owned by the profile, or into a shared domain profile arena when the profile was packed into one,
+// copying a profile out of an arena always gives it storage of its own
 class NamecheapDomainProfile final {
+	friend class NamecheapDomainProfileArena;
+
 public:
-	NamecheapDomainProfile(std::vector<std::string> && hosts, std::string_view domain, std::string_view password);
-	NamecheapDomainProfile(const std::vector<std::string> & hosts, std::string_view domain, std::string_view password);
+	enum class AddressFamily : uint8_t {
+		IPv4 = 1,
+		IPv6 = 2,
+		Both = IPv4 | IPv6
+	};
+
+	// host address families are optional, when empty every host uses the profile address family
+	NamecheapDomainProfile(std::vector<std::string> && hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily = AddressFamily::IPv4, std::vector<AddressFamily> && hostAddressFamilies = {});
+	NamecheapDomainProfile(const std::vector<std::string> & hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily = AddressFamily::IPv4, const std::vector<AddressFamily> & hostAddressFamilies = {});
+	NamecheapDomainProfile(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily = AddressFamily::IPv4, std::span<const AddressFamily> hostAddressFamilies = {});
 	NamecheapDomainProfile(NamecheapDomainProfile && domainProfile) noexcept;
 	NamecheapDomainProfile(const NamecheapDomainProfile & domainProfile);
 	NamecheapDomainProfile & operator = (NamecheapDomainProfile && domainProfile) noexcept;
@@ -21,10 +38,18 @@ public:
 	size_t numberOfHosts() const;
 	bool hasHost(std::string_view host) const;
 	size_t indexOfHost(std::string_view host) const;
-	const std::string & getHost(size_t index) const;
-	const std::vector<std::string> getHosts() const;
-	const std::string & getDomain() const;
-	const std::string & getPassword() const;
+	std::string_view getHost(size_t index) const;
+	std::span<const std::string_view> getHosts() const;
+	std::string_view getDomain() const;
+	std::string_view getPassword() const;
+	AddressFamily getAddressFamily() const;
+	AddressFamily getHostAddressFamily(size_t index) const;
+	bool usesAddressFamily(AddressFamily addressFamily) const;
+	bool isArenaView() const;
+
+	static bool includesAddressFamily(AddressFamily addressFamily, AddressFamily includedAddressFamily);
+	static std::string_view addressFamilyToString(AddressFamily addressFamily);
+	static std::optional<AddressFamily> parseAddressFamily(std::string_view addressFamily);
 
 	rapidjson::Value toJSON(rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & allocator) const;
 	static std::unique_ptr<NamecheapDomainProfile> parseFrom(const rapidjson::Value & domainProfileValue);
@@ -37,9 +62,30 @@ public:
 	bool operator != (const NamecheapDomainProfile & domainProfile) const;
 
 private:
-	std::vector<std::string> m_hosts;
-	std::string m_domain;
-	std::string m_password;
+	struct Storage;
+
+	struct HostHash {
+		size_t operator () (std::string_view host) const;
+	};
+
+	struct HostEqual {
+		bool operator () (std::string_view hostA, std::string_view hostB) const;
+	};
+
+	// only used by domain profile arenas, the profile references the given strings without copying them
+	NamecheapDomainProfile(std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const std::string_view> hosts, std::span<const AddressFamily> hostAddressFamilies);
+
+	void assign(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const AddressFamily> hostAddressFamilies);
+	// hosts repeated within the profile are dropped, so that each host is only updated once per cycle
+	void assignUniqueHosts(std::span<const std::string_view> hosts, std::string_view domain, std::string_view password, AddressFamily addressFamily, std::span<const AddressFamily> hostAddressFamilies);
+
+	std::span<const std::string_view> m_hosts;
+	std::string_view m_domain;
+	std::string_view m_password;
+	AddressFamily m_addressFamily;
+	std::span<const AddressFamily> m_hostAddressFamilies;
+	// null when the profile is a view into a domain profile arena
+	std::unique_ptr<Storage> m_storage;
 };
 
 #endif // _NAMECHEAP_DOMAIN_PROFILE_H_
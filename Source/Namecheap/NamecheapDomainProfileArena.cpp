@@ -0,0 +1,103 @@
+#include "NamecheapDomainProfileArena.h"
+
+#include <functional>
+#include <span>
+
+NamecheapDomainProfileArena::NamecheapDomainProfileArena(const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfiles) {
+	size_t stringDataSize = 0;
+	size_t numberOfHosts = 0;
+	size_t numberOfHostAddressFamilies = 0;
+	size_t numberOfDomainProfiles = 0;
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfiles) {
+		if(domainProfile == nullptr) {
+			continue;
+		}
+
+		stringDataSize += domainProfile->m_domain.size() + domainProfile->m_password.size();
+
+		for(const std::string_view host : domainProfile->m_hosts) {
+			stringDataSize += host.size();
+		}
+
+		numberOfHosts += domainProfile->m_hosts.size();
+		numberOfHostAddressFamilies += domainProfile->m_hostAddressFamilies.size();
+		numberOfDomainProfiles++;
+	}
+
+	// everything is reserved up front, since the views handed to the profiles must never be invalidated by a reallocation
+	m_stringData.reserve(stringDataSize);
+	m_hosts.reserve(numberOfHosts);
+	m_hostAddressFamilies.reserve(numberOfHostAddressFamilies);
+	m_domainProfiles.reserve(numberOfDomainProfiles);
+
+	std::function<std::string_view(std::string_view)> addString([this](std::string_view string) {
+		size_t offset = m_stringData.size();
+		m_stringData.append(string);
+
+		return std::string_view(m_stringData.data() + offset, string.size());
+	});
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfiles) {
+		if(domainProfile == nullptr) {
+			continue;
+		}
+
+		size_t firstHostIndex = m_hosts.size();
+		size_t firstHostAddressFamilyIndex = m_hostAddressFamilies.size();
+
+		for(const std::string_view host : domainProfile->m_hosts) {
+			m_hosts.push_back(addString(host));
+		}
+
+		m_hostAddressFamilies.insert(m_hostAddressFamilies.end(), domainProfile->m_hostAddressFamilies.begin(), domainProfile->m_hostAddressFamilies.end());
+
+		std::string_view domain(addString(domainProfile->m_domain));
+		std::string_view password(addString(domainProfile->m_password));
+
+		m_domainProfiles.push_back(NamecheapDomainProfile(
+			domain,
+			password,
+			domainProfile->m_addressFamily,
+			std::span<const std::string_view>(m_hosts.data() + firstHostIndex, domainProfile->m_hosts.size()),
+			std::span<const NamecheapDomainProfile::AddressFamily>(m_hostAddressFamilies.data() + firstHostAddressFamilyIndex, domainProfile->m_hostAddressFamilies.size())
+		));
+	}
+}
+
+NamecheapDomainProfileArena::~NamecheapDomainProfileArena() = default;
+
+size_t NamecheapDomainProfileArena::numberOfDomainProfiles() const {
+	return m_domainProfiles.size();
+}
+
+size_t NamecheapDomainProfileArena::numberOfHosts() const {
+	return m_hosts.size();
+}
+
+size_t NamecheapDomainProfileArena::getStringDataSize() const {
+	return m_stringData.size();
+}
+
+const NamecheapDomainProfile * NamecheapDomainProfileArena::getDomainProfile(size_t index) const {
+	if(index >= m_domainProfiles.size()) {
+		return nullptr;
+	}
+
+	return &m_domainProfiles[index];
+}
+
+std::vector<std::shared_ptr<NamecheapDomainProfile>> NamecheapDomainProfileArena::getDomainProfiles(const std::shared_ptr<NamecheapDomainProfileArena> & arena) {
+	if(arena == nullptr) {
+		return {};
+	}
+
+	std::vector<std::shared_ptr<NamecheapDomainProfile>> domainProfiles;
+	domainProfiles.reserve(arena->m_domainProfiles.size());
+
+	for(NamecheapDomainProfile & domainProfile : arena->m_domainProfiles) {
+		domainProfiles.emplace_back(arena, &domainProfile);
+	}
+
+	return domainProfiles;
+}
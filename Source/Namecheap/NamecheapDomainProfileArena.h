@@ -0,0 +1,36 @@
+#ifndef _NAMECHEAP_DOMAIN_PROFILE_ARENA_H_
+#define _NAMECHEAP_DOMAIN_PROFILE_ARENA_H_
+
+#include "NamecheapDomainProfile.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// packs a set of domain profiles into a handful of contiguous allocations: one buffer holding every host, domain and password,
+// one table of host views into it and the profiles themselves, which are views into both, so walking tens of thousands of profiles stays cache friendly
+class NamecheapDomainProfileArena final {
+public:
+	NamecheapDomainProfileArena(const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfiles);
+	~NamecheapDomainProfileArena();
+
+	size_t numberOfDomainProfiles() const;
+	size_t numberOfHosts() const;
+	size_t getStringDataSize() const;
+	const NamecheapDomainProfile * getDomainProfile(size_t index) const;
+
+	// the returned profiles share ownership of the arena rather than each having a control block of their own, so it lives for as long as any of them
+	static std::vector<std::shared_ptr<NamecheapDomainProfile>> getDomainProfiles(const std::shared_ptr<NamecheapDomainProfileArena> & arena);
+
+private:
+	std::string m_stringData;
+	std::vector<std::string_view> m_hosts;
+	std::vector<NamecheapDomainProfile::AddressFamily> m_hostAddressFamilies;
+	std::vector<NamecheapDomainProfile> m_domainProfiles;
+
+	NamecheapDomainProfileArena(const NamecheapDomainProfileArena &) = delete;
+	const NamecheapDomainProfileArena & operator = (const NamecheapDomainProfileArena &) = delete;
+};
+
+#endif // _NAMECHEAP_DOMAIN_PROFILE_ARENA_H_
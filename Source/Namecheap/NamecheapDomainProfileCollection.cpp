@@ -1,17 +1,25 @@
 #include "NamecheapDomainProfileCollection.h"
 
+#include "NamecheapDomainProfileArena.h"
+#include "NamecheapDomainProfileCollectionReader.h"
+
+#include "IO/AtomicFileWriter.h"
+#include "IO/MemoryMappedFile.h"
+#include "Metrics/ApplicationMetrics.h"
+
 #include <Utilities/FileUtilities.h>
 #include <Utilities/RapidJSONUtilities.h>
 #include <Utilities/StringUtilities.h>
 
-#include <rapidjson/istreamwrapper.h>
-#include <rapidjson/ostreamwrapper.h>
-#include <rapidjson/prettywriter.h>
 #include <spdlog/spdlog.h>
 
 #include <array>
+#include <cctype>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_set>
 
 static constexpr const char * JSON_FILE_TYPE_PROPERTY_NAME = "fileType";
 static constexpr const char * JSON_FILE_FORMAT_VERSION_PROPERTY_NAME = "fileFormatVersion";
@@ -26,26 +34,112 @@ static const std::array<std::string_view, 4> JSON_PROPERTY_NAMES({
 
 const std::string NamecheapDomainProfileCollection::FILE_TYPE = "Namecheap Domain Profile";
 const uint32_t NamecheapDomainProfileCollection::FILE_FORMAT_VERSION = 1;
+const std::string NamecheapDomainProfileCollection::BINARY_SNAPSHOT_FILE_EXTENSION("snapshot");
+
+static constexpr std::array<char, 8> BINARY_SNAPSHOT_MAGIC({ 'N', 'C', 'D', 'P', 'S', 'N', 'A', 'P' });
+static constexpr uint32_t BINARY_SNAPSHOT_BYTE_ORDER_MARKER = 0x01020304;
+// versioned separately from the JSON file format, snapshots from an older version are simply regenerated
+static constexpr uint32_t BINARY_SNAPSHOT_FORMAT_VERSION = 2;
+
+// binary snapshots are laid out as a header, followed by fixed size profile records, fixed size host records and a string table that all offsets point into
+struct BinarySnapshotHeader {
+	std::array<char, 8> magic;
+	uint32_t fileFormatVersion;
+	uint32_t byteOrderMarker;
+	uint64_t sourceFileSize;
+	int64_t sourceLastWriteTime;
+	uint32_t numberOfDomainProfiles;
+	uint32_t numberOfHosts;
+	uint32_t stringTableSize;
+	uint32_t checksum;
+};
+
+struct BinarySnapshotDomainProfileRecord {
+	uint32_t domainOffset;
+	uint32_t domainLength;
+	uint32_t passwordOffset;
+	uint32_t passwordLength;
+	uint32_t firstHostIndex;
+	uint32_t numberOfHosts;
+	uint32_t addressFamily;
+};
+
+struct BinarySnapshotStringRecord {
+	uint32_t offset;
+	uint32_t length;
+};
+
+struct BinarySnapshotHostRecord {
+	uint32_t offset;
+	uint32_t length;
+	uint32_t addressFamily;
+};
+
+static_assert(sizeof(BinarySnapshotHeader) == 48, "Unexpected binary snapshot header size.");
+static_assert(sizeof(BinarySnapshotDomainProfileRecord) == 28, "Unexpected binary snapshot domain profile record size.");
+static_assert(sizeof(BinarySnapshotHostRecord) == 12, "Unexpected binary snapshot host record size.");
+
+static bool isBinarySnapshotAddressFamilyValid(uint32_t addressFamily) {
+	return addressFamily == static_cast<uint32_t>(NamecheapDomainProfile::AddressFamily::IPv4) ||
+		   addressFamily == static_cast<uint32_t>(NamecheapDomainProfile::AddressFamily::IPv6) ||
+		   addressFamily == static_cast<uint32_t>(NamecheapDomainProfile::AddressFamily::Both);
+}
+
+static uint32_t calculateBinarySnapshotChecksum(const uint8_t * data, size_t size, uint32_t checksum = 2166136261u) {
+	for(size_t i = 0; i < size; i++) {
+		checksum ^= data[i];
+		checksum *= 16777619u;
+	}
+
+	return checksum;
+}
+
+static bool getSourceFileInformation(const std::string & sourceFilePath, uint64_t & sourceFileSize, int64_t & sourceLastWriteTime) {
+	std::error_code errorCode;
+	std::filesystem::path sourcePath(sourceFilePath);
+
+	sourceFileSize = static_cast<uint64_t>(std::filesystem::file_size(sourcePath, errorCode));
+
+	if(errorCode) {
+		return false;
+	}
+
+	sourceLastWriteTime = static_cast<int64_t>(std::filesystem::last_write_time(sourcePath, errorCode).time_since_epoch().count());
+
+	return !errorCode;
+}
+
+static std::atomic<uint64_t> nextRevision(1);
 
-NamecheapDomainProfileCollection::NamecheapDomainProfileCollection() { }
+NamecheapDomainProfileCollection::NamecheapDomainProfileCollection()
+	: m_revision(nextRevision++) { }
 
 NamecheapDomainProfileCollection::NamecheapDomainProfileCollection(std::vector<std::shared_ptr<NamecheapDomainProfile>> && domainProfiles)
 	: m_domainProfiles(std::move(domainProfiles))
+	, m_revision(nextRevision++)
 {
+	rebuildDomainProfileIndex();
 }
 
 NamecheapDomainProfileCollection::NamecheapDomainProfileCollection(const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfiles)
 	: m_domainProfiles(domainProfiles)
+	, m_revision(nextRevision++)
 {
+	rebuildDomainProfileIndex();
 }
 
 NamecheapDomainProfileCollection::NamecheapDomainProfileCollection(NamecheapDomainProfileCollection && domainProfiles) noexcept
 	: m_domainProfiles(std::move(domainProfiles.m_domainProfiles))
+	, m_domainProfileIndices(std::move(domainProfiles.m_domainProfileIndices))
+	, m_revision(nextRevision++)
 {
+	domainProfiles.updateRevision();
 }
 
 NamecheapDomainProfileCollection::NamecheapDomainProfileCollection(const NamecheapDomainProfileCollection & domainProfiles)
 	: m_domainProfiles(domainProfiles.m_domainProfiles)
+	, m_domainProfileIndices(domainProfiles.m_domainProfileIndices)
+	, m_revision(nextRevision++)
 {
 }
 
@@ -53,6 +147,9 @@ NamecheapDomainProfileCollection & NamecheapDomainProfileCollection::operator =
 {
 	if(this != &domainProfiles) {
 		m_domainProfiles = std::move(domainProfiles.m_domainProfiles);
+		m_domainProfileIndices = std::move(domainProfiles.m_domainProfileIndices);
+		updateRevision();
+		domainProfiles.updateRevision();
 	}
 
 	return *this;
@@ -61,16 +158,55 @@ NamecheapDomainProfileCollection & NamecheapDomainProfileCollection::operator =
 NamecheapDomainProfileCollection & NamecheapDomainProfileCollection::operator = (const NamecheapDomainProfileCollection & domainProfiles)
 {
 	m_domainProfiles = domainProfiles.m_domainProfiles;
+	m_domainProfileIndices = domainProfiles.m_domainProfileIndices;
+	updateRevision();
 
 	return *this;
 }
 
 NamecheapDomainProfileCollection::~NamecheapDomainProfileCollection() = default;
 
+size_t NamecheapDomainProfileCollection::DomainHash::operator () (std::string_view domain) const {
+	// FNV-1a over the case folded domain, so that lookups match the case insensitive equality
+	size_t hash = static_cast<size_t>(14695981039346656037ULL);
+
+	for(char character : domain) {
+		hash ^= static_cast<size_t>(std::tolower(static_cast<unsigned char>(character)));
+		hash *= static_cast<size_t>(1099511628211ULL);
+	}
+
+	return hash;
+}
+
+bool NamecheapDomainProfileCollection::DomainEqual::operator () (std::string_view domainA, std::string_view domainB) const {
+	return Utilities::areStringsEqualIgnoreCase(domainA, domainB);
+}
+
+void NamecheapDomainProfileCollection::rebuildDomainProfileIndex() {
+	m_domainProfileIndices.clear();
+	m_domainProfileIndices.reserve(m_domainProfiles.size());
+
+	for(size_t i = 0; i < m_domainProfiles.size(); i++) {
+		if(m_domainProfiles[i] == nullptr) {
+			continue;
+		}
+
+		m_domainProfileIndices.emplace(m_domainProfiles[i]->getDomain(), i);
+	}
+}
+
+void NamecheapDomainProfileCollection::updateRevision() {
+	m_revision = nextRevision++;
+}
+
 size_t NamecheapDomainProfileCollection::numberOfDomainProfiles() const {
 	return m_domainProfiles.size();
 }
 
+uint64_t NamecheapDomainProfileCollection::getRevision() const {
+	return m_revision;
+}
+
 bool NamecheapDomainProfileCollection::hasDomainProfile(const NamecheapDomainProfile & domainProfile) const {
 	return indexOfDomainProfile(domainProfile) != std::numeric_limits<size_t>::max();
 }
@@ -96,15 +232,13 @@ size_t NamecheapDomainProfileCollection::indexOfDomainProfile(std::string_view d
 		return std::numeric_limits<size_t>::max();
 	}
 
-	auto domainProfileIterator = std::find_if(m_domainProfiles.cbegin(), m_domainProfiles.cend(), [&domain](const std::shared_ptr<NamecheapDomainProfile> & currentDomainProfile) {
-		return Utilities::areStringsEqualIgnoreCase(domain, currentDomainProfile->getDomain());
-	});
+	auto domainProfileIndexIterator = m_domainProfileIndices.find(domain);
 
-	if(domainProfileIterator == m_domainProfiles.cend()) {
+	if(domainProfileIndexIterator == m_domainProfileIndices.cend()) {
 		return std::numeric_limits<size_t>::max();
 	}
 
-	return domainProfileIterator - m_domainProfiles.cbegin();
+	return domainProfileIndexIterator->second;
 }
 
 std::shared_ptr<NamecheapDomainProfile> NamecheapDomainProfileCollection::getDomainProfile(size_t index) const {
@@ -127,7 +261,7 @@ std::vector<std::string> NamecheapDomainProfileCollection::getDomains() const {
 	std::vector<std::string> domains;
 
 	for(size_t i = 0; i < m_domainProfiles.size(); i++) {
-		domains.push_back(m_domainProfiles[i]->getDomain());
+		domains.emplace_back(m_domainProfiles[i]->getDomain());
 	}
 
 	return domains;
@@ -138,7 +272,9 @@ bool NamecheapDomainProfileCollection::addDomainProfile(const NamecheapDomainPro
 		return false;
 	}
 
+	m_domainProfileIndices.emplace(domainProfile.getDomain(), m_domainProfiles.size());
 	m_domainProfiles.push_back(std::make_shared<NamecheapDomainProfile>(domainProfile));
+	updateRevision();
 
 	return true;
 }
@@ -148,7 +284,9 @@ bool NamecheapDomainProfileCollection::addDomainProfile(std::shared_ptr<Namechea
 		return false;
 	}
 
+	m_domainProfileIndices.emplace(domainProfile->getDomain(), m_domainProfiles.size());
 	m_domainProfiles.push_back(domainProfile);
+	updateRevision();
 
 	return true;
 }
@@ -156,6 +294,9 @@ bool NamecheapDomainProfileCollection::addDomainProfile(std::shared_ptr<Namechea
 size_t NamecheapDomainProfileCollection::addDomainProfiles(const std::vector<NamecheapDomainProfile> & domainProfiles) {
 	size_t numberOfDomainProfilesAdded = 0;
 
+	m_domainProfiles.reserve(m_domainProfiles.size() + domainProfiles.size());
+	m_domainProfileIndices.reserve(m_domainProfiles.size() + domainProfiles.size());
+
 	for(std::vector<NamecheapDomainProfile>::const_iterator i = domainProfiles.begin(); i != domainProfiles.end(); ++i) {
 		if(addDomainProfile(*i)) {
 			numberOfDomainProfilesAdded++;
@@ -168,6 +309,9 @@ size_t NamecheapDomainProfileCollection::addDomainProfiles(const std::vector<Nam
 size_t NamecheapDomainProfileCollection::addDomainProfiles(const std::vector<const NamecheapDomainProfile *> & domainProfiles) {
 	size_t numberOfDomainProfilesAdded = 0;
 
+	m_domainProfiles.reserve(m_domainProfiles.size() + domainProfiles.size());
+	m_domainProfileIndices.reserve(m_domainProfiles.size() + domainProfiles.size());
+
 	for(std::vector<const NamecheapDomainProfile *>::const_iterator i = domainProfiles.begin(); i != domainProfiles.end(); ++i) {
 		if(addDomainProfile(**i)) {
 			numberOfDomainProfilesAdded++;
@@ -180,6 +324,9 @@ size_t NamecheapDomainProfileCollection::addDomainProfiles(const std::vector<con
 size_t NamecheapDomainProfileCollection::addDomainProfiles(const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfiles) {
 	size_t numberOfDomainProfilesAdded = 0;
 
+	m_domainProfiles.reserve(m_domainProfiles.size() + domainProfiles.size());
+	m_domainProfileIndices.reserve(m_domainProfiles.size() + domainProfiles.size());
+
 	for(std::vector<std::shared_ptr<NamecheapDomainProfile>>::const_iterator i = domainProfiles.begin(); i != domainProfiles.end(); ++i) {
 		if(*i == nullptr) {
 			continue;
@@ -198,7 +345,15 @@ bool NamecheapDomainProfileCollection::removeDomainProfile(size_t index) {
 		return false;
 	}
 
+	m_domainProfileIndices.erase(std::string(m_domainProfiles[index]->getDomain()));
 	m_domainProfiles.erase(m_domainProfiles.begin() + index);
+	updateRevision();
+
+	for(auto & domainProfileIndex : m_domainProfileIndices) {
+		if(domainProfileIndex.second > index) {
+			domainProfileIndex.second--;
+		}
+	}
 
 	return true;
 }
@@ -213,6 +368,23 @@ bool NamecheapDomainProfileCollection::removeDomainProfileWithID(std::string_vie
 
 void NamecheapDomainProfileCollection::clearDomainProfiles() {
 	m_domainProfiles.clear();
+	m_domainProfileIndices.clear();
+	updateRevision();
+}
+
+void NamecheapDomainProfileCollection::compactIntoArena() {
+	if(m_domainProfiles.empty()) {
+		return;
+	}
+
+	// a single allocation holds both the arena and the control block every profile pointer shares
+	std::shared_ptr<NamecheapDomainProfileArena> arena(std::make_shared<NamecheapDomainProfileArena>(m_domainProfiles));
+
+	m_domainProfiles = NamecheapDomainProfileArena::getDomainProfiles(arena);
+
+	// null profiles are skipped by the arena, which shifts the indices of any that follow
+	rebuildDomainProfileIndex();
+	updateRevision();
 }
 
 rapidjson::Document NamecheapDomainProfileCollection::toJSON() const {
@@ -357,17 +529,19 @@ std::unique_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileCollecti
 	return newDomainProfilesCollection;
 }
 
-size_t NamecheapDomainProfileCollection::loadFrom(const std::vector<std::string> & filePaths, bool mergeWithExisting) {
+size_t NamecheapDomainProfileCollection::loadFrom(const std::vector<std::string> & filePaths, bool mergeWithExisting, size_t numberOfWorkerThreads, bool useBinarySnapshots) {
 	if(filePaths.empty()) {
 		return 0;
 	}
 
+	// read and parse every file up front, then merge them in their original order so duplicate domains resolve exactly like a sequential load would
+	std::vector<std::unique_ptr<NamecheapDomainProfileCollection>> fileDomainProfiles(readFrom(filePaths, numberOfWorkerThreads, useBinarySnapshots));
 	size_t numberOfDomainProfilesLoaded = 0;
 
 	for(size_t i = 0; i < filePaths.size(); i++) {
 		const std::string & filePath = filePaths[i];
 
-		if(loadFrom(filePath, mergeWithExisting)) {
+		if(mergeFrom(std::move(fileDomainProfiles[i]), mergeWithExisting)) {
 			numberOfDomainProfilesLoaded++;
 		}
 		else {
@@ -378,50 +552,261 @@ size_t NamecheapDomainProfileCollection::loadFrom(const std::vector<std::string>
 	return numberOfDomainProfilesLoaded;
 }
 
-bool NamecheapDomainProfileCollection::loadFrom(const std::string & filePath, bool mergeWithExisting) {
+std::vector<std::unique_ptr<NamecheapDomainProfileCollection>> NamecheapDomainProfileCollection::readFrom(const std::vector<std::string> & filePaths, size_t numberOfWorkerThreads, bool useBinarySnapshots) {
+	std::vector<std::unique_ptr<NamecheapDomainProfileCollection>> fileDomainProfiles(filePaths.size());
+
+	if(filePaths.empty()) {
+		return fileDomainProfiles;
+	}
+
+	std::atomic<size_t> nextFilePathIndex(0);
+
+	std::function<void()> loadWorker([&filePaths, &fileDomainProfiles, &nextFilePathIndex, useBinarySnapshots]() {
+		for(size_t i = nextFilePathIndex++; i < filePaths.size(); i = nextFilePathIndex++) {
+			std::chrono::steady_clock::time_point loadStartTime(std::chrono::steady_clock::now());
+
+			fileDomainProfiles[i] = readFrom(filePaths[i], useBinarySnapshots);
+
+			// workers load files concurrently, so only lock-free metrics are recorded
+			ApplicationMetrics::domainProfileLoadDuration.observeDuration(std::chrono::steady_clock::now() - loadStartTime);
+
+			if(fileDomainProfiles[i] == nullptr) {
+				ApplicationMetrics::domainProfileLoadFailures.increment();
+			}
+		}
+	});
+
+	size_t numberOfWorkers = std::min(std::max(numberOfWorkerThreads, static_cast<size_t>(1)), filePaths.size());
+	std::vector<std::thread> workerThreads;
+	workerThreads.reserve(numberOfWorkers - 1);
+
+	for(size_t i = 1; i < numberOfWorkers; i++) {
+		workerThreads.emplace_back(loadWorker);
+	}
+
+	loadWorker();
+
+	for(std::thread & workerThread : workerThreads) {
+		workerThread.join();
+	}
+
+	return fileDomainProfiles;
+}
+
+bool NamecheapDomainProfileCollection::loadFrom(const std::string & filePath, bool mergeWithExisting, bool useBinarySnapshots) {
+	std::chrono::steady_clock::time_point loadStartTime(std::chrono::steady_clock::now());
+	std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(readFrom(filePath, useBinarySnapshots));
+
+	ApplicationMetrics::domainProfileLoadDuration.observeDuration(std::chrono::steady_clock::now() - loadStartTime);
+
+	if(domainProfiles == nullptr) {
+		ApplicationMetrics::domainProfileLoadFailures.increment();
+	}
+
+	return mergeFrom(std::move(domainProfiles), mergeWithExisting);
+}
+
+bool NamecheapDomainProfileCollection::loadFromJSON(const std::string & filePath, bool mergeWithExisting) {
+	return mergeFrom(readFromJSON(filePath), mergeWithExisting);
+}
+
+bool NamecheapDomainProfileCollection::loadFromBinarySnapshot(const std::string & filePath, bool mergeWithExisting) {
+	return mergeFrom(readFromBinarySnapshot(filePath), mergeWithExisting);
+}
+
+std::unique_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileCollection::readFrom(const std::string & filePath, bool useBinarySnapshots) {
 	if(filePath.empty()) {
-		return false;
+		return nullptr;
 	}
 
 	std::string fileExtension(Utilities::getFileExtension(filePath));
 
 	if(fileExtension.empty()) {
-		return false;
+		return nullptr;
 	}
 	else if(Utilities::areStringsEqualIgnoreCase(fileExtension, "json")) {
-		if(!loadFromJSON(filePath, mergeWithExisting)) {
-			return false;
+		if(!useBinarySnapshots) {
+			return readFromJSON(filePath);
 		}
+
+		std::string binarySnapshotFilePath(getBinarySnapshotFilePath(filePath));
+
+		// prefer an existing snapshot, as long as it was generated from the current version of the JSON file
+		if(std::filesystem::is_regular_file(std::filesystem::path(binarySnapshotFilePath))) {
+			std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(readFromBinarySnapshot(binarySnapshotFilePath, filePath));
+
+			if(domainProfiles != nullptr) {
+				return domainProfiles;
+			}
+		}
+
+		std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(readFromJSON(filePath));
+
+		if(domainProfiles != nullptr && !domainProfiles->saveToBinarySnapshot(binarySnapshotFilePath, true, filePath)) {
+			spdlog::warn("Failed to save Namecheap domain profile collection binary snapshot file '{}'.", binarySnapshotFilePath);
+		}
+
+		return domainProfiles;
+	}
+	else if(Utilities::areStringsEqualIgnoreCase(fileExtension, BINARY_SNAPSHOT_FILE_EXTENSION)) {
+		return readFromBinarySnapshot(filePath);
 	}
 
-	return true;
+	spdlog::error("Unsupported Namecheap domain profile collection file extension: '{}'.", fileExtension);
+
+	return nullptr;
 }
 
-bool NamecheapDomainProfileCollection::loadFromJSON(const std::string & filePath, bool mergeWithExisting) {
+std::unique_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileCollection::readFromJSON(const std::string & filePath) {
 	if(filePath.empty()) {
-		return false;
+		return nullptr;
 	}
 
 	if(!std::filesystem::is_regular_file(std::filesystem::path(filePath))) {
-		return false;
+		return nullptr;
 	}
 
-	std::ifstream fileStream(filePath);
+	std::chrono::steady_clock::time_point parseStartTime(std::chrono::steady_clock::now());
+	std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(NamecheapDomainProfileCollectionReader::readFrom(filePath));
 
-	if(!fileStream.is_open()) {
-		return false;
+	ApplicationMetrics::domainProfileParseDuration.observeDuration(std::chrono::steady_clock::now() - parseStartTime);
+
+	if(!NamecheapDomainProfileCollection::isValid(domainProfiles.get())) {
+		spdlog::error("Failed to parse Namecheap domain profile collection from JSON file '{}'.", filePath);
+		return nullptr;
 	}
 
-	rapidjson::Document domainProfilesValue;
-	rapidjson::IStreamWrapper fileStreamWrapper(fileStream);
-	domainProfilesValue.ParseStream(fileStreamWrapper);
+	return domainProfiles;
+}
 
-	fileStream.close();
+std::unique_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileCollection::readFromBinarySnapshot(const std::string & filePath, const std::string & sourceFilePath) {
+	if(filePath.empty()) {
+		return nullptr;
+	}
 
-	std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(parseFrom(domainProfilesValue));
+	MemoryMappedFile snapshotFile;
 
-	if(!NamecheapDomainProfileCollection::isValid(domainProfiles.get())) {
-		spdlog::error("Failed to parse Namecheap domain profile collection from JSON file '{}'.", filePath);
+	if(!snapshotFile.open(filePath)) {
+		return nullptr;
+	}
+
+	const uint8_t * data = snapshotFile.getData();
+	size_t dataSize = snapshotFile.getSize();
+
+	if(dataSize < sizeof(BinarySnapshotHeader)) {
+		spdlog::error("Namecheap domain profile collection binary snapshot file '{}' is truncated.", filePath);
+		return nullptr;
+	}
+
+	BinarySnapshotHeader header;
+	std::memcpy(&header, data, sizeof(BinarySnapshotHeader));
+
+	if(header.magic != BINARY_SNAPSHOT_MAGIC || header.byteOrderMarker != BINARY_SNAPSHOT_BYTE_ORDER_MARKER) {
+		spdlog::error("File '{}' is not a Namecheap domain profile collection binary snapshot for this platform.", filePath);
+		return nullptr;
+	}
+
+	if(header.fileFormatVersion != BINARY_SNAPSHOT_FORMAT_VERSION) {
+		spdlog::debug("Ignoring Namecheap domain profile collection binary snapshot '{}' with unsupported file format version: {}, only version {} is supported.", filePath, header.fileFormatVersion, BINARY_SNAPSHOT_FORMAT_VERSION);
+		return nullptr;
+	}
+
+	if(!sourceFilePath.empty()) {
+		uint64_t sourceFileSize = 0;
+		int64_t sourceLastWriteTime = 0;
+
+		if(!getSourceFileInformation(sourceFilePath, sourceFileSize, sourceLastWriteTime) || header.sourceFileSize != sourceFileSize || header.sourceLastWriteTime != sourceLastWriteTime) {
+			spdlog::debug("Namecheap domain profile collection binary snapshot '{}' is out of date with '{}'.", filePath, sourceFilePath);
+			return nullptr;
+		}
+	}
+
+	size_t domainProfileRecordsSize = static_cast<size_t>(header.numberOfDomainProfiles) * sizeof(BinarySnapshotDomainProfileRecord);
+	size_t hostRecordsSize = static_cast<size_t>(header.numberOfHosts) * sizeof(BinarySnapshotHostRecord);
+	size_t payloadSize = domainProfileRecordsSize + hostRecordsSize + header.stringTableSize;
+
+	if(dataSize != sizeof(BinarySnapshotHeader) + payloadSize) {
+		spdlog::error("Namecheap domain profile collection binary snapshot file '{}' has an invalid size.", filePath);
+		return nullptr;
+	}
+
+	const uint8_t * domainProfileRecordsData = data + sizeof(BinarySnapshotHeader);
+	const uint8_t * hostRecordsData = domainProfileRecordsData + domainProfileRecordsSize;
+	const char * stringTable = reinterpret_cast<const char *>(hostRecordsData + hostRecordsSize);
+
+	if(calculateBinarySnapshotChecksum(domainProfileRecordsData, payloadSize) != header.checksum) {
+		spdlog::error("Namecheap domain profile collection binary snapshot file '{}' is corrupted.", filePath);
+		return nullptr;
+	}
+
+	std::function<bool(uint32_t, uint32_t)> isStringValid([&header](uint32_t offset, uint32_t length) {
+		return static_cast<uint64_t>(offset) + length <= header.stringTableSize;
+	});
+
+	std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(std::make_unique<NamecheapDomainProfileCollection>());
+	domainProfiles->m_domainProfiles.reserve(header.numberOfDomainProfiles);
+	domainProfiles->m_domainProfileIndices.reserve(header.numberOfDomainProfiles);
+
+	BinarySnapshotDomainProfileRecord domainProfileRecord;
+	BinarySnapshotHostRecord hostRecord;
+
+	for(uint32_t i = 0; i < header.numberOfDomainProfiles; i++) {
+		std::memcpy(&domainProfileRecord, domainProfileRecordsData + i * sizeof(BinarySnapshotDomainProfileRecord), sizeof(BinarySnapshotDomainProfileRecord));
+
+		if(!isStringValid(domainProfileRecord.domainOffset, domainProfileRecord.domainLength) ||
+		   !isStringValid(domainProfileRecord.passwordOffset, domainProfileRecord.passwordLength) ||
+		   static_cast<uint64_t>(domainProfileRecord.firstHostIndex) + domainProfileRecord.numberOfHosts > header.numberOfHosts ||
+		   !isBinarySnapshotAddressFamilyValid(domainProfileRecord.addressFamily)) {
+			spdlog::error("Namecheap domain profile collection binary snapshot file '{}' has an invalid domain profile record #{}.", filePath, i + 1);
+			return nullptr;
+		}
+
+		NamecheapDomainProfile::AddressFamily addressFamily = static_cast<NamecheapDomainProfile::AddressFamily>(domainProfileRecord.addressFamily);
+		std::vector<std::string_view> hosts;
+		hosts.reserve(domainProfileRecord.numberOfHosts);
+		std::vector<NamecheapDomainProfile::AddressFamily> hostAddressFamilies;
+
+		for(uint32_t j = domainProfileRecord.firstHostIndex; j < domainProfileRecord.firstHostIndex + domainProfileRecord.numberOfHosts; j++) {
+			std::memcpy(&hostRecord, hostRecordsData + j * sizeof(BinarySnapshotHostRecord), sizeof(BinarySnapshotHostRecord));
+
+			if(!isStringValid(hostRecord.offset, hostRecord.length) || !isBinarySnapshotAddressFamilyValid(hostRecord.addressFamily)) {
+				spdlog::error("Namecheap domain profile collection binary snapshot file '{}' has an invalid host record #{}.", filePath, j + 1);
+				return nullptr;
+			}
+
+			NamecheapDomainProfile::AddressFamily hostAddressFamily = static_cast<NamecheapDomainProfile::AddressFamily>(hostRecord.addressFamily);
+
+			// per host address families are only stored when at least one host differs from its profile
+			if(hostAddressFamily != addressFamily && hostAddressFamilies.empty()) {
+				hostAddressFamilies.resize(hosts.size(), addressFamily);
+			}
+
+			if(!hostAddressFamilies.empty()) {
+				hostAddressFamilies.push_back(hostAddressFamily);
+			}
+
+			hosts.emplace_back(stringTable + hostRecord.offset, hostRecord.length);
+		}
+
+		std::shared_ptr<NamecheapDomainProfile> domainProfile(std::make_shared<NamecheapDomainProfile>(
+			std::span<const std::string_view>(hosts),
+			std::string_view(stringTable + domainProfileRecord.domainOffset, domainProfileRecord.domainLength),
+			std::string_view(stringTable + domainProfileRecord.passwordOffset, domainProfileRecord.passwordLength),
+			addressFamily,
+			std::span<const NamecheapDomainProfile::AddressFamily>(hostAddressFamilies)
+		));
+
+		if(!domainProfiles->addDomainProfile(domainProfile)) {
+			spdlog::error("Failed to add Namecheap domain profile #{} from binary snapshot file '{}' to collection.", i + 1, filePath);
+			return nullptr;
+		}
+	}
+
+	return domainProfiles;
+}
+
+bool NamecheapDomainProfileCollection::mergeFrom(std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles, bool mergeWithExisting) {
+	if(domainProfiles == nullptr) {
 		return false;
 	}
 
@@ -433,6 +818,8 @@ bool NamecheapDomainProfileCollection::loadFromJSON(const std::string & filePath
 	}
 	else {
 		m_domainProfiles = std::move(domainProfiles->m_domainProfiles);
+		m_domainProfileIndices = std::move(domainProfiles->m_domainProfileIndices);
+		updateRevision();
 	}
 
 	return true;
@@ -451,6 +838,9 @@ bool NamecheapDomainProfileCollection::saveTo(const std::string & filePath, bool
 	else if(Utilities::areStringsEqualIgnoreCase(fileExtension, "json")) {
 		return saveToJSON(filePath, overwrite);
 	}
+	else if(Utilities::areStringsEqualIgnoreCase(fileExtension, BINARY_SNAPSHOT_FILE_EXTENSION)) {
+		return saveToBinarySnapshot(filePath, overwrite);
+	}
 
 	return false;
 }
@@ -461,33 +851,110 @@ bool NamecheapDomainProfileCollection::saveToJSON(const std::string & filePath,
 		return false;
 	}
 
-	std::ofstream fileStream(filePath);
+	return AtomicFileWriter::writeJSONTo(filePath, toJSON());
+}
 
-	if(!fileStream.is_open()) {
+bool NamecheapDomainProfileCollection::saveToBinarySnapshot(const std::string & filePath, bool overwrite, const std::string & sourceFilePath) const {
+	if(filePath.empty()) {
 		return false;
 	}
 
-	rapidjson::Document domainProfiles(toJSON());
+	if (!overwrite && std::filesystem::exists(std::filesystem::path(filePath))) {
+		spdlog::warn("File '{}' already exists, use overwrite to force write.", filePath);
+		return false;
+	}
 
-	rapidjson::OStreamWrapper fileStreamWrapper(fileStream);
-	rapidjson::PrettyWriter<rapidjson::OStreamWrapper> fileStreamWriter(fileStreamWrapper);
-	fileStreamWriter.SetIndent('\t', 1);
-	domainProfiles.Accept(fileStreamWriter);
-	fileStream.close();
+	BinarySnapshotHeader header;
+	std::memset(&header, 0, sizeof(BinarySnapshotHeader));
+	header.magic = BINARY_SNAPSHOT_MAGIC;
+	header.fileFormatVersion = BINARY_SNAPSHOT_FORMAT_VERSION;
+	header.byteOrderMarker = BINARY_SNAPSHOT_BYTE_ORDER_MARKER;
+
+	if(!sourceFilePath.empty() && !getSourceFileInformation(sourceFilePath, header.sourceFileSize, header.sourceLastWriteTime)) {
+		spdlog::error("Failed to obtain information for binary snapshot source file '{}'.", sourceFilePath);
+		return false;
+	}
+
+	std::vector<BinarySnapshotDomainProfileRecord> domainProfileRecords;
+	domainProfileRecords.reserve(m_domainProfiles.size());
+	std::vector<BinarySnapshotHostRecord> hostRecords;
+	std::string stringTable;
+
+	std::function<BinarySnapshotStringRecord(std::string_view)> addString([&stringTable](std::string_view string) {
+		BinarySnapshotStringRecord stringRecord({ static_cast<uint32_t>(stringTable.size()), static_cast<uint32_t>(string.size()) });
+		stringTable.append(string);
+
+		return stringRecord;
+	});
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : m_domainProfiles) {
+		BinarySnapshotStringRecord domainRecord(addString(domainProfile->getDomain()));
+		BinarySnapshotStringRecord passwordRecord(addString(domainProfile->getPassword()));
+
+		domainProfileRecords.push_back({
+			domainRecord.offset,
+			domainRecord.length,
+			passwordRecord.offset,
+			passwordRecord.length,
+			static_cast<uint32_t>(hostRecords.size()),
+			static_cast<uint32_t>(domainProfile->numberOfHosts()),
+			static_cast<uint32_t>(domainProfile->getAddressFamily())
+		});
+
+		for(size_t i = 0; i < domainProfile->numberOfHosts(); i++) {
+			BinarySnapshotStringRecord hostRecord(addString(domainProfile->getHost(i)));
+
+			hostRecords.push_back({
+				hostRecord.offset,
+				hostRecord.length,
+				static_cast<uint32_t>(domainProfile->getHostAddressFamily(i))
+			});
+		}
+	}
+
+	if(stringTable.size() > std::numeric_limits<uint32_t>::max()) {
+		spdlog::error("Namecheap domain profile collection is too large to save as a binary snapshot.");
+		return false;
+	}
+
+	header.numberOfDomainProfiles = static_cast<uint32_t>(domainProfileRecords.size());
+	header.numberOfHosts = static_cast<uint32_t>(hostRecords.size());
+	header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+	header.checksum = calculateBinarySnapshotChecksum(reinterpret_cast<const uint8_t *>(domainProfileRecords.data()), domainProfileRecords.size() * sizeof(BinarySnapshotDomainProfileRecord));
+	header.checksum = calculateBinarySnapshotChecksum(reinterpret_cast<const uint8_t *>(hostRecords.data()), hostRecords.size() * sizeof(BinarySnapshotHostRecord), header.checksum);
+	header.checksum = calculateBinarySnapshotChecksum(reinterpret_cast<const uint8_t *>(stringTable.data()), stringTable.size(), header.checksum);
+
+	std::string snapshotData;
+	snapshotData.reserve(sizeof(BinarySnapshotHeader) + domainProfileRecords.size() * sizeof(BinarySnapshotDomainProfileRecord) + hostRecords.size() * sizeof(BinarySnapshotHostRecord) + stringTable.size());
+	snapshotData.append(reinterpret_cast<const char *>(&header), sizeof(BinarySnapshotHeader));
+	snapshotData.append(reinterpret_cast<const char *>(domainProfileRecords.data()), domainProfileRecords.size() * sizeof(BinarySnapshotDomainProfileRecord));
+	snapshotData.append(reinterpret_cast<const char *>(hostRecords.data()), hostRecords.size() * sizeof(BinarySnapshotHostRecord));
+	snapshotData.append(stringTable);
+
+	// the snapshot holds every profile password, so it is no more readable than the file it was generated from
+	if(!AtomicFileWriter::writeTo(filePath, snapshotData, sourceFilePath)) {
+		spdlog::error("Failed to write Namecheap domain profile collection binary snapshot file '{}'.", filePath);
+		return false;
+	}
 
 	return true;
 }
 
+std::string NamecheapDomainProfileCollection::getBinarySnapshotFilePath(const std::string & filePath) {
+	return filePath + "." + BINARY_SNAPSHOT_FILE_EXTENSION;
+}
+
 bool NamecheapDomainProfileCollection::isValid() const {
+	std::unordered_set<std::string_view, DomainHash, DomainEqual> domains;
+	domains.reserve(m_domainProfiles.size());
+
 	for(std::vector<std::shared_ptr<NamecheapDomainProfile>>::const_iterator i = m_domainProfiles.begin(); i != m_domainProfiles.end(); ++i) {
 		if(!(*i)->isValid()) {
 			return false;
 		}
 
-		for(std::vector<std::shared_ptr<NamecheapDomainProfile>>::const_iterator j = i + 1; j != m_domainProfiles.end(); ++j) {
-			if(Utilities::areStringsEqualIgnoreCase((*i)->getDomain(), (*j)->getDomain())) {
-				return false;
-			}
+		if(!domains.emplace((*i)->getDomain()).second) {
+			return false;
 		}
 	}
 
@@ -6,9 +6,11 @@
 #include <rapidjson/document.h>
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class NamecheapDomainProfileCollection final {
@@ -23,6 +25,8 @@ public:
 	~NamecheapDomainProfileCollection();
 
 	size_t numberOfDomainProfiles() const;
+	// unique across every collection and changed by every modification, so that data derived from a collection can tell when it is stale
+	uint64_t getRevision() const;
 	bool hasDomainProfile(const NamecheapDomainProfile & domainProfile) const;
 	bool hasDomainProfile(std::string_view domain) const;
 	size_t indexOfDomainProfile(const NamecheapDomainProfile & domainProfile) const;
@@ -40,14 +44,23 @@ public:
 	bool removeDomainProfile(const NamecheapDomainProfile & domainProfile);
 	bool removeDomainProfileWithID(std::string_view domain);
 	void clearDomainProfiles();
+	// repacks every domain profile into a single shared arena, profiles held elsewhere keep their previous storage
+	void compactIntoArena();
 
 	rapidjson::Document toJSON() const;
 	static std::unique_ptr<NamecheapDomainProfileCollection> parseFrom(const rapidjson::Value & domainProfileCollection);
-	size_t loadFrom(const std::vector<std::string> & filePaths, bool mergeWithExisting = false);
-	bool loadFrom(const std::string & filePath, bool mergeWithExisting = false);
+	size_t loadFrom(const std::vector<std::string> & filePaths, bool mergeWithExisting = false, size_t numberOfWorkerThreads = 1, bool useBinarySnapshots = false);
+	bool loadFrom(const std::string & filePath, bool mergeWithExisting = false, bool useBinarySnapshots = false);
 	bool loadFromJSON(const std::string & filePath, bool mergeWithExisting = false);
+	bool loadFromBinarySnapshot(const std::string & filePath, bool mergeWithExisting = false);
+	static std::vector<std::unique_ptr<NamecheapDomainProfileCollection>> readFrom(const std::vector<std::string> & filePaths, size_t numberOfWorkerThreads = 1, bool useBinarySnapshots = false);
+	static std::unique_ptr<NamecheapDomainProfileCollection> readFrom(const std::string & filePath, bool useBinarySnapshots = false);
+	static std::unique_ptr<NamecheapDomainProfileCollection> readFromJSON(const std::string & filePath);
+	static std::unique_ptr<NamecheapDomainProfileCollection> readFromBinarySnapshot(const std::string & filePath, const std::string & sourceFilePath = {});
 	bool saveTo(const std::string & filePath, bool overwrite = true) const;
 	bool saveToJSON(const std::string & filePath, bool overwrite = true) const;
+	bool saveToBinarySnapshot(const std::string & filePath, bool overwrite = true, const std::string & sourceFilePath = {}) const;
+	static std::string getBinarySnapshotFilePath(const std::string & filePath);
 
 	bool isValid() const;
 	static bool isValid(const NamecheapDomainProfileCollection * domainProfiles);
@@ -57,9 +70,28 @@ public:
 
 	static const std::string FILE_TYPE;
 	static const uint32_t FILE_FORMAT_VERSION;
+	static const std::string BINARY_SNAPSHOT_FILE_EXTENSION;
 
 private:
+	struct DomainHash {
+		typedef void is_transparent;
+
+		size_t operator () (std::string_view domain) const;
+	};
+
+	struct DomainEqual {
+		typedef void is_transparent;
+
+		bool operator () (std::string_view domainA, std::string_view domainB) const;
+	};
+
+	void rebuildDomainProfileIndex();
+	void updateRevision();
+	bool mergeFrom(std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles, bool mergeWithExisting);
+
 	std::vector<std::shared_ptr<NamecheapDomainProfile>> m_domainProfiles;
+	std::unordered_map<std::string, size_t, DomainHash, DomainEqual> m_domainProfileIndices;
+	uint64_t m_revision;
 };
 
 #endif // _NAMECHEAP_DOMAIN_PROFILE_COLLECTION_H_
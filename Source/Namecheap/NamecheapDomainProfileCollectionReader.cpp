@@ -0,0 +1,603 @@
+#include "NamecheapDomainProfileCollectionReader.h"
+
+#include "NamecheapDomainProfileCollection.h"
+
+#include <Utilities/RapidJSONUtilities.h>
+#include <Utilities/StringUtilities.h>
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/filereadstream.h>
+#include <rapidjson/reader.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdio>
+#include <span>
+
+static constexpr const char * JSON_FILE_TYPE_PROPERTY_NAME = "fileType";
+static constexpr const char * JSON_FILE_FORMAT_VERSION_PROPERTY_NAME = "fileFormatVersion";
+static constexpr const char * JSON_DOMAIN_PROFILE_PROPERTY_NAME = "profile";
+static constexpr const char * JSON_DOMAIN_PROFILES_PROPERTY_NAME = "profiles";
+static constexpr const char * JSON_HOSTS_PROPERTY_NAME = "hosts";
+static constexpr const char * JSON_HOST_PROPERTY_NAME = "host";
+static constexpr const char * JSON_DOMAIN_PROPERTY_NAME = "domain";
+static constexpr const char * JSON_PASSWORD_PROPERTY_NAME = "password";
+static constexpr const char * JSON_ADDRESS_FAMILY_PROPERTY_NAME = "addressFamily";
+
+static constexpr const char * WHITESPACE_CHARACTERS = " \t\n\v\f\r";
+
+const size_t NamecheapDomainProfileCollectionReader::READ_BUFFER_SIZE = 64 * 1024;
+
+static std::string_view getTrimmedStringView(std::string_view string) {
+	size_t startIndex = string.find_first_not_of(WHITESPACE_CHARACTERS);
+
+	if(startIndex == std::string_view::npos) {
+		return {};
+	}
+
+	return string.substr(startIndex, string.find_last_not_of(WHITESPACE_CHARACTERS) - startIndex + 1);
+}
+
+NamecheapDomainProfileCollectionReader::NamecheapDomainProfileCollectionReader(NamecheapDomainProfileCollection & domainProfiles)
+	: m_domainProfiles(domainProfiles)
+	, m_state(State::Collection)
+	, m_skipReturnState(State::Collection)
+	, m_skipDepth(0)
+	, m_failed(false)
+	, m_fileTypeFound(false)
+	, m_fileFormatVersionFound(false)
+	, m_domainProfilesFound(false)
+	, m_inDomainProfileList(false)
+	, m_numberOfDomainProfilesRead(0)
+	, m_numberOfDomainProfileListEntries(0)
+	, m_hostFound(false)
+	, m_numberOfHosts(0)
+	, m_hostsFound(false)
+	, m_hostObjectHostFound(false)
+	, m_hostObjectAddressFamily(NamecheapDomainProfile::AddressFamily::IPv4)
+	, m_hostObjectAddressFamilyFound(false)
+	, m_domainFound(false)
+	, m_passwordFound(false)
+	, m_addressFamily(NamecheapDomainProfile::AddressFamily::IPv4) { }
+
+NamecheapDomainProfileCollectionReader::~NamecheapDomainProfileCollectionReader() = default;
+
+bool NamecheapDomainProfileCollectionReader::hasFailed() const {
+	return m_failed;
+}
+
+size_t NamecheapDomainProfileCollectionReader::numberOfDomainProfilesRead() const {
+	return m_numberOfDomainProfilesRead;
+}
+
+std::unique_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileCollectionReader::readFrom(const std::string & filePath) {
+	std::unique_ptr<std::FILE, decltype(&std::fclose)> file(std::fopen(filePath.c_str(), "rb"), &std::fclose);
+
+	if(file == nullptr) {
+		spdlog::error("Failed to open JSON file '{}' for reading.", filePath);
+		return nullptr;
+	}
+
+	std::vector<char> readBuffer(READ_BUFFER_SIZE);
+	rapidjson::FileReadStream fileStream(file.get(), readBuffer.data(), readBuffer.size());
+	std::unique_ptr<NamecheapDomainProfileCollection> domainProfiles(std::make_unique<NamecheapDomainProfileCollection>());
+	NamecheapDomainProfileCollectionReader domainProfileCollectionReader(*domainProfiles);
+	rapidjson::Reader reader;
+	rapidjson::ParseResult parseResult(reader.Parse<rapidjson::kParseDefaultFlags>(fileStream, domainProfileCollectionReader));
+
+	// errors raised by the handler have already been reported with more detail than the parser could give
+	if(domainProfileCollectionReader.hasFailed()) {
+		return nullptr;
+	}
+
+	if(parseResult.IsError()) {
+		spdlog::error("Failed to parse JSON file '{}' at offset {}: {}", filePath, parseResult.Offset(), rapidjson::GetParseError_En(parseResult.Code()));
+		return nullptr;
+	}
+
+	return domainProfiles;
+}
+
+bool NamecheapDomainProfileCollectionReader::Null() {
+	return onScalar(rapidjson::kNullType);
+}
+
+bool NamecheapDomainProfileCollectionReader::Bool(bool value) {
+	return onScalar(value ? rapidjson::kTrueType : rapidjson::kFalseType);
+}
+
+bool NamecheapDomainProfileCollectionReader::Int(int) {
+	return onScalar(rapidjson::kNumberType);
+}
+
+bool NamecheapDomainProfileCollectionReader::Uint(unsigned value) {
+	if(m_state != State::FileFormatVersion) {
+		return onScalar(rapidjson::kNumberType);
+	}
+
+	if(value != NamecheapDomainProfileCollection::FILE_FORMAT_VERSION) {
+		spdlog::error("Unsupported Namecheap domain profile collection file format version: {}, only version {} is supported.", value, NamecheapDomainProfileCollection::FILE_FORMAT_VERSION);
+		return fail();
+	}
+
+	m_fileFormatVersionFound = true;
+	m_state = State::CollectionProperties;
+
+	return true;
+}
+
+bool NamecheapDomainProfileCollectionReader::Int64(int64_t) {
+	return onScalar(rapidjson::kNumberType);
+}
+
+bool NamecheapDomainProfileCollectionReader::Uint64(uint64_t) {
+	return onScalar(rapidjson::kNumberType);
+}
+
+bool NamecheapDomainProfileCollectionReader::Double(double) {
+	return onScalar(rapidjson::kNumberType);
+}
+
+bool NamecheapDomainProfileCollectionReader::RawNumber(const char *, rapidjson::SizeType, bool) {
+	return onScalar(rapidjson::kNumberType);
+}
+
+bool NamecheapDomainProfileCollectionReader::String(const char * value, rapidjson::SizeType length, bool) {
+	return onString(std::string_view(value, length));
+}
+
+bool NamecheapDomainProfileCollectionReader::StartObject() {
+	switch(m_state) {
+		case State::SkipValue:
+			m_skipDepth++;
+			return true;
+
+		case State::Collection:
+			m_state = State::CollectionProperties;
+			return true;
+
+		case State::DomainProfile:
+		case State::DomainProfileListEntries:
+			beginDomainProfile();
+			return true;
+
+		case State::HostListEntries:
+			m_hostObjectHost.clear();
+			m_hostObjectHostFound = false;
+			m_hostObjectAddressFamilyFound = false;
+			m_state = State::HostProperties;
+			return true;
+
+		default:
+			return onInvalidType(rapidjson::kObjectType);
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::Key(const char * name, rapidjson::SizeType length, bool) {
+	std::string_view propertyName(name, length);
+
+	switch(m_state) {
+		case State::SkipValue:
+			return true;
+
+		case State::CollectionProperties:
+			if(propertyName == JSON_FILE_TYPE_PROPERTY_NAME) {
+				m_state = State::FileType;
+			}
+			else if(propertyName == JSON_FILE_FORMAT_VERSION_PROPERTY_NAME) {
+				m_state = State::FileFormatVersion;
+			}
+			else if(propertyName == JSON_DOMAIN_PROFILE_PROPERTY_NAME || propertyName == JSON_DOMAIN_PROFILES_PROPERTY_NAME) {
+				// only one of the two is used, matching documents which specify both
+				if(m_domainProfilesFound) {
+					skipValue();
+					return true;
+				}
+
+				m_domainProfilesFound = true;
+				m_inDomainProfileList = propertyName == JSON_DOMAIN_PROFILES_PROPERTY_NAME;
+				m_state = m_inDomainProfileList ? State::DomainProfiles : State::DomainProfile;
+			}
+			else {
+				spdlog::warn("Namecheap domain profile collection has unexpected property '{}'.", propertyName);
+				skipValue();
+			}
+
+			return true;
+
+		case State::DomainProfileProperties:
+			if(propertyName == JSON_HOSTS_PROPERTY_NAME) {
+				m_state = State::Hosts;
+			}
+			else if(propertyName == JSON_HOST_PROPERTY_NAME) {
+				m_state = State::Host;
+			}
+			else if(propertyName == JSON_DOMAIN_PROPERTY_NAME) {
+				m_state = State::Domain;
+			}
+			else if(propertyName == JSON_PASSWORD_PROPERTY_NAME) {
+				m_state = State::Password;
+			}
+			else if(propertyName == JSON_ADDRESS_FAMILY_PROPERTY_NAME) {
+				m_state = State::AddressFamily;
+			}
+			else {
+				spdlog::warn("Namecheap domain profile has unexpected property '{}'.", propertyName);
+				skipValue();
+			}
+
+			return true;
+
+		case State::HostProperties:
+			if(propertyName == JSON_HOST_PROPERTY_NAME) {
+				m_state = State::HostObjectHost;
+			}
+			else if(propertyName == JSON_ADDRESS_FAMILY_PROPERTY_NAME) {
+				m_state = State::HostObjectAddressFamily;
+			}
+			else {
+				spdlog::warn("Namecheap domain profile host #{} has unexpected property '{}'.", m_numberOfHosts + 1, propertyName);
+				skipValue();
+			}
+
+			return true;
+
+		default:
+			return fail();
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::EndObject(rapidjson::SizeType) {
+	switch(m_state) {
+		case State::SkipValue:
+			if(--m_skipDepth == 0) {
+				m_state = m_skipReturnState;
+			}
+
+			return true;
+
+		case State::CollectionProperties:
+			if(!m_fileTypeFound) {
+				spdlog::warn("Namecheap domain profile collection JSON data is missing file type, and may fail to load correctly!");
+			}
+
+			if(!m_fileFormatVersionFound) {
+				spdlog::warn("Namecheap domain profile collection JSON data is missing file format version, and may fail to load correctly!");
+			}
+
+			if(!m_domainProfilesFound) {
+				spdlog::error("Namecheap domain profile collection is missing '{}' or '{}' property.", JSON_DOMAIN_PROFILE_PROPERTY_NAME, JSON_DOMAIN_PROFILES_PROPERTY_NAME);
+				return fail();
+			}
+
+			m_state = State::Done;
+			return true;
+
+		case State::DomainProfileProperties:
+			return endDomainProfile();
+
+		case State::HostProperties:
+			return endHostObject();
+
+		default:
+			return fail();
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::StartArray() {
+	switch(m_state) {
+		case State::SkipValue:
+			m_skipDepth++;
+			return true;
+
+		case State::DomainProfiles:
+			m_numberOfDomainProfileListEntries = 0;
+			m_state = State::DomainProfileListEntries;
+			return true;
+
+		case State::Hosts:
+			m_numberOfHosts = 0;
+			m_hostAddressFamilyOverrides.clear();
+			m_hostsFound = true;
+			m_state = State::HostListEntries;
+			return true;
+
+		default:
+			return onInvalidType(rapidjson::kArrayType);
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::EndArray(rapidjson::SizeType) {
+	switch(m_state) {
+		case State::SkipValue:
+			if(--m_skipDepth == 0) {
+				m_state = m_skipReturnState;
+			}
+
+			return true;
+
+		case State::DomainProfileListEntries:
+			if(m_numberOfDomainProfileListEntries == 0) {
+				spdlog::error("Namecheap domain profile collection '{}' property cannot be empty.", JSON_DOMAIN_PROFILES_PROPERTY_NAME);
+				return fail();
+			}
+
+			m_state = State::CollectionProperties;
+			return true;
+
+		case State::HostListEntries:
+			m_state = State::DomainProfileProperties;
+			return true;
+
+		default:
+			return fail();
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::onScalar(rapidjson::Type type) {
+	if(m_state == State::SkipValue) {
+		if(m_skipDepth == 0) {
+			m_state = m_skipReturnState;
+		}
+
+		return true;
+	}
+
+	return onInvalidType(type);
+}
+
+bool NamecheapDomainProfileCollectionReader::onString(std::string_view value) {
+	switch(m_state) {
+		case State::SkipValue:
+			return onScalar(rapidjson::kStringType);
+
+		case State::FileType:
+			if(!Utilities::areStringsEqualIgnoreCase(value, NamecheapDomainProfileCollection::FILE_TYPE)) {
+				spdlog::error("Incorrect Namecheap domain profile collection file type: '{}', expected: '{}'.", value, NamecheapDomainProfileCollection::FILE_TYPE);
+				return fail();
+			}
+
+			m_fileTypeFound = true;
+			m_state = State::CollectionProperties;
+			return true;
+
+		case State::Host:
+			m_host.assign(getTrimmedStringView(value));
+			m_hostFound = true;
+			m_state = State::DomainProfileProperties;
+			return true;
+
+		case State::HostListEntries:
+			addHost(getTrimmedStringView(value));
+			return true;
+
+		case State::HostObjectHost:
+			m_hostObjectHost.assign(getTrimmedStringView(value));
+			m_hostObjectHostFound = true;
+			m_state = State::HostProperties;
+			return true;
+
+		case State::HostObjectAddressFamily:
+			if(!parseAddressFamily(value, m_hostObjectAddressFamily)) {
+				return failDomainProfile();
+			}
+
+			m_hostObjectAddressFamilyFound = true;
+			m_state = State::HostProperties;
+			return true;
+
+		case State::Domain:
+			m_domain.assign(getTrimmedStringView(value));
+			m_domainFound = true;
+			m_state = State::DomainProfileProperties;
+			return true;
+
+		case State::Password:
+			m_password.assign(getTrimmedStringView(value));
+			m_passwordFound = true;
+			m_state = State::DomainProfileProperties;
+			return true;
+
+		case State::AddressFamily:
+			if(!parseAddressFamily(value, m_addressFamily)) {
+				return failDomainProfile();
+			}
+
+			m_state = State::DomainProfileProperties;
+			return true;
+
+		default:
+			return onInvalidType(rapidjson::kStringType);
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::onInvalidType(rapidjson::Type type) {
+	switch(m_state) {
+		case State::Collection:
+			spdlog::error("Invalid Namecheap domain profile collection type: '{}', expected 'object'.", Utilities::typeToString(type));
+			return fail();
+
+		case State::FileType:
+			spdlog::error("Invalid Namecheap domain profile collection file type type: '{}', expected: 'string'.", Utilities::typeToString(type));
+			return fail();
+
+		case State::FileFormatVersion:
+			spdlog::error("Invalid Namecheap domain profile collection file format version type: '{}', expected unsigned integer 'number'.", Utilities::typeToString(type));
+			return fail();
+
+		case State::DomainProfiles:
+			spdlog::error("Invalid Namecheap domain profile collection '{}' type: '{}', expected 'array'.", JSON_DOMAIN_PROFILES_PROPERTY_NAME, Utilities::typeToString(type));
+			return fail();
+
+		case State::DomainProfile:
+		case State::DomainProfileListEntries:
+			// the entry is counted so that the failure refers to the right domain profile
+			m_numberOfDomainProfileListEntries++;
+			spdlog::error("Invalid Namecheap domain profile type: '{}', expected 'object'.", Utilities::typeToString(type));
+			spdlog::error("Failed to parse Namecheap domain profile #{}.", m_numberOfDomainProfilesRead + 1);
+			return fail();
+
+		case State::Host:
+		case State::Domain:
+		case State::Password:
+		case State::AddressFamily:
+		{
+			const char * propertyName = m_state == State::Host ? JSON_HOST_PROPERTY_NAME : m_state == State::Domain ? JSON_DOMAIN_PROPERTY_NAME : m_state == State::Password ? JSON_PASSWORD_PROPERTY_NAME : JSON_ADDRESS_FAMILY_PROPERTY_NAME;
+			spdlog::error("Invalid Namecheap domain profile '{}' property type: '{}', expected: 'string'.", propertyName, Utilities::typeToString(type));
+			return failDomainProfile();
+		}
+
+		case State::Hosts:
+			spdlog::error("Invalid Namecheap domain profile '{}' property type: '{}', expected: 'array'.", JSON_HOSTS_PROPERTY_NAME, Utilities::typeToString(type));
+			return failDomainProfile();
+
+		case State::HostListEntries:
+		case State::HostObjectHost:
+			spdlog::error("Invalid Namecheap domain profile host #{} property type: '{}', expected: 'string' or 'object' with a '{}' string property.", m_numberOfHosts + 1, Utilities::typeToString(m_state == State::HostObjectHost ? rapidjson::kObjectType : type), JSON_HOST_PROPERTY_NAME);
+			return failDomainProfile();
+
+		case State::HostObjectAddressFamily:
+			spdlog::error("Invalid Namecheap domain profile '{}' property type: '{}', expected: 'string'.", JSON_ADDRESS_FAMILY_PROPERTY_NAME, Utilities::typeToString(type));
+			return failDomainProfile();
+
+		default:
+			return fail();
+	}
+}
+
+bool NamecheapDomainProfileCollectionReader::parseAddressFamily(std::string_view value, NamecheapDomainProfile::AddressFamily & addressFamily) {
+	std::optional<NamecheapDomainProfile::AddressFamily> optionalAddressFamily(NamecheapDomainProfile::parseAddressFamily(getTrimmedStringView(value)));
+
+	if(!optionalAddressFamily.has_value()) {
+		spdlog::error("Invalid Namecheap domain profile '{}' property value: '{}', expected 'v4', 'v6' or 'both'.", JSON_ADDRESS_FAMILY_PROPERTY_NAME, value);
+		return false;
+	}
+
+	addressFamily = optionalAddressFamily.value();
+
+	return true;
+}
+
+void NamecheapDomainProfileCollectionReader::skipValue() {
+	m_skipReturnState = m_state;
+	m_skipDepth = 0;
+	m_state = State::SkipValue;
+}
+
+void NamecheapDomainProfileCollectionReader::beginDomainProfile() {
+	m_numberOfDomainProfileListEntries++;
+	m_host.clear();
+	m_hostFound = false;
+	m_numberOfHosts = 0;
+	m_hostsFound = false;
+	m_hostAddressFamilyOverrides.clear();
+	m_domain.clear();
+	m_domainFound = false;
+	m_password.clear();
+	m_passwordFound = false;
+	m_addressFamily = NamecheapDomainProfile::AddressFamily::IPv4;
+	m_state = State::DomainProfileProperties;
+}
+
+bool NamecheapDomainProfileCollectionReader::endDomainProfile() {
+	std::vector<std::string_view> hosts;
+
+	// a single host takes precedence over a host list, as it does when parsing a document
+	if(m_hostFound) {
+		hosts.emplace_back(m_host);
+	}
+	else if(m_hostsFound) {
+		hosts.assign(m_hosts.cbegin(), m_hosts.cbegin() + m_numberOfHosts);
+	}
+	else {
+		spdlog::error("Namecheap domain profile is missing '{}' or '{}' property.", JSON_HOST_PROPERTY_NAME, JSON_HOSTS_PROPERTY_NAME);
+		return failDomainProfile();
+	}
+
+	if(hosts.empty()) {
+		spdlog::error("Namecheap domain profile does not specify any hosts, at least one is required.");
+		return failDomainProfile();
+	}
+
+	for(size_t i = 0; i < hosts.size(); i++) {
+		if(hosts[i].empty()) {
+			spdlog::error("Namecheap domain profile host #{} is empty, expected non-empty string.", i + 1);
+			return failDomainProfile();
+		}
+	}
+
+	if(!m_domainFound) {
+		spdlog::error("Namecheap domain profile is missing '{}' property.", JSON_DOMAIN_PROPERTY_NAME);
+		return failDomainProfile();
+	}
+
+	if(!m_passwordFound) {
+		spdlog::error("Namecheap domain profile is missing '{}' property.", JSON_PASSWORD_PROPERTY_NAME);
+		return failDomainProfile();
+	}
+
+	std::vector<NamecheapDomainProfile::AddressFamily> hostAddressFamilies;
+
+	if(!m_hostFound && !m_hostAddressFamilyOverrides.empty()) {
+		hostAddressFamilies.resize(hosts.size(), m_addressFamily);
+
+		for(const std::pair<size_t, NamecheapDomainProfile::AddressFamily> & hostAddressFamilyOverride : m_hostAddressFamilyOverrides) {
+			hostAddressFamilies[hostAddressFamilyOverride.first] = hostAddressFamilyOverride.second;
+		}
+	}
+
+	std::shared_ptr<NamecheapDomainProfile> domainProfile(std::make_shared<NamecheapDomainProfile>(std::span<const std::string_view>(hosts), m_domain, m_password, m_addressFamily, std::span<const NamecheapDomainProfile::AddressFamily>(hostAddressFamilies)));
+
+	if(!domainProfile->isValid()) {
+		return failDomainProfile();
+	}
+
+	if(!m_domainProfiles.addDomainProfile(domainProfile)) {
+		spdlog::error("Failed to add Namecheap domain profile #{} to collection.", m_numberOfDomainProfilesRead + 1);
+		return fail();
+	}
+
+	m_numberOfDomainProfilesRead++;
+	m_state = m_inDomainProfileList ? State::DomainProfileListEntries : State::CollectionProperties;
+
+	return true;
+}
+
+bool NamecheapDomainProfileCollectionReader::endHostObject() {
+	if(!m_hostObjectHostFound) {
+		spdlog::error("Invalid Namecheap domain profile host #{} property type: '{}', expected: 'string' or 'object' with a '{}' string property.", m_numberOfHosts + 1, Utilities::typeToString(rapidjson::kObjectType), JSON_HOST_PROPERTY_NAME);
+		return failDomainProfile();
+	}
+
+	if(m_hostObjectAddressFamilyFound) {
+		m_hostAddressFamilyOverrides.emplace_back(m_numberOfHosts, m_hostObjectAddressFamily);
+	}
+
+	addHost(m_hostObjectHost);
+	m_state = State::HostListEntries;
+
+	return true;
+}
+
+void NamecheapDomainProfileCollectionReader::addHost(std::string_view host) {
+	// previously allocated host strings are overwritten rather than freed, so reading a large file does not churn the heap
+	if(m_numberOfHosts < m_hosts.size()) {
+		m_hosts[m_numberOfHosts].assign(host);
+	}
+	else {
+		m_hosts.emplace_back(host);
+	}
+
+	m_numberOfHosts++;
+}
+
+bool NamecheapDomainProfileCollectionReader::fail() {
+	m_failed = true;
+
+	return false;
+}
+
+bool NamecheapDomainProfileCollectionReader::failDomainProfile() {
+	spdlog::error("Failed to parse Namecheap domain profile #{}.", m_numberOfDomainProfilesRead + 1);
+
+	return fail();
+}
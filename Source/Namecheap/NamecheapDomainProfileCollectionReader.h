@@ -0,0 +1,115 @@
+#ifndef _NAMECHEAP_DOMAIN_PROFILE_COLLECTION_READER_H_
+#define _NAMECHEAP_DOMAIN_PROFILE_COLLECTION_READER_H_
+
+#include "NamecheapDomainProfile.h"
+
+#include <rapidjson/document.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class NamecheapDomainProfileCollection;
+
+// streaming rapidjson SAX handler for domain profile collection files, each domain profile is validated and added to the collection as soon as it has been read,
+// so memory use is bounded by the collection itself plus a fixed size read buffer rather than a document object model several times the size of the file
+class NamecheapDomainProfileCollectionReader final {
+public:
+	NamecheapDomainProfileCollectionReader(NamecheapDomainProfileCollection & domainProfiles);
+	~NamecheapDomainProfileCollectionReader();
+
+	bool hasFailed() const;
+	size_t numberOfDomainProfilesRead() const;
+
+	static std::unique_ptr<NamecheapDomainProfileCollection> readFrom(const std::string & filePath);
+
+	// rapidjson SAX handler interface
+	bool Null();
+	bool Bool(bool value);
+	bool Int(int value);
+	bool Uint(unsigned value);
+	bool Int64(int64_t value);
+	bool Uint64(uint64_t value);
+	bool Double(double value);
+	bool RawNumber(const char * value, rapidjson::SizeType length, bool copy);
+	bool String(const char * value, rapidjson::SizeType length, bool copy);
+	bool StartObject();
+	bool Key(const char * name, rapidjson::SizeType length, bool copy);
+	bool EndObject(rapidjson::SizeType numberOfMembers);
+	bool StartArray();
+	bool EndArray(rapidjson::SizeType numberOfElements);
+
+	static const size_t READ_BUFFER_SIZE;
+
+private:
+	enum class State : uint8_t {
+		Collection,
+		CollectionProperties,
+		FileType,
+		FileFormatVersion,
+		DomainProfile,
+		DomainProfiles,
+		DomainProfileListEntries,
+		DomainProfileProperties,
+		Host,
+		Hosts,
+		HostListEntries,
+		HostProperties,
+		HostObjectHost,
+		HostObjectAddressFamily,
+		Domain,
+		Password,
+		AddressFamily,
+		SkipValue,
+		Done
+	};
+
+	bool onScalar(rapidjson::Type type);
+	bool onString(std::string_view value);
+	bool onInvalidType(rapidjson::Type type);
+	bool parseAddressFamily(std::string_view value, NamecheapDomainProfile::AddressFamily & addressFamily);
+	void skipValue();
+	void beginDomainProfile();
+	bool endDomainProfile();
+	bool endHostObject();
+	void addHost(std::string_view host);
+	bool fail();
+	bool failDomainProfile();
+
+	NamecheapDomainProfileCollection & m_domainProfiles;
+	State m_state;
+	State m_skipReturnState;
+	size_t m_skipDepth;
+	bool m_failed;
+	bool m_fileTypeFound;
+	bool m_fileFormatVersionFound;
+	bool m_domainProfilesFound;
+	bool m_inDomainProfileList;
+	size_t m_numberOfDomainProfilesRead;
+	size_t m_numberOfDomainProfileListEntries;
+
+	// state of the domain profile currently being read, host strings are reused from one profile to the next
+	std::string m_host;
+	bool m_hostFound;
+	std::vector<std::string> m_hosts;
+	size_t m_numberOfHosts;
+	bool m_hostsFound;
+	std::vector<std::pair<size_t, NamecheapDomainProfile::AddressFamily>> m_hostAddressFamilyOverrides;
+	std::string m_hostObjectHost;
+	bool m_hostObjectHostFound;
+	NamecheapDomainProfile::AddressFamily m_hostObjectAddressFamily;
+	bool m_hostObjectAddressFamilyFound;
+	std::string m_domain;
+	bool m_domainFound;
+	std::string m_password;
+	bool m_passwordFound;
+	NamecheapDomainProfile::AddressFamily m_addressFamily;
+
+	NamecheapDomainProfileCollectionReader(const NamecheapDomainProfileCollectionReader &) = delete;
+	const NamecheapDomainProfileCollectionReader & operator = (const NamecheapDomainProfileCollectionReader &) = delete;
+};
+
+#endif // _NAMECHEAP_DOMAIN_PROFILE_COLLECTION_READER_H_
@@ -1,12 +1,21 @@
 #include "NamecheapDomainProfileManager.h"
 
 #include "Application/SettingsManager.h"
+#include "IO/FileWatcher.h"
 
 #include <spdlog/spdlog.h>
 
-NamecheapDomainProfileManager::NamecheapDomainProfileManager() { }
+#include <filesystem>
+#include <thread>
 
-NamecheapDomainProfileManager::~NamecheapDomainProfileManager() = default;
+NamecheapDomainProfileManager::NamecheapDomainProfileManager()
+	: m_initialized(false)
+	, m_useBinarySnapshots(false)
+	, m_useArenaStorage(false) { }
+
+NamecheapDomainProfileManager::~NamecheapDomainProfileManager() {
+	stopWatchingFiles();
+}
 
 bool NamecheapDomainProfileManager::isInitialized() const {
 	return m_initialized;
@@ -18,39 +27,217 @@ bool NamecheapDomainProfileManager::initialize(const ArgumentCollection * argume
 	}
 
 	SettingsManager * settings = SettingsManager::getInstance();
-	bool domainProfilesOverriden = false;
-	size_t numberOfDomainProfilesToLoad = 0;
-	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(std::make_shared<NamecheapDomainProfileCollection>());
+	size_t numberOfLoadingThreads = settings->numberOfDomainProfileLoadingThreads;
 
 	if(arguments != nullptr) {
-		std::vector<std::string> domainProfileFilePaths(arguments->getValues("p", "profile"));
+		std::string numberOfLoadingThreadsValue(arguments->getFirstValue("load-threads"));
+
+		if(!numberOfLoadingThreadsValue.empty()) {
+			try {
+				numberOfLoadingThreads = std::stoul(numberOfLoadingThreadsValue);
+			}
+			catch(const std::exception &) {
+				spdlog::warn("Ignoring invalid domain profile loading thread count: '{}'.", numberOfLoadingThreadsValue);
+			}
+		}
+	}
 
-		if(!domainProfileFilePaths.empty()) {
-			domainProfilesOverriden = true;
-			numberOfDomainProfilesToLoad = domainProfileFilePaths.size();
+	if(numberOfLoadingThreads == 0) {
+		numberOfLoadingThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
 
-			domainProfiles->loadFrom(domainProfileFilePaths, true);
-		}
+	std::vector<std::string> domainProfileFilePaths;
+
+	if(arguments != nullptr) {
+		domainProfileFilePaths = arguments->getValues("p", "profile");
 	}
 
-	if(!domainProfilesOverriden) {
-		numberOfDomainProfilesToLoad = settings->domainProfileFilePaths.size();
-		domainProfiles->loadFrom(settings->domainProfileFilePaths, true);
+	if(domainProfileFilePaths.empty()) {
+		domainProfileFilePaths = settings->domainProfileFilePaths;
 	}
 
-	if(domainProfiles == nullptr) {
-		spdlog::error("Failed to load one or more Namecheap domain profile files.");
-		return false;
+	// files are kept as separate collections so that a change to one file only requires that file to be parsed again
+	std::vector<std::unique_ptr<NamecheapDomainProfileCollection>> fileDomainProfiles(NamecheapDomainProfileCollection::readFrom(domainProfileFilePaths, numberOfLoadingThreads, settings->domainProfileBinarySnapshotsEnabled));
+
+	m_useBinarySnapshots = settings->domainProfileBinarySnapshotsEnabled;
+	m_useArenaStorage = settings->domainProfileArenaStorageEnabled;
+	m_domainProfileFilePaths = std::move(domainProfileFilePaths);
+	m_fileDomainProfiles.clear();
+	m_fileDomainProfiles.reserve(fileDomainProfiles.size());
+
+	for(size_t i = 0; i < fileDomainProfiles.size(); i++) {
+		if(fileDomainProfiles[i] == nullptr) {
+			spdlog::error("Failed to load Namecheap domain profile from file path: '{}'.", m_domainProfileFilePaths[i]);
+		}
+		else if(m_useArenaStorage) {
+			// each file is packed separately, so that reloading one file leaves the profiles of every other file untouched
+			fileDomainProfiles[i]->compactIntoArena();
+		}
+
+		m_fileDomainProfiles.emplace_back(std::move(fileDomainProfiles[i]));
 	}
 
+	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(mergeFileDomainProfiles());
+
 	if(domainProfiles->numberOfDomainProfiles() == 0) {
 		spdlog::error("No Namecheap domain profiles loaded from files.");
 		return false;
 	}
 
-	m_domainProfiles = std::move(domainProfiles);
+	std::atomic_store(&m_domainProfiles, domainProfiles);
+
+	spdlog::info("Successfully loaded {} Namecheap domain profiles from files.", domainProfiles->numberOfDomainProfiles());
+
+	m_initialized = true;
+
+	return true;
+}
+
+std::shared_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileManager::getDomainProfiles() const {
+	return std::atomic_load(&m_domainProfiles);
+}
+
+const std::vector<std::string> & NamecheapDomainProfileManager::getDomainProfileFilePaths() const {
+	return m_domainProfileFilePaths;
+}
+
+std::shared_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileManager::mergeFileDomainProfiles() const {
+	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(std::make_shared<NamecheapDomainProfileCollection>());
+
+	for(size_t i = 0; i < m_fileDomainProfiles.size(); i++) {
+		if(m_fileDomainProfiles[i] == nullptr) {
+			continue;
+		}
+
+		if(domainProfiles->addDomainProfiles(m_fileDomainProfiles[i]->getDomainProfiles()) != m_fileDomainProfiles[i]->numberOfDomainProfiles()) {
+			spdlog::error("Failed to add one or more Namecheap domain profiles from file '{}'. Did you make sure there are no duplicated domains?", m_domainProfileFilePaths[i]);
+		}
+	}
+
+	return domainProfiles;
+}
+
+std::shared_ptr<NamecheapDomainProfileCollection> NamecheapDomainProfileManager::reloadDomainProfiles(const std::vector<std::string> & changedFilePaths) {
+	if(!m_initialized) {
+		return nullptr;
+	}
+
+	std::lock_guard<std::mutex> lock(m_reloadMutex);
+
+	std::vector<size_t> changedFileIndices;
+
+	for(size_t i = 0; i < m_domainProfileFilePaths.size(); i++) {
+		std::string watchedFilePath(FileWatcher::getWatchedFilePath(m_domainProfileFilePaths[i]));
+
+		for(const std::string & changedFilePath : changedFilePaths) {
+			if(FileWatcher::getWatchedFilePath(changedFilePath) == watchedFilePath) {
+				changedFileIndices.push_back(i);
+				break;
+			}
+		}
+	}
+
+	if(changedFileIndices.empty()) {
+		return std::make_shared<NamecheapDomainProfileCollection>();
+	}
+
+	for(size_t changedFileIndex : changedFileIndices) {
+		const std::string & filePath = m_domainProfileFilePaths[changedFileIndex];
+
+		if(!std::filesystem::is_regular_file(std::filesystem::path(filePath))) {
+			spdlog::warn("Namecheap domain profile file '{}' was removed, dropping its domain profiles.", filePath);
+			m_fileDomainProfiles[changedFileIndex].reset();
+			continue;
+		}
+
+		std::unique_ptr<NamecheapDomainProfileCollection> fileDomainProfiles(NamecheapDomainProfileCollection::readFrom(filePath, m_useBinarySnapshots));
+
+		// a file which fails to parse is usually still being edited, keep serving its last good contents
+		if(fileDomainProfiles == nullptr) {
+			spdlog::error("Failed to reload Namecheap domain profile file '{}', keeping previously loaded domain profiles.", filePath);
+			continue;
+		}
+
+		spdlog::info("Reloaded {} Namecheap domain profiles from file '{}'.", fileDomainProfiles->numberOfDomainProfiles(), filePath);
+
+		if(m_useArenaStorage) {
+			fileDomainProfiles->compactIntoArena();
+		}
+
+		m_fileDomainProfiles[changedFileIndex] = std::move(fileDomainProfiles);
+	}
+
+	std::shared_ptr<NamecheapDomainProfileCollection> previousDomainProfiles(getDomainProfiles());
+	std::shared_ptr<NamecheapDomainProfileCollection> domainProfiles(mergeFileDomainProfiles());
+	std::shared_ptr<NamecheapDomainProfileCollection> changedDomainProfiles(std::make_shared<NamecheapDomainProfileCollection>());
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfiles->getDomainProfiles()) {
+		std::shared_ptr<NamecheapDomainProfile> previousDomainProfile(previousDomainProfiles != nullptr ? previousDomainProfiles->getDomainProfileWithID(domainProfile->getDomain()) : nullptr);
+
+		// profiles from files which were not reloaded are shared with the previous collection and can be skipped without comparing them
+		if(previousDomainProfile == nullptr || (previousDomainProfile != domainProfile && *previousDomainProfile != *domainProfile)) {
+			changedDomainProfiles->addDomainProfile(domainProfile);
+		}
+	}
+
+	size_t numberOfRemovedDomainProfiles = 0;
+
+	if(previousDomainProfiles != nullptr) {
+		for(const std::shared_ptr<NamecheapDomainProfile> & previousDomainProfile : previousDomainProfiles->getDomainProfiles()) {
+			if(!domainProfiles->hasDomainProfile(previousDomainProfile->getDomain())) {
+				numberOfRemovedDomainProfiles++;
+			}
+		}
+	}
+
+	std::atomic_store(&m_domainProfiles, domainProfiles);
+
+	spdlog::info("Namecheap domain profiles reloaded, {} added or changed, {} removed, {} total.", changedDomainProfiles->numberOfDomainProfiles(), numberOfRemovedDomainProfiles, domainProfiles->numberOfDomainProfiles());
+
+	return changedDomainProfiles;
+}
+
+bool NamecheapDomainProfileManager::isWatchingFiles() const {
+	return m_fileWatcher != nullptr && m_fileWatcher->isRunning();
+}
+
+bool NamecheapDomainProfileManager::startWatchingFiles(DomainProfilesChangedCallback domainProfilesChangedCallback) {
+	if(!m_initialized || domainProfilesChangedCallback == nullptr) {
+		return false;
+	}
+
+	if(isWatchingFiles()) {
+		return true;
+	}
+
+	m_fileWatcher = std::make_unique<FileWatcher>([this, domainProfilesChangedCallback](const std::vector<std::string> & changedFilePaths) {
+		std::shared_ptr<NamecheapDomainProfileCollection> changedDomainProfiles(reloadDomainProfiles(changedFilePaths));
 
-	spdlog::info("Successfully loaded {} Namecheap domain profiles from files.", m_domainProfiles->numberOfDomainProfiles());
+		if(changedDomainProfiles != nullptr && changedDomainProfiles->numberOfDomainProfiles() != 0) {
+			domainProfilesChangedCallback(changedDomainProfiles);
+		}
+	});
+
+	for(const std::string & domainProfileFilePath : m_domainProfileFilePaths) {
+		m_fileWatcher->watchFile(domainProfileFilePath);
+	}
+
+	if(!m_fileWatcher->start()) {
+		spdlog::error("Failed to start watching Namecheap domain profile files for changes.");
+		m_fileWatcher.reset();
+		return false;
+	}
+
+	spdlog::info("Watching {} Namecheap domain profile files for changes.", m_fileWatcher->numberOfWatchedFiles());
 
 	return true;
 }
+
+void NamecheapDomainProfileManager::stopWatchingFiles() {
+	if(m_fileWatcher == nullptr) {
+		return;
+	}
+
+	m_fileWatcher->stop();
+	m_fileWatcher.reset();
+}
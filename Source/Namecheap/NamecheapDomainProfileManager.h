@@ -6,19 +6,42 @@
 #include <Arguments/ArgumentCollection.h>
 
 #include <atomic>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class FileWatcher;
 
 class NamecheapDomainProfileManager final {
 public:
+	typedef std::function<void(std::shared_ptr<NamecheapDomainProfileCollection> changedDomainProfiles)> DomainProfilesChangedCallback;
+
 	NamecheapDomainProfileManager();
 	~NamecheapDomainProfileManager();
 
 	bool isInitialized() const;
 	bool initialize(const ArgumentCollection * arguments);
+	std::shared_ptr<NamecheapDomainProfileCollection> getDomainProfiles() const;
+	const std::vector<std::string> & getDomainProfileFilePaths() const;
+	std::shared_ptr<NamecheapDomainProfileCollection> reloadDomainProfiles(const std::vector<std::string> & changedFilePaths);
+	bool isWatchingFiles() const;
+	bool startWatchingFiles(DomainProfilesChangedCallback domainProfilesChangedCallback);
+	void stopWatchingFiles();
 
 private:
+	std::shared_ptr<NamecheapDomainProfileCollection> mergeFileDomainProfiles() const;
+
 	std::atomic<bool> m_initialized;
+	bool m_useBinarySnapshots;
+	bool m_useArenaStorage;
+	// replaced as a whole on reload and only accessed through std::atomic_load / std::atomic_store, so readers keep a consistent snapshot
 	std::shared_ptr<NamecheapDomainProfileCollection> m_domainProfiles;
+	std::vector<std::string> m_domainProfileFilePaths;
+	std::vector<std::shared_ptr<NamecheapDomainProfileCollection>> m_fileDomainProfiles;
+	std::unique_ptr<FileWatcher> m_fileWatcher;
+	std::mutex m_reloadMutex;
 
 	NamecheapDomainProfileManager(const NamecheapDomainProfileManager &) = delete;
 	const NamecheapDomainProfileManager & operator = (const NamecheapDomainProfileManager &) = delete;
@@ -0,0 +1,182 @@
+#include "NamecheapDynamicDNSResponse.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <array>
+#include <cctype>
+#include <charconv>
+
+static constexpr std::string_view RESPONSE_ROOT_ELEMENT_NAME("interface-response");
+static constexpr std::string_view ERROR_COUNT_ELEMENT_NAME("ErrCount");
+static constexpr std::string_view FIRST_ERROR_ELEMENT_NAME("Err1");
+static constexpr std::string_view RESPONSE_NUMBER_ELEMENT_NAME("ResponseNumber");
+static constexpr std::string_view RESPONSE_STRING_ELEMENT_NAME("ResponseString");
+static constexpr std::string_view IP_ADDRESS_ELEMENT_NAME("IP");
+static constexpr std::string_view DONE_ELEMENT_NAME("Done");
+
+// response numbers which Namecheap returns for requests that will keep failing until the profile itself is changed
+static constexpr std::array<uint32_t, 4> PERMANENT_ERROR_RESPONSE_NUMBERS({
+	304156, // passwords do not match
+	316153, // domain name not found
+	316154, // domain name not active
+	380091  // no records updated, host record not found
+});
+
+static std::string_view trimStringView(std::string_view text) {
+	while(!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) {
+		text.remove_prefix(1);
+	}
+
+	while(!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) {
+		text.remove_suffix(1);
+	}
+
+	return text;
+}
+
+static std::optional<uint32_t> parseUnsignedInteger(std::string_view text) {
+	uint32_t value = 0;
+	std::from_chars_result result(std::from_chars(text.data(), text.data() + text.length(), value));
+
+	if(result.ec != std::errc() || result.ptr != text.data() + text.length()) {
+		return {};
+	}
+
+	return value;
+}
+
+NamecheapDynamicDNSResponse::NamecheapDynamicDNSResponse()
+	: m_valid(false)
+	, m_done(false)
+	, m_errorCount(0) { }
+
+NamecheapDynamicDNSResponse::~NamecheapDynamicDNSResponse() = default;
+
+bool NamecheapDynamicDNSResponse::isValid() const {
+	return m_valid;
+}
+
+bool NamecheapDynamicDNSResponse::isSuccessful() const {
+	return m_valid && m_errorCount == 0;
+}
+
+bool NamecheapDynamicDNSResponse::isDone() const {
+	return m_done;
+}
+
+uint32_t NamecheapDynamicDNSResponse::getErrorCount() const {
+	return m_errorCount;
+}
+
+std::string_view NamecheapDynamicDNSResponse::getErrorMessage() const {
+	return m_errorMessage;
+}
+
+std::optional<uint32_t> NamecheapDynamicDNSResponse::getResponseNumber() const {
+	return m_responseNumber;
+}
+
+std::string_view NamecheapDynamicDNSResponse::getResponseString() const {
+	return m_responseString;
+}
+
+std::string_view NamecheapDynamicDNSResponse::getIPAddress() const {
+	return m_ipAddress;
+}
+
+NamecheapDynamicDNSResponse::ErrorClass NamecheapDynamicDNSResponse::classifyError() const {
+	if(!m_valid) {
+		// an unrecognized body usually means an intermediary error page, which is worth retrying
+		return ErrorClass::Retryable;
+	}
+
+	if(m_errorCount == 0) {
+		return ErrorClass::None;
+	}
+
+	if(m_responseNumber.has_value()) {
+		for(uint32_t permanentErrorResponseNumber : PERMANENT_ERROR_RESPONSE_NUMBERS) {
+			if(m_responseNumber.value() == permanentErrorResponseNumber) {
+				return ErrorClass::Permanent;
+			}
+		}
+	}
+
+	// suspending a host needs more certainty than the wording of an error message, anything unrecognized is retried
+	return ErrorClass::Retryable;
+}
+
+NamecheapDynamicDNSResponse NamecheapDynamicDNSResponse::parseFrom(std::string_view responseBody) {
+	NamecheapDynamicDNSResponse response;
+	size_t position = 0;
+
+	// single pass over the body, capturing the text content of the few elements of interest as views into the original data
+	while((position = responseBody.find('<', position)) != std::string_view::npos) {
+		size_t tagEndPosition = responseBody.find('>', position + 1);
+
+		if(tagEndPosition == std::string_view::npos) {
+			break;
+		}
+
+		std::string_view tag(responseBody.substr(position + 1, tagEndPosition - position - 1));
+		position = tagEndPosition + 1;
+
+		if(tag.empty() || tag.front() == '/' || tag.front() == '?' || tag.front() == '!' || tag.back() == '/') {
+			continue;
+		}
+
+		std::string_view elementName(tag.substr(0, tag.find_first_of(" \t\r\n")));
+
+		if(elementName == RESPONSE_ROOT_ELEMENT_NAME) {
+			response.m_valid = true;
+			continue;
+		}
+
+		size_t textEndPosition = responseBody.find('<', position);
+
+		if(textEndPosition == std::string_view::npos) {
+			break;
+		}
+
+		std::string_view text(trimStringView(responseBody.substr(position, textEndPosition - position)));
+
+		if(elementName == ERROR_COUNT_ELEMENT_NAME) {
+			response.m_errorCount = parseUnsignedInteger(text).value_or(0);
+		}
+		else if(elementName == FIRST_ERROR_ELEMENT_NAME) {
+			response.m_errorMessage = text;
+		}
+		else if(elementName == RESPONSE_NUMBER_ELEMENT_NAME && !response.m_responseNumber.has_value()) {
+			response.m_responseNumber = parseUnsignedInteger(text);
+		}
+		else if(elementName == RESPONSE_STRING_ELEMENT_NAME && response.m_responseString.empty()) {
+			response.m_responseString = text;
+		}
+		else if(elementName == IP_ADDRESS_ELEMENT_NAME) {
+			response.m_ipAddress = text;
+		}
+		else if(elementName == DONE_ELEMENT_NAME) {
+			response.m_done = Utilities::areStringsEqualIgnoreCase(text, "true");
+		}
+	}
+
+	// error details are only meaningful when errors are reported
+	if(response.m_errorCount != 0 && response.m_errorMessage.empty()) {
+		response.m_errorMessage = response.m_responseString;
+	}
+
+	return response;
+}
+
+NamecheapDynamicDNSResponse::ErrorClass NamecheapDynamicDNSResponse::classifyStatusCode(uint16_t statusCode) {
+	if(statusCode < 400) {
+		return ErrorClass::None;
+	}
+
+	// timeouts, throttling and server side errors are transient, any other client error will not go away by retrying
+	if(statusCode == 408 || statusCode == 425 || statusCode == 429 || statusCode >= 500) {
+		return ErrorClass::Retryable;
+	}
+
+	return ErrorClass::Permanent;
+}
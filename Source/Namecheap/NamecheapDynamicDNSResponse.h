@@ -0,0 +1,42 @@
+#ifndef _NAMECHEAP_DYNAMIC_DNS_RESPONSE_H_
+#define _NAMECHEAP_DYNAMIC_DNS_RESPONSE_H_
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+class NamecheapDynamicDNSResponse final {
+public:
+	enum class ErrorClass {
+		None,
+		Retryable,
+		Permanent
+	};
+
+	NamecheapDynamicDNSResponse();
+	~NamecheapDynamicDNSResponse();
+
+	bool isValid() const;
+	bool isSuccessful() const;
+	bool isDone() const;
+	uint32_t getErrorCount() const;
+	std::string_view getErrorMessage() const;
+	std::optional<uint32_t> getResponseNumber() const;
+	std::string_view getResponseString() const;
+	std::string_view getIPAddress() const;
+	ErrorClass classifyError() const;
+
+	static NamecheapDynamicDNSResponse parseFrom(std::string_view responseBody);
+	static ErrorClass classifyStatusCode(uint16_t statusCode);
+
+private:
+	bool m_valid;
+	bool m_done;
+	uint32_t m_errorCount;
+	std::string_view m_errorMessage;
+	std::optional<uint32_t> m_responseNumber;
+	std::string_view m_responseString;
+	std::string_view m_ipAddress;
+};
+
+#endif // _NAMECHEAP_DYNAMIC_DNS_RESPONSE_H_
@@ -1,28 +1,305 @@
 #include "NamecheapDynamicDNSService.h"
 
+#include "NamecheapDomainProfileCollection.h"
+#include "NamecheapDynamicDNSResponse.h"
+#include "NamecheapHostTable.h"
+#include "NamecheapIPAddressCache.h"
+#include "NamecheapUpdateJournal.h"
+#include "NamecheapUpdatePlanner.h"
+#include "Metrics/ApplicationMetrics.h"
+#include "Network/CircuitBreaker.h"
+#include "Network/ExternalIPAddressResolver.h"
+#include "Network/HTTPEventLoop.h"
+#include "Network/HTTPSessionPool.h"
+#include "Network/RateLimiter.h"
+
 #include <Network/HTTPService.h>
 #include <Network/IPAddressService.h>
 #include <Utilities/FileUtilities.h>
+#include <Utilities/StringUtilities.h>
 
 #include <spdlog/spdlog.h>
 
-static const std::string NAMECHEAP_DYNAMIC_DNS_BASE_URL("https://dynamicdns.park-your-domain.com");
+#include <functional>
+#include <future>
+#include <optional>
+#include <thread>
+
 static const std::string NAMECHEAP_DYNAMIC_DNS_UPDATE_PATH("update");
 static const std::string HOST_QUERY_PARAMETER("host");
 static const std::string DOMAIN_QUERY_PARAMETER("domain");
 static const std::string PASSWORD_QUERY_PARAMETER("password");
 static const std::string IP_ADDRESS_QUERY_PARAMETER("ip");
 
-NamecheapDynamicDNSService::NamecheapDynamicDNSService() { }
+static bool initializeHostResult(NamecheapDynamicDNSUpdateReport::HostResult & hostResult, std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) {
+	hostResult.host = host;
+	hostResult.domain = domain;
+	hostResult.ipAddress = ipAddress;
+
+	if(host.empty() || domain.empty() || password.empty() || ipAddress.empty()) {
+		hostResult.errorMessage = "Missing or invalid arguments provided when attempting to set Namecheap domain IP address.";
+		hostResult.errorClass = NamecheapDynamicDNSResponse::ErrorClass::Permanent;
+		return false;
+	}
+
+	return true;
+}
+
+// the body is passed separately so that it can be parsed in place from whichever buffer the transfer wrote it to
+static void processUpdateResponse(NamecheapDynamicDNSUpdateReport::HostResult & hostResult, const HTTPSessionPool::Response & response, std::string_view responseBody) {
+	if(response.isFailure()) {
+		hostResult.errorMessage = response.errorMessage;
+		hostResult.errorClass = NamecheapDynamicDNSResponse::ErrorClass::Retryable;
+		return;
+	}
+
+	hostResult.statusCode = response.statusCode;
+
+	if(response.isFailureStatusCode()) {
+		std::string statusCodeName(HTTPUtilities::getStatusCodeName(response.statusCode));
+		hostResult.errorMessage = fmt::format("HTTP status code {}{}", response.statusCode, statusCodeName.empty() ? "" : " " + statusCodeName);
+		hostResult.errorClass = NamecheapDynamicDNSResponse::classifyStatusCode(response.statusCode);
+		return;
+	}
+
+	// Namecheap reports most failures with a successful status code and an error list in the response body
+	NamecheapDynamicDNSResponse dynamicDNSResponse(NamecheapDynamicDNSResponse::parseFrom(responseBody));
+
+	if(!dynamicDNSResponse.isSuccessful()) {
+		hostResult.errorClass = dynamicDNSResponse.classifyError();
+
+		if(!dynamicDNSResponse.isValid()) {
+			hostResult.errorMessage = "Unrecognized Namecheap dynamic DNS response.";
+		}
+		else {
+			hostResult.errorMessage = dynamicDNSResponse.getErrorMessage().empty() ? fmt::format("Namecheap reported {} error(s).", dynamicDNSResponse.getErrorCount()) : std::string(dynamicDNSResponse.getErrorMessage());
+		}
+
+		return;
+	}
+
+	hostResult.success = true;
+}
+
+static void recordUpdateMetrics(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult, std::chrono::steady_clock::time_point updateStartTime) {
+	// called from concurrent dispatch workers, so only lock-free metrics may be recorded here
+	ApplicationMetrics::updateRequestDuration.observeDuration(std::chrono::steady_clock::now() - updateStartTime);
+
+	if(hostResult.success) {
+		ApplicationMetrics::successfulUpdates.increment();
+	}
+	else if(hostResult.errorClass == NamecheapDynamicDNSResponse::ErrorClass::Permanent) {
+		ApplicationMetrics::permanentUpdateFailures.increment();
+	}
+	else {
+		ApplicationMetrics::retryableUpdateFailures.increment();
+	}
+}
+
+const std::string NamecheapDynamicDNSService::DEFAULT_BASE_URL("https://dynamicdns.park-your-domain.com");
+const size_t NamecheapDynamicDNSService::DEFAULT_MAXIMUM_CONCURRENT_REQUESTS = 8;
+
+NamecheapDynamicDNSService::NamecheapDynamicDNSService()
+	: m_baseURL(DEFAULT_BASE_URL)
+	, m_circuitBreaker(std::make_unique<CircuitBreaker>(DEFAULT_BASE_URL))
+	, m_maximumConcurrentRequests(DEFAULT_MAXIMUM_CONCURRENT_REQUESTS)
+	, m_hostTable(std::make_unique<NamecheapHostTable>())
+	, m_updatePlanner(std::make_unique<NamecheapUpdatePlanner>()) { }
 
 NamecheapDynamicDNSService::~NamecheapDynamicDNSService() { }
 
+const std::string & NamecheapDynamicDNSService::getBaseURL() const {
+	return m_baseURL;
+}
+
+void NamecheapDynamicDNSService::setBaseURL(const std::string & baseURL) {
+	if(baseURL.empty() || Utilities::areStringsEqual(m_baseURL, baseURL)) {
+		return;
+	}
+
+	m_baseURL = baseURL;
+
+	// circuit breaker state belongs to the endpoint it was tracking
+	m_circuitBreaker = std::make_unique<CircuitBreaker>(m_baseURL, m_circuitBreaker->getFailureThreshold(), m_circuitBreaker->getResetTimeout());
+}
+
+const RetryPolicy & NamecheapDynamicDNSService::getRetryPolicy() const {
+	return m_retryPolicy;
+}
+
+void NamecheapDynamicDNSService::setRetryPolicy(const RetryPolicy & retryPolicy) {
+	m_retryPolicy = retryPolicy;
+}
+
+CircuitBreaker & NamecheapDynamicDNSService::getCircuitBreaker() const {
+	return *m_circuitBreaker;
+}
+
+std::shared_ptr<HTTPSessionPool> NamecheapDynamicDNSService::getHTTPSessionPool() const {
+	return m_sessionPool;
+}
+
+void NamecheapDynamicDNSService::setHTTPSessionPool(std::shared_ptr<HTTPSessionPool> sessionPool) {
+	m_sessionPool = sessionPool;
+}
+
+std::shared_ptr<HTTPEventLoop> NamecheapDynamicDNSService::getHTTPEventLoop() const {
+	return m_eventLoop;
+}
+
+void NamecheapDynamicDNSService::setHTTPEventLoop(std::shared_ptr<HTTPEventLoop> eventLoop) {
+	m_eventLoop = eventLoop;
+}
+
+std::shared_ptr<ExternalIPAddressResolver> NamecheapDynamicDNSService::getIPAddressResolver(IPAddressService::IPAddressType ipAddressType) const {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? m_ipv6AddressResolver : m_ipAddressResolver;
+}
+
+void NamecheapDynamicDNSService::setIPAddressResolver(std::shared_ptr<ExternalIPAddressResolver> ipAddressResolver, IPAddressService::IPAddressType ipAddressType) {
+	if(ipAddressType == IPAddressService::IPAddressType::V6) {
+		m_ipv6AddressResolver = ipAddressResolver;
+	}
+	else {
+		m_ipAddressResolver = ipAddressResolver;
+	}
+}
+
+size_t NamecheapDynamicDNSService::getMaximumConcurrentRequests() const {
+	return m_maximumConcurrentRequests;
+}
+
+void NamecheapDynamicDNSService::setMaximumConcurrentRequests(size_t maximumConcurrentRequests) {
+	m_maximumConcurrentRequests = std::max(maximumConcurrentRequests, static_cast<size_t>(1));
+}
+
+std::shared_ptr<RateLimiter> NamecheapDynamicDNSService::getRateLimiter() const {
+	return m_rateLimiter;
+}
+
+void NamecheapDynamicDNSService::setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter) {
+	m_rateLimiter = rateLimiter;
+}
+
+std::shared_ptr<NamecheapIPAddressCache> NamecheapDynamicDNSService::getIPAddressCache() const {
+	return m_ipAddressCache;
+}
+
+void NamecheapDynamicDNSService::setIPAddressCache(std::shared_ptr<NamecheapIPAddressCache> ipAddressCache) {
+	m_ipAddressCache = ipAddressCache;
+
+	// the host table was seeded from the previous cache
+	m_hostTable->clear();
+	m_updatePlanner->clear();
+}
+
+std::chrono::seconds NamecheapDynamicDNSService::getForcedRefreshInterval() const {
+	return m_updatePlanner->getForcedRefreshInterval();
+}
+
+void NamecheapDynamicDNSService::setForcedRefreshInterval(std::chrono::seconds forcedRefreshInterval) {
+	m_updatePlanner->setForcedRefreshInterval(forcedRefreshInterval);
+}
+
+std::shared_ptr<NamecheapUpdateJournal> NamecheapDynamicDNSService::getUpdateJournal() const {
+	return m_updateJournal;
+}
+
+void NamecheapDynamicDNSService::setUpdateJournal(std::shared_ptr<NamecheapUpdateJournal> updateJournal) {
+	m_updateJournal = updateJournal;
+}
+
+IPAddressService::IPAddressType NamecheapDynamicDNSService::getIPAddressType(std::string_view ipAddress) {
+	return ipAddress.find(':') != std::string_view::npos ? IPAddressService::IPAddressType::V6 : IPAddressService::IPAddressType::V4;
+}
+
+std::string NamecheapDynamicDNSService::getHostKey(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) {
+	// joined the same way as ip address cache entry keys, so that distinct hosts never share a suspension
+	return Utilities::toLowerCase(std::string(host) + '\n' + std::string(domain)) + (ipAddressType == IPAddressService::IPAddressType::V6 ? "/v6" : "");
+}
+
+size_t NamecheapDynamicDNSService::numberOfSuspendedHosts() const {
+	return m_suspendedHosts.size();
+}
+
+bool NamecheapDynamicDNSService::isHostSuspended(std::string_view host, std::string_view domain, std::string_view password, IPAddressService::IPAddressType ipAddressType) const {
+	if(m_suspendedHosts.empty()) {
+		return false;
+	}
+
+	std::unordered_map<std::string, std::string>::const_iterator suspendedHostIterator(m_suspendedHosts.find(getHostKey(host, domain, ipAddressType)));
+
+	return suspendedHostIterator != m_suspendedHosts.cend() && suspendedHostIterator->second == password;
+}
+
+void NamecheapDynamicDNSService::clearSuspendedHosts() {
+	m_suspendedHosts.clear();
+	m_updatePlanner->clearSuspended(*m_hostTable);
+}
+
+void NamecheapDynamicDNSService::forceUpdate(const NamecheapDomainProfileCollection & domainProfiles) {
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfiles.getDomainProfiles()) {
+		m_forcedDomains.insert(Utilities::toLowerCase(domainProfile->getDomain()));
+	}
+}
+
+std::string NamecheapDynamicDNSService::lookupIPAddress(IPAddressService::IPAddressType ipAddressType) const {
+	std::shared_ptr<ExternalIPAddressResolver> ipAddressResolver(getIPAddressResolver(ipAddressType));
+	std::chrono::steady_clock::time_point lookupStartTime(std::chrono::steady_clock::now());
+	std::string ipAddress(ipAddressResolver == nullptr ? IPAddressService::getInstance()->getIPAddress(ipAddressType) : ipAddressResolver->resolveIPAddress());
+
+	ApplicationMetrics::ipAddressLookupDuration.observeDuration(std::chrono::steady_clock::now() - lookupStartTime);
+
+	if(ipAddress.empty()) {
+		ApplicationMetrics::ipAddressLookupFailures.increment();
+	}
+
+	return ipAddress;
+}
+
+NamecheapDynamicDNSUpdateReport NamecheapDynamicDNSService::updateIPAddress(const NamecheapDomainProfileCollection & domainProfiles, bool force) {
+	if(domainProfiles.numberOfDomainProfiles() == 0) {
+		return {};
+	}
+
+	bool ipv4Required = false;
+	bool ipv6Required = false;
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfiles.getDomainProfiles()) {
+		ipv4Required |= domainProfile->usesAddressFamily(NamecheapDomainProfile::AddressFamily::IPv4);
+		ipv6Required |= domainProfile->usesAddressFamily(NamecheapDomainProfile::AddressFamily::IPv6);
+	}
+
+	// resolve the IPv6 address alongside the IPv4 address so that dual-stack profiles only wait for the slower of the two lookups
+	std::future<std::string> ipv6AddressFuture;
+
+	if(ipv6Required) {
+		ipv6AddressFuture = std::async(std::launch::async, &NamecheapDynamicDNSService::lookupIPAddress, this, IPAddressService::IPAddressType::V6);
+	}
+
+	std::string ipv4Address(ipv4Required ? lookupIPAddress(IPAddressService::IPAddressType::V4) : std::string());
+	std::string ipv6Address(ipv6Required ? ipv6AddressFuture.get() : std::string());
+
+	if(ipv4Required && ipv4Address.empty()) {
+		spdlog::error("Failed to determine external IPv4 address.");
+	}
+
+	if(ipv6Required && ipv6Address.empty()) {
+		spdlog::error("Failed to determine external IPv6 address.");
+	}
+
+	if(ipv4Address.empty() && ipv6Address.empty()) {
+		return {};
+	}
+
+	return setIPAddress(domainProfiles, ipv4Address, ipv6Address, force);
+}
+
 bool NamecheapDynamicDNSService::updateIPAddress(std::string_view host, std::string_view domain, std::string_view password) {
 	return updateIPAddress({ host }, domain, password);
 }
 
 bool NamecheapDynamicDNSService::updateIPAddress(const std::vector<std::string> & hosts, std::string_view domain, std::string_view password) {
-	std::string ipAddress(IPAddressService::getInstance()->getIPAddress(IPAddressService::IPAddressType::V4));
+	std::string ipAddress(lookupIPAddress());
 
 	if(ipAddress.empty()) {
 		spdlog::error("Failed to determine external IP address.");
@@ -32,35 +309,473 @@ bool NamecheapDynamicDNSService::updateIPAddress(const std::vector<std::string>
 	return setIPAddress(hosts, domain, password, ipAddress);
 }
 
-bool NamecheapDynamicDNSService::setIPAddress(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) {
-	if(host.empty() || domain.empty() || password.empty() || ipAddress.empty()) {
-		spdlog::error("Missing or invalid arguments provided when attempting to set Namecheap domain IP address.");
-		return false;
+NamecheapDynamicDNSUpdateReport::HostResult NamecheapDynamicDNSService::sendUpdateRequest(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const {
+	NamecheapDynamicDNSUpdateReport::HostResult hostResult;
+
+	if(!initializeHostResult(hostResult, host, domain, password, ipAddress)) {
+		return hostResult;
 	}
 
-	HTTPService * httpService = HTTPService::getInstance();
+	std::string updateURL(Utilities::joinPaths(m_baseURL, NAMECHEAP_DYNAMIC_DNS_UPDATE_PATH));
+	HTTPSessionPool::Response response;
+	std::shared_ptr<HTTPResponse> httpResponse;
+	std::string_view responseBody;
+	std::chrono::steady_clock::time_point requestStartTime(std::chrono::steady_clock::now());
 
-	if(!httpService->isInitialized()) {
-		spdlog::error("Failed to initialize HTTP service.");
-		return false;
+	if(m_sessionPool != nullptr) {
+		response = m_sessionPool->get(updateURL, {
+			{ HOST_QUERY_PARAMETER, host },
+			{ DOMAIN_QUERY_PARAMETER, domain },
+			{ PASSWORD_QUERY_PARAMETER, password },
+			{ IP_ADDRESS_QUERY_PARAMETER, ipAddress }
+		});
+
+		responseBody = response.body;
 	}
+	else {
+		HTTPService * httpService = HTTPService::getInstance();
 
-	std::shared_ptr<HTTPRequest> request(httpService->createRequest(HTTPRequest::Method::Get, Utilities::joinPaths(NAMECHEAP_DYNAMIC_DNS_BASE_URL, NAMECHEAP_DYNAMIC_DNS_UPDATE_PATH)));
-	request->addQueryParameter(HOST_QUERY_PARAMETER, host);
-	request->addQueryParameter(DOMAIN_QUERY_PARAMETER, domain);
-	request->addQueryParameter(PASSWORD_QUERY_PARAMETER, password);
-	request->addQueryParameter(IP_ADDRESS_QUERY_PARAMETER, ipAddress);
+		if(!httpService->isInitialized()) {
+			hostResult.errorMessage = "HTTP service is not initialized.";
+			hostResult.errorClass = NamecheapDynamicDNSResponse::ErrorClass::Retryable;
+			return hostResult;
+		}
 
-	std::shared_ptr<HTTPResponse> response(httpService->sendRequestAndWait(request));
+		std::shared_ptr<HTTPRequest> request(httpService->createRequest(HTTPRequest::Method::Get, updateURL));
+		request->addQueryParameter(HOST_QUERY_PARAMETER, host);
+		request->addQueryParameter(DOMAIN_QUERY_PARAMETER, domain);
+		request->addQueryParameter(PASSWORD_QUERY_PARAMETER, password);
+		request->addQueryParameter(IP_ADDRESS_QUERY_PARAMETER, ipAddress);
 
-	if(response == nullptr || response->isFailure()) {
-		spdlog::error("Failed to update IP address with error: {}", response != nullptr ? response->getErrorMessage() : "Invalid request.");
-		return false;
+		httpResponse = httpService->sendRequestAndWait(request);
+
+		if(httpResponse == nullptr || httpResponse->isFailure()) {
+			response.errorMessage = httpResponse != nullptr ? httpResponse->getErrorMessage() : "Invalid request.";
+		}
+		else {
+			response.completed = true;
+			response.statusCode = httpResponse->getStatusCode();
+
+			// viewed in place rather than copied, the response outlives the parsing below
+			const ByteBuffer * body = httpResponse->getBody();
+
+			if(body != nullptr) {
+				responseBody = std::string_view(reinterpret_cast<const char *>(body->getRawData()), body->getSize());
+			}
+		}
+	}
+
+	hostResult.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - requestStartTime);
+
+	processUpdateResponse(hostResult, response, responseBody);
+
+	return hostResult;
+}
+
+Task<NamecheapDynamicDNSUpdateReport::HostResult> NamecheapDynamicDNSService::sendUpdateRequestAsync(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const {
+	NamecheapDynamicDNSUpdateReport::HostResult hostResult;
+
+	if(!initializeHostResult(hostResult, host, domain, password, ipAddress)) {
+		co_return hostResult;
+	}
+
+	std::chrono::steady_clock::time_point requestStartTime(std::chrono::steady_clock::now());
+
+	HTTPSessionPool::QueryParameters queryParameters({
+		{ HOST_QUERY_PARAMETER, host },
+		{ DOMAIN_QUERY_PARAMETER, domain },
+		{ PASSWORD_QUERY_PARAMETER, password },
+		{ IP_ADDRESS_QUERY_PARAMETER, ipAddress }
+	});
+
+	HTTPSessionPool::Response response(co_await m_eventLoop->get(Utilities::joinPaths(m_baseURL, NAMECHEAP_DYNAMIC_DNS_UPDATE_PATH), queryParameters));
+
+	hostResult.duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - requestStartTime);
+
+	processUpdateResponse(hostResult, response, response.body);
+
+	co_return hostResult;
+}
+
+bool NamecheapDynamicDNSService::allowUpdateRequest(std::string_view host, std::string_view domain, std::string_view ipAddress, NamecheapDynamicDNSUpdateReport::HostResult & hostResult) const {
+	if(m_circuitBreaker->allowRequest()) {
+		return true;
 	}
 
-	if(response->isFailureStatusCode()) {
-		std::string statusCodeName(HTTPUtilities::getStatusCodeName(response->getStatusCode()));
-		spdlog::error("Failed to update IP address ({}{})!", response->getStatusCode(), statusCodeName.empty() ? "" : " " + statusCodeName);
+	hostResult.host = host;
+	hostResult.domain = domain;
+	hostResult.ipAddress = ipAddress;
+	hostResult.success = false;
+	hostResult.errorMessage = fmt::format("Circuit breaker for '{}' is open, request was not sent.", m_circuitBreaker->getName());
+	hostResult.errorClass = NamecheapDynamicDNSResponse::ErrorClass::Retryable;
+
+	return false;
+}
+
+std::optional<std::chrono::milliseconds> NamecheapDynamicDNSService::processUpdateAttempt(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult, size_t attempt) const {
+	// permanent errors are still answers from a healthy endpoint, only retryable errors count against it
+	if(hostResult.success || hostResult.errorClass != NamecheapDynamicDNSResponse::ErrorClass::Retryable) {
+		m_circuitBreaker->recordSuccess();
+		return {};
+	}
+
+	m_circuitBreaker->recordFailure();
+
+	if(!m_retryPolicy.shouldRetry(attempt)) {
+		return {};
+	}
+
+	std::chrono::milliseconds retryDelay(m_retryPolicy.getRetryDelay(attempt));
+
+	spdlog::debug("Retrying update for '{}.{}' in {} ms after attempt {} of {} failed with error: {}", hostResult.host, hostResult.domain, retryDelay.count(), attempt, m_retryPolicy.getMaximumAttempts(), hostResult.errorMessage);
+
+	return retryDelay;
+}
+
+NamecheapDynamicDNSUpdateReport::HostResult NamecheapDynamicDNSService::sendUpdateRequestWithRetries(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const {
+	NamecheapDynamicDNSUpdateReport::HostResult hostResult;
+	std::chrono::milliseconds totalDuration(0);
+	std::chrono::steady_clock::time_point updateStartTime(std::chrono::steady_clock::now());
+
+	for(size_t attempt = 1;; attempt++) {
+		// wait for a slot before consulting the circuit breaker, so that a half-open trial request is not held up behind the limit
+		if(m_rateLimiter != nullptr) {
+			ApplicationMetrics::updateRateLimitDelay.observeDuration(m_rateLimiter->acquire(domain));
+		}
+
+		if(!allowUpdateRequest(host, domain, ipAddress, hostResult)) {
+			break;
+		}
+
+		hostResult = sendUpdateRequest(host, domain, password, ipAddress);
+		hostResult.numberOfAttempts = attempt;
+		totalDuration += hostResult.duration;
+
+		std::optional<std::chrono::milliseconds> retryDelay(processUpdateAttempt(hostResult, attempt));
+
+		if(!retryDelay.has_value()) {
+			break;
+		}
+
+		std::this_thread::sleep_for(retryDelay.value());
+	}
+
+	hostResult.duration = totalDuration;
+
+	recordUpdateMetrics(hostResult, updateStartTime);
+
+	return hostResult;
+}
+
+Task<NamecheapDynamicDNSUpdateReport::HostResult> NamecheapDynamicDNSService::sendUpdateRequestWithRetriesAsync(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const {
+	NamecheapDynamicDNSUpdateReport::HostResult hostResult;
+	std::chrono::milliseconds totalDuration(0);
+	std::chrono::steady_clock::time_point updateStartTime(std::chrono::steady_clock::now());
+
+	for(size_t attempt = 1;; attempt++) {
+		// same sequence as the blocking version, except that every wait suspends the coroutine instead of its thread
+		if(m_rateLimiter != nullptr) {
+			ApplicationMetrics::updateRateLimitDelay.observeDuration(co_await m_rateLimiter->acquireAsync(domain, *m_eventLoop));
+		}
+
+		if(!allowUpdateRequest(host, domain, ipAddress, hostResult)) {
+			break;
+		}
+
+		hostResult = co_await sendUpdateRequestAsync(host, domain, password, ipAddress);
+		hostResult.numberOfAttempts = attempt;
+		totalDuration += hostResult.duration;
+
+		std::optional<std::chrono::milliseconds> retryDelay(processUpdateAttempt(hostResult, attempt));
+
+		if(!retryDelay.has_value()) {
+			break;
+		}
+
+		co_await m_eventLoop->sleepFor(retryDelay.value());
+	}
+
+	hostResult.duration = totalDuration;
+
+	recordUpdateMetrics(hostResult, updateStartTime);
+
+	co_return hostResult;
+}
+
+Task<void> NamecheapDynamicDNSService::dispatchUpdateAsync(const HostUpdate & hostUpdate, NamecheapDynamicDNSUpdateReport::HostResult & hostResult) const {
+	hostResult = co_await sendUpdateRequestWithRetriesAsync(hostUpdate.host, hostUpdate.domain, hostUpdate.password, hostUpdate.ipAddress);
+
+	if(m_updateJournal != nullptr) {
+		m_updateJournal->append(hostResult);
+	}
+}
+
+NamecheapDynamicDNSUpdateReport NamecheapDynamicDNSService::dispatchUpdates(const std::vector<HostUpdate> & hostUpdates) const {
+	if(hostUpdates.empty()) {
+		return {};
+	}
+
+	std::chrono::steady_clock::time_point dispatchStartTime(std::chrono::steady_clock::now());
+	std::vector<NamecheapDynamicDNSUpdateReport::HostResult> hostResults(hostUpdates.size());
+	std::atomic<size_t> nextHostUpdateIndex(0);
+
+	// each worker keeps exactly one request in flight, so the worker count is the in-flight limit
+	std::function<void()> dispatchWorker([this, &hostUpdates, &hostResults, &nextHostUpdateIndex]() {
+		for(size_t i = nextHostUpdateIndex++; i < hostUpdates.size(); i = nextHostUpdateIndex++) {
+			const HostUpdate & hostUpdate = hostUpdates[i];
+
+			hostResults[i] = sendUpdateRequestWithRetries(hostUpdate.host, hostUpdate.domain, hostUpdate.password, hostUpdate.ipAddress);
+
+			if(m_updateJournal != nullptr) {
+				m_updateJournal->append(hostResults[i]);
+			}
+		}
+	});
+
+	size_t numberOfWorkers = 0;
+
+	if(m_eventLoop != nullptr) {
+		// one coroutine per host on the calling thread, the event loop bounds how many of their requests are in flight at once
+		std::vector<Task<void>> updateTasks;
+		updateTasks.reserve(hostUpdates.size());
+
+		for(size_t i = 0; i < hostUpdates.size(); i++) {
+			updateTasks.push_back(dispatchUpdateAsync(hostUpdates[i], hostResults[i]));
+		}
+
+		m_eventLoop->run(updateTasks);
+
+		numberOfWorkers = std::min(m_eventLoop->getMaximumActiveRequests(), hostUpdates.size());
+	}
+	else {
+		numberOfWorkers = std::min(m_maximumConcurrentRequests.load(), hostUpdates.size());
+		std::vector<std::thread> workerThreads;
+		workerThreads.reserve(numberOfWorkers - 1);
+
+		for(size_t i = 1; i < numberOfWorkers; i++) {
+			workerThreads.emplace_back(dispatchWorker);
+		}
+
+		dispatchWorker();
+
+		for(std::thread & workerThread : workerThreads) {
+			workerThread.join();
+		}
+	}
+
+	// one sync per dispatch, the records appended by every request are on disk before their updates are considered confirmed
+	if(m_updateJournal != nullptr) {
+		m_updateJournal->sync();
+	}
+
+	NamecheapDynamicDNSUpdateReport report(std::move(hostResults));
+	report.setDuration(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - dispatchStartTime));
+
+	for(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult : report.getHostResults()) {
+		if(hostResult.success) {
+			ApplicationMetrics::recordSuccessfulUpdate(hostResult.domain);
+		}
+	}
+
+	for(const NamecheapDynamicDNSUpdateReport::HostResult * hostResult : report.getFailedHostResults()) {
+		spdlog::error("Failed to update '{}.{}' IP address to '{}' with {} error: {}", hostResult->host, hostResult->domain, hostResult->ipAddress, hostResult->errorClass == NamecheapDynamicDNSResponse::ErrorClass::Permanent ? "permanent" : "retryable", hostResult->errorMessage);
+	}
+
+	spdlog::debug("Sent {} Namecheap dynamic DNS update requests in {} ms with up to {} in flight.", report.numberOfHostResults(), report.getDuration().count(), numberOfWorkers);
+
+	return report;
+}
+
+NamecheapDynamicDNSUpdateReport NamecheapDynamicDNSService::setIPAddress(const NamecheapDomainProfileCollection & domainProfiles, std::string_view ipAddress, bool force) {
+	if(getIPAddressType(ipAddress) == IPAddressService::IPAddressType::V6) {
+		return setIPAddress(domainProfiles, {}, ipAddress, force);
+	}
+
+	return setIPAddress(domainProfiles, ipAddress, {}, force);
+}
+
+void NamecheapDynamicDNSService::rebuildHostTable(const NamecheapDomainProfileCollection & domainProfiles) {
+	m_hostTable->rebuild(domainProfiles);
+
+	if(m_ipAddressCache == nullptr && m_suspendedHosts.empty() && m_retriedHosts.empty()) {
+		return;
+	}
+
+	std::vector<NamecheapUpdatePlanner::WorkItem> retries;
+
+	const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfileList = domainProfiles.getDomainProfiles();
+	const std::vector<uint32_t> & domainProfileIndices = m_hostTable->getDomainProfileIndices();
+	const std::vector<uint32_t> & hostIndices = m_hostTable->getHostIndices();
+
+	for(size_t i = 0; i < m_hostTable->numberOfHosts(); i++) {
+		const NamecheapDomainProfile & domainProfile = *domainProfileList[domainProfileIndices[i]];
+		std::string_view host(domainProfile.getHost(hostIndices[i]));
+
+		for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+			if(m_ipAddressCache != nullptr) {
+				const NamecheapIPAddressCache::Entry * cacheEntry = m_ipAddressCache->getEntry(host, domainProfile.getDomain(), ipAddressType);
+
+				if(cacheEntry != nullptr) {
+					m_hostTable->setLastIPAddressIndex(i, ipAddressType, m_hostTable->addIPAddress(cacheEntry->ipAddress));
+					m_hostTable->setLastUpdatedTime(i, ipAddressType, cacheEntry->lastUpdatedTimestamp);
+				}
+			}
+
+			if(isHostSuspended(host, domainProfile.getDomain(), domainProfile.getPassword(), ipAddressType)) {
+				m_hostTable->setSuspended(i, ipAddressType, true);
+			}
+
+			if(!m_retriedHosts.empty() && m_retriedHosts.contains(getHostKey(host, domainProfile.getDomain(), ipAddressType))) {
+				retries.push_back({ static_cast<uint32_t>(i), ipAddressType });
+			}
+		}
+	}
+
+	if(retries.empty()) {
+		return;
+	}
+
+	// retries are tracked by row, so the planner is reset against the rebuilt table before they are carried over
+	m_updatePlanner->reset(*m_hostTable);
+
+	for(const NamecheapUpdatePlanner::WorkItem & retry : retries) {
+		m_updatePlanner->markDirty(retry.row, retry.ipAddressType, true);
+	}
+}
+
+void NamecheapDynamicDNSService::applyForcedUpdates(const NamecheapDomainProfileCollection & domainProfiles) {
+	if(!m_updatePlanner->isBuiltFrom(*m_hostTable)) {
+		m_updatePlanner->reset(*m_hostTable);
+	}
+
+	const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfileList = domainProfiles.getDomainProfiles();
+	std::vector<bool> forcedDomainProfiles(domainProfileList.size(), false);
+
+	for(size_t i = 0; i < domainProfileList.size(); i++) {
+		forcedDomainProfiles[i] = m_forcedDomains.contains(Utilities::toLowerCase(domainProfileList[i]->getDomain()));
+	}
+
+	m_forcedDomains.clear();
+
+	const std::vector<uint32_t> & domainProfileIndices = m_hostTable->getDomainProfileIndices();
+	const std::vector<uint32_t> & hostIndices = m_hostTable->getHostIndices();
+
+	for(size_t i = 0; i < m_hostTable->numberOfHosts(); i++) {
+		if(!forcedDomainProfiles[domainProfileIndices[i]]) {
+			continue;
+		}
+
+		const NamecheapDomainProfile & domainProfile = *domainProfileList[domainProfileIndices[i]];
+
+		for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+			if(m_hostTable->isSuspended(i, ipAddressType)) {
+				m_suspendedHosts.erase(getHostKey(domainProfile.getHost(hostIndices[i]), domainProfile.getDomain(), ipAddressType));
+				m_updatePlanner->clearSuspended(*m_hostTable, i, ipAddressType);
+			}
+
+			m_updatePlanner->markDirty(i, ipAddressType, true);
+		}
+	}
+}
+
+NamecheapDynamicDNSUpdateReport NamecheapDynamicDNSService::setIPAddress(const NamecheapDomainProfileCollection & domainProfiles, std::string_view ipv4Address, std::string_view ipv6Address, bool force) {
+	if(!m_hostTable->isBuiltFrom(domainProfiles)) {
+		rebuildHostTable(domainProfiles);
+	}
+
+	if(!m_forcedDomains.empty()) {
+		applyForcedUpdates(domainProfiles);
+	}
+
+	// without a cache every host is sent the current ip address on each cycle, as nothing records what it was last updated to
+	if(!force && m_ipAddressCache == nullptr) {
+		m_updatePlanner->markAllDirty(true);
+	}
+
+	NamecheapUpdatePlanner::Plan plan(m_updatePlanner->planCycle(*m_hostTable, m_hostTable->addIPAddress(ipv4Address), m_hostTable->addIPAddress(ipv6Address), std::chrono::system_clock::now(), force));
+	size_t numberOfSkippedUpdates = plan.numberOfSkippedUpdates;
+	size_t numberOfSuspendedUpdates = plan.numberOfSuspendedUpdates;
+	std::vector<HostUpdate> hostUpdates;
+	hostUpdates.reserve(plan.workItems.size());
+	const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfileList = domainProfiles.getDomainProfiles();
+	const std::vector<uint32_t> & domainProfileIndices = m_hostTable->getDomainProfileIndices();
+	const std::vector<uint32_t> & hostIndices = m_hostTable->getHostIndices();
+
+	// profiles are only visited for hosts which actually need an update
+	for(const NamecheapUpdatePlanner::WorkItem & workItem : plan.workItems) {
+		const NamecheapDomainProfile & domainProfile = *domainProfileList[domainProfileIndices[workItem.row]];
+
+		hostUpdates.push_back({ domainProfile.getHost(hostIndices[workItem.row]), domainProfile.getDomain(), domainProfile.getPassword(), workItem.ipAddressType == IPAddressService::IPAddressType::V6 ? ipv6Address : ipv4Address });
+	}
+
+	ApplicationMetrics::skippedUpdates.increment(numberOfSkippedUpdates);
+
+	if(numberOfSkippedUpdates != 0) {
+		spdlog::debug("Skipping {} Namecheap domain host updates which already point to the current IP address.", numberOfSkippedUpdates);
+	}
+
+	if(numberOfSuspendedUpdates != 0) {
+		spdlog::warn("Skipping {} Namecheap domain host updates which previously failed with a permanent error, fix their domain profiles to resume updating them.", numberOfSuspendedUpdates);
+	}
+
+	NamecheapDynamicDNSUpdateReport report(dispatchUpdates(hostUpdates));
+	report.setNumberOfSkippedUpdates(numberOfSkippedUpdates);
+	report.setNumberOfSuspendedUpdates(numberOfSuspendedUpdates);
+
+	std::chrono::system_clock::time_point currentTime(std::chrono::system_clock::now());
+
+	// host results are in the same order as the work items they were sent for
+	for(size_t i = 0; i < report.numberOfHostResults(); i++) {
+		const NamecheapDynamicDNSUpdateReport::HostResult & hostResult = report.getHostResults()[i];
+		const NamecheapUpdatePlanner::WorkItem & workItem = plan.workItems[i];
+		IPAddressService::IPAddressType ipAddressType = workItem.ipAddressType;
+
+		if(hostResult.success) {
+			m_updatePlanner->recordSuccess(*m_hostTable, workItem, currentTime);
+
+			if(!m_retriedHosts.empty()) {
+				m_retriedHosts.erase(getHostKey(hostResult.host, hostResult.domain, ipAddressType));
+			}
+		}
+		else if(hostResult.errorClass != NamecheapDynamicDNSResponse::ErrorClass::Permanent) {
+			m_retriedHosts.insert(getHostKey(hostResult.host, hostResult.domain, ipAddressType));
+			m_updatePlanner->recordFailure(*m_hostTable, workItem, false);
+		}
+		else {
+			m_retriedHosts.erase(getHostKey(hostResult.host, hostResult.domain, ipAddressType));
+			m_suspendedHosts[getHostKey(hostResult.host, hostResult.domain, ipAddressType)] = hostUpdates[i].password;
+			m_updatePlanner->recordFailure(*m_hostTable, workItem, true);
+
+			spdlog::error("Suspending {} updates for '{}.{}' until its domain profile is changed.", ipAddressType == IPAddressService::IPAddressType::V6 ? "IPv6" : "IPv4", hostResult.host, hostResult.domain);
+		}
+	}
+
+	if(m_ipAddressCache != nullptr) {
+		for(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult : report.getHostResults()) {
+			if(hostResult.success) {
+				m_ipAddressCache->setIPAddress(hostResult.host, hostResult.domain, hostResult.ipAddress);
+			}
+		}
+
+		// the journal holds every confirmed update until it is compacted, so the cache file is only rewritten once the journal grows past its threshold
+		if(m_updateJournal != nullptr) {
+			if(m_updateJournal->needsCompaction()) {
+				m_updateJournal->compact(*m_ipAddressCache);
+			}
+		}
+		else if(m_ipAddressCache->isModified() && !m_ipAddressCache->save()) {
+			spdlog::warn("Failed to save Namecheap IP address cache to file '{}'.", m_ipAddressCache->getFilePath());
+		}
+	}
+
+	return report;
+}
+
+bool NamecheapDynamicDNSService::setIPAddress(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) {
+	NamecheapDynamicDNSUpdateReport::HostResult hostResult(sendUpdateRequestWithRetries(host, domain, password, ipAddress));
+
+	if(!hostResult.success) {
+		spdlog::error("Failed to update IP address with error: {}", hostResult.errorMessage);
 		return false;
 	}
 
@@ -72,13 +787,17 @@ bool NamecheapDynamicDNSService::setIPAddress(const std::vector<std::string> & h
 		return false;
 	}
 
-	bool allIPAddressesSet = true;
+	std::vector<HostUpdate> hostUpdates;
+	hostUpdates.reserve(hosts.size());
+	std::unordered_set<std::string_view> updatedHosts;
+	updatedHosts.reserve(hosts.size());
 
+	// only drops exact duplicates, hosts from domain profiles are already unique since profiles drop repeated hosts when they are constructed
 	for(const std::string & host : hosts) {
-		if(!setIPAddress(host, domain, password, ipAddress)) {
-			allIPAddressesSet = false;
+		if(updatedHosts.insert(host).second) {
+			hostUpdates.push_back({ host, domain, password, ipAddress });
 		}
 	}
 
-	return allIPAddressesSet;
+	return dispatchUpdates(hostUpdates).isSuccessful();
 }
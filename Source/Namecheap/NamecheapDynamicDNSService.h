@@ -1,21 +1,124 @@
 #ifndef _NAMECHEAP_DYNAMIC_DNS_SERVICE_H_
 #define _NAMECHEAP_DYNAMIC_DNS_SERVICE_H_
 
+#include "NamecheapDynamicDNSUpdateReport.h"
+#include "Network/RetryPolicy.h"
+#include "Scheduling/Task.h"
+
+#include <Network/IPAddressService.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
+class CircuitBreaker;
+class ExternalIPAddressResolver;
+class HTTPEventLoop;
+class HTTPSessionPool;
+class NamecheapDomainProfileCollection;
+class NamecheapHostTable;
+class NamecheapIPAddressCache;
+class NamecheapUpdateJournal;
+class NamecheapUpdatePlanner;
+class RateLimiter;
+
 class NamecheapDynamicDNSService final {
 public:
 	NamecheapDynamicDNSService();
 	~NamecheapDynamicDNSService();
 
+	const std::string & getBaseURL() const;
+	void setBaseURL(const std::string & baseURL);
+	const RetryPolicy & getRetryPolicy() const;
+	void setRetryPolicy(const RetryPolicy & retryPolicy);
+	CircuitBreaker & getCircuitBreaker() const;
+	std::shared_ptr<HTTPSessionPool> getHTTPSessionPool() const;
+	void setHTTPSessionPool(std::shared_ptr<HTTPSessionPool> sessionPool);
+	std::shared_ptr<HTTPEventLoop> getHTTPEventLoop() const;
+	void setHTTPEventLoop(std::shared_ptr<HTTPEventLoop> eventLoop);
+	std::shared_ptr<ExternalIPAddressResolver> getIPAddressResolver(IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	void setIPAddressResolver(std::shared_ptr<ExternalIPAddressResolver> ipAddressResolver, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4);
+	size_t getMaximumConcurrentRequests() const;
+	void setMaximumConcurrentRequests(size_t maximumConcurrentRequests);
+	std::shared_ptr<RateLimiter> getRateLimiter() const;
+	void setRateLimiter(std::shared_ptr<RateLimiter> rateLimiter);
+	std::shared_ptr<NamecheapIPAddressCache> getIPAddressCache() const;
+	void setIPAddressCache(std::shared_ptr<NamecheapIPAddressCache> ipAddressCache);
+	std::chrono::seconds getForcedRefreshInterval() const;
+	void setForcedRefreshInterval(std::chrono::seconds forcedRefreshInterval);
+	std::shared_ptr<NamecheapUpdateJournal> getUpdateJournal() const;
+	void setUpdateJournal(std::shared_ptr<NamecheapUpdateJournal> updateJournal);
+	size_t numberOfSuspendedHosts() const;
+	bool isHostSuspended(std::string_view host, std::string_view domain, std::string_view password, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	void clearSuspendedHosts();
+	// the hosts of these domain profiles are updated on the next cycle even if their ip address is unchanged or they are suspended, every other host keeps its state
+	void forceUpdate(const NamecheapDomainProfileCollection & domainProfiles);
+
+	NamecheapDynamicDNSUpdateReport updateIPAddress(const NamecheapDomainProfileCollection & domainProfiles, bool force = false);
 	bool updateIPAddress(const std::vector<std::string> & hosts, std::string_view domainName, std::string_view password);
 	bool updateIPAddress(std::string_view host, std::string_view domain, std::string_view password);
+	NamecheapDynamicDNSUpdateReport setIPAddress(const NamecheapDomainProfileCollection & domainProfiles, std::string_view ipAddress, bool force = false);
+	NamecheapDynamicDNSUpdateReport setIPAddress(const NamecheapDomainProfileCollection & domainProfiles, std::string_view ipv4Address, std::string_view ipv6Address, bool force = false);
 	bool setIPAddress(const std::vector<std::string> & hosts, std::string_view domainName, std::string_view password, std::string_view ipAddress);
 	bool setIPAddress(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress);
 
+	static const std::string DEFAULT_BASE_URL;
+	static const size_t DEFAULT_MAXIMUM_CONCURRENT_REQUESTS;
+
 private:
+	struct HostUpdate {
+		std::string_view host;
+		std::string_view domain;
+		std::string_view password;
+		std::string_view ipAddress;
+	};
+
+	static IPAddressService::IPAddressType getIPAddressType(std::string_view ipAddress);
+	static std::string getHostKey(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType);
+	std::string lookupIPAddress(IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	NamecheapDynamicDNSUpdateReport::HostResult sendUpdateRequest(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const;
+	NamecheapDynamicDNSUpdateReport::HostResult sendUpdateRequestWithRetries(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const;
+	// fills in the host result when the circuit breaker is open, in which case no request should be sent
+	bool allowUpdateRequest(std::string_view host, std::string_view domain, std::string_view ipAddress, NamecheapDynamicDNSUpdateReport::HostResult & hostResult) const;
+	// shared by the blocking and asynchronous retry loops, records an attempt with the circuit breaker and returns how long to wait before retrying, or no value once finished
+	std::optional<std::chrono::milliseconds> processUpdateAttempt(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult, size_t attempt) const;
+	Task<NamecheapDynamicDNSUpdateReport::HostResult> sendUpdateRequestAsync(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const;
+	Task<NamecheapDynamicDNSUpdateReport::HostResult> sendUpdateRequestWithRetriesAsync(std::string_view host, std::string_view domain, std::string_view password, std::string_view ipAddress) const;
+	Task<void> dispatchUpdateAsync(const HostUpdate & hostUpdate, NamecheapDynamicDNSUpdateReport::HostResult & hostResult) const;
+	NamecheapDynamicDNSUpdateReport dispatchUpdates(const std::vector<HostUpdate> & hostUpdates) const;
+	// seeds the rebuilt table with each host's cached ip addresses and suspensions, so that planning a cycle needs no further lookups
+	void rebuildHostTable(const NamecheapDomainProfileCollection & domainProfiles);
+	void applyForcedUpdates(const NamecheapDomainProfileCollection & domainProfiles);
+
+	std::string m_baseURL;
+	RetryPolicy m_retryPolicy;
+	std::unique_ptr<CircuitBreaker> m_circuitBreaker;
+	std::shared_ptr<HTTPSessionPool> m_sessionPool;
+	// when set, updates are sent as coroutines on this event loop instead of from a pool of blocking worker threads
+	std::shared_ptr<HTTPEventLoop> m_eventLoop;
+	std::shared_ptr<ExternalIPAddressResolver> m_ipAddressResolver;
+	std::shared_ptr<ExternalIPAddressResolver> m_ipv6AddressResolver;
+	std::atomic<size_t> m_maximumConcurrentRequests;
+	std::shared_ptr<RateLimiter> m_rateLimiter;
+	std::shared_ptr<NamecheapIPAddressCache> m_ipAddressCache;
+	std::shared_ptr<NamecheapUpdateJournal> m_updateJournal;
+	// hosts which failed permanently for an address family, mapped to the password they failed with, so that editing a profile lifts the suspension
+	std::unordered_map<std::string, std::string> m_suspendedHosts;
+	// hosts whose last update failed with a retryable error, so that they are still retried after the host table is rebuilt
+	std::unordered_set<std::string> m_retriedHosts;
+	// lower case domains of profiles queued by forceUpdate for the next cycle
+	std::unordered_set<std::string> m_forcedDomains;
+	// mirrors the ip address cache and suspended hosts for the most recently updated collection
+	std::unique_ptr<NamecheapHostTable> m_hostTable;
+	// tracks which rows of the host table need an update, so that a cycle with an unchanged ip address visits no hosts
+	std::unique_ptr<NamecheapUpdatePlanner> m_updatePlanner;
+
 	NamecheapDynamicDNSService(const NamecheapDynamicDNSService &) = delete;
 	const NamecheapDynamicDNSService & operator = (const NamecheapDynamicDNSService &) = delete;
 };
@@ -0,0 +1,136 @@
+#include "NamecheapDynamicDNSUpdateReport.h"
+
+#include <algorithm>
+#include <iterator>
+
+NamecheapDynamicDNSUpdateReport::NamecheapDynamicDNSUpdateReport()
+	: m_numberOfSkippedUpdates(0)
+	, m_numberOfSuspendedUpdates(0)
+	, m_duration(0) { }
+
+NamecheapDynamicDNSUpdateReport::NamecheapDynamicDNSUpdateReport(std::vector<HostResult> && hostResults)
+	: m_hostResults(std::move(hostResults))
+	, m_numberOfSkippedUpdates(0)
+	, m_numberOfSuspendedUpdates(0)
+	, m_duration(0) { }
+
+NamecheapDynamicDNSUpdateReport::NamecheapDynamicDNSUpdateReport(NamecheapDynamicDNSUpdateReport && report) noexcept
+	: m_hostResults(std::move(report.m_hostResults))
+	, m_numberOfSkippedUpdates(report.m_numberOfSkippedUpdates)
+	, m_numberOfSuspendedUpdates(report.m_numberOfSuspendedUpdates)
+	, m_duration(report.m_duration) { }
+
+NamecheapDynamicDNSUpdateReport::NamecheapDynamicDNSUpdateReport(const NamecheapDynamicDNSUpdateReport & report)
+	: m_hostResults(report.m_hostResults)
+	, m_numberOfSkippedUpdates(report.m_numberOfSkippedUpdates)
+	, m_numberOfSuspendedUpdates(report.m_numberOfSuspendedUpdates)
+	, m_duration(report.m_duration) { }
+
+NamecheapDynamicDNSUpdateReport & NamecheapDynamicDNSUpdateReport::operator = (NamecheapDynamicDNSUpdateReport && report) noexcept {
+	if(this != &report) {
+		m_hostResults = std::move(report.m_hostResults);
+		m_numberOfSkippedUpdates = report.m_numberOfSkippedUpdates;
+		m_numberOfSuspendedUpdates = report.m_numberOfSuspendedUpdates;
+		m_duration = report.m_duration;
+	}
+
+	return *this;
+}
+
+NamecheapDynamicDNSUpdateReport & NamecheapDynamicDNSUpdateReport::operator = (const NamecheapDynamicDNSUpdateReport & report) {
+	m_hostResults = report.m_hostResults;
+	m_numberOfSkippedUpdates = report.m_numberOfSkippedUpdates;
+	m_numberOfSuspendedUpdates = report.m_numberOfSuspendedUpdates;
+	m_duration = report.m_duration;
+
+	return *this;
+}
+
+NamecheapDynamicDNSUpdateReport::~NamecheapDynamicDNSUpdateReport() = default;
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfHostResults() const {
+	return m_hostResults.size();
+}
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfSuccessfulUpdates() const {
+	return std::count_if(m_hostResults.cbegin(), m_hostResults.cend(), [](const HostResult & hostResult) {
+		return hostResult.success;
+	});
+}
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfFailedUpdates() const {
+	return m_hostResults.size() - numberOfSuccessfulUpdates();
+}
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfSkippedUpdates() const {
+	return m_numberOfSkippedUpdates;
+}
+
+void NamecheapDynamicDNSUpdateReport::setNumberOfSkippedUpdates(size_t numberOfSkippedUpdates) {
+	m_numberOfSkippedUpdates = numberOfSkippedUpdates;
+}
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfSuspendedUpdates() const {
+	return m_numberOfSuspendedUpdates;
+}
+
+void NamecheapDynamicDNSUpdateReport::setNumberOfSuspendedUpdates(size_t numberOfSuspendedUpdates) {
+	m_numberOfSuspendedUpdates = numberOfSuspendedUpdates;
+}
+
+size_t NamecheapDynamicDNSUpdateReport::numberOfPermanentFailures() const {
+	return std::count_if(m_hostResults.cbegin(), m_hostResults.cend(), [](const HostResult & hostResult) {
+		return !hostResult.success && hostResult.errorClass == NamecheapDynamicDNSResponse::ErrorClass::Permanent;
+	});
+}
+
+const NamecheapDynamicDNSUpdateReport::HostResult * NamecheapDynamicDNSUpdateReport::getHostResult(size_t index) const {
+	if(index >= m_hostResults.size()) {
+		return nullptr;
+	}
+
+	return &m_hostResults[index];
+}
+
+const std::vector<NamecheapDynamicDNSUpdateReport::HostResult> & NamecheapDynamicDNSUpdateReport::getHostResults() const {
+	return m_hostResults;
+}
+
+std::vector<const NamecheapDynamicDNSUpdateReport::HostResult *> NamecheapDynamicDNSUpdateReport::getFailedHostResults() const {
+	std::vector<const HostResult *> failedHostResults;
+
+	for(const HostResult & hostResult : m_hostResults) {
+		if(!hostResult.success) {
+			failedHostResults.push_back(&hostResult);
+		}
+	}
+
+	return failedHostResults;
+}
+
+void NamecheapDynamicDNSUpdateReport::addHostResult(HostResult && hostResult) {
+	m_hostResults.emplace_back(std::move(hostResult));
+}
+
+void NamecheapDynamicDNSUpdateReport::addHostResults(NamecheapDynamicDNSUpdateReport && report) {
+	m_hostResults.reserve(m_hostResults.size() + report.m_hostResults.size());
+	std::move(report.m_hostResults.begin(), report.m_hostResults.end(), std::back_inserter(m_hostResults));
+	m_numberOfSkippedUpdates += report.m_numberOfSkippedUpdates;
+	m_numberOfSuspendedUpdates += report.m_numberOfSuspendedUpdates;
+	m_duration += report.m_duration;
+	report.m_hostResults.clear();
+	report.m_numberOfSkippedUpdates = 0;
+	report.m_numberOfSuspendedUpdates = 0;
+}
+
+std::chrono::milliseconds NamecheapDynamicDNSUpdateReport::getDuration() const {
+	return m_duration;
+}
+
+void NamecheapDynamicDNSUpdateReport::setDuration(std::chrono::milliseconds duration) {
+	m_duration = duration;
+}
+
+bool NamecheapDynamicDNSUpdateReport::isSuccessful() const {
+	return (!m_hostResults.empty() || m_numberOfSkippedUpdates != 0) && numberOfFailedUpdates() == 0;
+}
@@ -0,0 +1,57 @@
+#ifndef _NAMECHEAP_DYNAMIC_DNS_UPDATE_REPORT_H_
+#define _NAMECHEAP_DYNAMIC_DNS_UPDATE_REPORT_H_
+
+#include "NamecheapDynamicDNSResponse.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class NamecheapDynamicDNSUpdateReport final {
+public:
+	struct HostResult {
+		std::string host;
+		std::string domain;
+		std::string ipAddress;
+		bool success = false;
+		uint16_t statusCode = 0;
+		std::string errorMessage;
+		NamecheapDynamicDNSResponse::ErrorClass errorClass = NamecheapDynamicDNSResponse::ErrorClass::None;
+		std::chrono::milliseconds duration = std::chrono::milliseconds(0);
+		size_t numberOfAttempts = 0;
+	};
+
+	NamecheapDynamicDNSUpdateReport();
+	NamecheapDynamicDNSUpdateReport(std::vector<HostResult> && hostResults);
+	NamecheapDynamicDNSUpdateReport(NamecheapDynamicDNSUpdateReport && report) noexcept;
+	NamecheapDynamicDNSUpdateReport(const NamecheapDynamicDNSUpdateReport & report);
+	NamecheapDynamicDNSUpdateReport & operator = (NamecheapDynamicDNSUpdateReport && report) noexcept;
+	NamecheapDynamicDNSUpdateReport & operator = (const NamecheapDynamicDNSUpdateReport & report);
+	~NamecheapDynamicDNSUpdateReport();
+
+	size_t numberOfHostResults() const;
+	size_t numberOfSuccessfulUpdates() const;
+	size_t numberOfFailedUpdates() const;
+	size_t numberOfSkippedUpdates() const;
+	void setNumberOfSkippedUpdates(size_t numberOfSkippedUpdates);
+	size_t numberOfSuspendedUpdates() const;
+	void setNumberOfSuspendedUpdates(size_t numberOfSuspendedUpdates);
+	size_t numberOfPermanentFailures() const;
+	const HostResult * getHostResult(size_t index) const;
+	const std::vector<HostResult> & getHostResults() const;
+	std::vector<const HostResult *> getFailedHostResults() const;
+	void addHostResult(HostResult && hostResult);
+	void addHostResults(NamecheapDynamicDNSUpdateReport && report);
+	std::chrono::milliseconds getDuration() const;
+	void setDuration(std::chrono::milliseconds duration);
+	bool isSuccessful() const;
+
+private:
+	std::vector<HostResult> m_hostResults;
+	size_t m_numberOfSkippedUpdates;
+	size_t m_numberOfSuspendedUpdates;
+	std::chrono::milliseconds m_duration;
+};
+
+#endif // _NAMECHEAP_DYNAMIC_DNS_UPDATE_REPORT_H_
@@ -0,0 +1,179 @@
+#include "NamecheapHostTable.h"
+
+#include "NamecheapDomainProfileCollection.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <limits>
+
+const uint32_t NamecheapHostTable::NO_IP_ADDRESS = std::numeric_limits<uint32_t>::max();
+
+NamecheapHostTable::NamecheapHostTable()
+	: m_domainProfileCollectionRevision(0) { }
+
+NamecheapHostTable::~NamecheapHostTable() = default;
+
+bool NamecheapHostTable::isBuiltFrom(const NamecheapDomainProfileCollection & domainProfiles) const {
+	return m_domainProfileCollectionRevision == domainProfiles.getRevision();
+}
+
+uint64_t NamecheapHostTable::getDomainProfileCollectionRevision() const {
+	return m_domainProfileCollectionRevision;
+}
+
+void NamecheapHostTable::rebuild(const NamecheapDomainProfileCollection & domainProfiles) {
+	clear();
+
+	const std::vector<std::shared_ptr<NamecheapDomainProfile>> & domainProfileList = domainProfiles.getDomainProfiles();
+	size_t numberOfHosts = 0;
+
+	for(const std::shared_ptr<NamecheapDomainProfile> & domainProfile : domainProfileList) {
+		if(domainProfile != nullptr) {
+			numberOfHosts += domainProfile->numberOfHosts();
+		}
+	}
+
+	m_domainProfileIndices.reserve(numberOfHosts);
+	m_hostIndices.reserve(numberOfHosts);
+	m_hostAddressFamilies.reserve(numberOfHosts);
+
+	for(size_t i = 0; i < domainProfileList.size(); i++) {
+		const std::shared_ptr<NamecheapDomainProfile> & domainProfile = domainProfileList[i];
+
+		if(domainProfile == nullptr) {
+			continue;
+		}
+
+		for(size_t j = 0; j < domainProfile->numberOfHosts(); j++) {
+			m_domainProfileIndices.push_back(static_cast<uint32_t>(i));
+			m_hostIndices.push_back(static_cast<uint32_t>(j));
+			m_hostAddressFamilies.push_back(domainProfile->getHostAddressFamily(j));
+		}
+	}
+
+	m_lastIPv4AddressIndices.assign(numberOfHosts, NO_IP_ADDRESS);
+	m_lastIPv6AddressIndices.assign(numberOfHosts, NO_IP_ADDRESS);
+	m_lastIPv4UpdatedTimes.assign(numberOfHosts, std::chrono::system_clock::time_point::min());
+	m_lastIPv6UpdatedTimes.assign(numberOfHosts, std::chrono::system_clock::time_point::min());
+	m_hostStates.assign(numberOfHosts, static_cast<uint8_t>(HostState::None));
+	m_domainProfileCollectionRevision = domainProfiles.getRevision();
+}
+
+void NamecheapHostTable::clear() {
+	m_domainProfileCollectionRevision = 0;
+	m_domainProfileIndices.clear();
+	m_hostIndices.clear();
+	m_hostAddressFamilies.clear();
+	m_lastIPv4AddressIndices.clear();
+	m_lastIPv6AddressIndices.clear();
+	m_lastIPv4UpdatedTimes.clear();
+	m_lastIPv6UpdatedTimes.clear();
+	m_hostStates.clear();
+	m_ipAddresses.clear();
+	m_ipAddressIndices.clear();
+}
+
+size_t NamecheapHostTable::numberOfHosts() const {
+	return m_domainProfileIndices.size();
+}
+
+const std::vector<uint32_t> & NamecheapHostTable::getDomainProfileIndices() const {
+	return m_domainProfileIndices;
+}
+
+const std::vector<uint32_t> & NamecheapHostTable::getHostIndices() const {
+	return m_hostIndices;
+}
+
+const std::vector<NamecheapDomainProfile::AddressFamily> & NamecheapHostTable::getHostAddressFamilies() const {
+	return m_hostAddressFamilies;
+}
+
+const std::vector<uint32_t> & NamecheapHostTable::getLastIPAddressIndices(IPAddressService::IPAddressType ipAddressType) const {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? m_lastIPv6AddressIndices : m_lastIPv4AddressIndices;
+}
+
+void NamecheapHostTable::setLastIPAddressIndex(size_t row, IPAddressService::IPAddressType ipAddressType, uint32_t ipAddressIndex) {
+	std::vector<uint32_t> & lastIPAddressIndices = ipAddressType == IPAddressService::IPAddressType::V6 ? m_lastIPv6AddressIndices : m_lastIPv4AddressIndices;
+
+	if(row >= lastIPAddressIndices.size()) {
+		return;
+	}
+
+	lastIPAddressIndices[row] = ipAddressIndex;
+}
+
+const std::vector<std::chrono::system_clock::time_point> & NamecheapHostTable::getLastUpdatedTimes(IPAddressService::IPAddressType ipAddressType) const {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? m_lastIPv6UpdatedTimes : m_lastIPv4UpdatedTimes;
+}
+
+void NamecheapHostTable::setLastUpdatedTime(size_t row, IPAddressService::IPAddressType ipAddressType, std::chrono::system_clock::time_point lastUpdatedTime) {
+	std::vector<std::chrono::system_clock::time_point> & lastUpdatedTimes = ipAddressType == IPAddressService::IPAddressType::V6 ? m_lastIPv6UpdatedTimes : m_lastIPv4UpdatedTimes;
+
+	if(row >= lastUpdatedTimes.size()) {
+		return;
+	}
+
+	lastUpdatedTimes[row] = lastUpdatedTime;
+}
+
+bool NamecheapHostTable::isSuspended(size_t row, IPAddressService::IPAddressType ipAddressType) const {
+	if(row >= m_hostStates.size()) {
+		return false;
+	}
+
+	return (m_hostStates[row] & static_cast<uint8_t>(getSuspendedState(ipAddressType))) != 0;
+}
+
+void NamecheapHostTable::setSuspended(size_t row, IPAddressService::IPAddressType ipAddressType, bool suspended) {
+	if(row >= m_hostStates.size()) {
+		return;
+	}
+
+	if(suspended) {
+		m_hostStates[row] |= static_cast<uint8_t>(getSuspendedState(ipAddressType));
+	}
+	else {
+		m_hostStates[row] &= ~static_cast<uint8_t>(getSuspendedState(ipAddressType));
+	}
+}
+
+void NamecheapHostTable::clearSuspended() {
+	m_hostStates.assign(m_hostStates.size(), static_cast<uint8_t>(HostState::None));
+}
+
+size_t NamecheapHostTable::numberOfIPAddresses() const {
+	return m_ipAddresses.size();
+}
+
+std::string_view NamecheapHostTable::getIPAddress(uint32_t ipAddressIndex) const {
+	if(ipAddressIndex >= m_ipAddresses.size()) {
+		return {};
+	}
+
+	return m_ipAddresses[ipAddressIndex];
+}
+
+uint32_t NamecheapHostTable::addIPAddress(std::string_view ipAddress) {
+	if(ipAddress.empty()) {
+		return NO_IP_ADDRESS;
+	}
+
+	// ip addresses compare case insensitively, so they are stored in one canonical case
+	std::string formattedIPAddress(Utilities::toLowerCase(std::string(ipAddress)));
+	std::unordered_map<std::string, uint32_t>::const_iterator ipAddressIndexIterator(m_ipAddressIndices.find(formattedIPAddress));
+
+	if(ipAddressIndexIterator != m_ipAddressIndices.cend()) {
+		return ipAddressIndexIterator->second;
+	}
+
+	uint32_t ipAddressIndex = static_cast<uint32_t>(m_ipAddresses.size());
+	m_ipAddresses.push_back(formattedIPAddress);
+	m_ipAddressIndices.emplace(std::move(formattedIPAddress), ipAddressIndex);
+
+	return ipAddressIndex;
+}
+
+NamecheapHostTable::HostState NamecheapHostTable::getSuspendedState(IPAddressService::IPAddressType ipAddressType) {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? HostState::IPv6Suspended : HostState::IPv4Suspended;
+}
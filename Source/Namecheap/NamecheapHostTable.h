@@ -0,0 +1,76 @@
+#ifndef _NAMECHEAP_HOST_TABLE_H_
+#define _NAMECHEAP_HOST_TABLE_H_
+
+#include "NamecheapDomainProfile.h"
+
+#include <Network/IPAddressService.h>
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class NamecheapDomainProfileCollection;
+
+// every host of a domain profile collection flattened into parallel arrays, one row per host, so that planning an update cycle walks a few contiguous arrays
+// and compares integers rather than visiting each profile and hashing a key per host, last ip addresses are stored as indices into a small table of distinct addresses
+class NamecheapHostTable final {
+public:
+	NamecheapHostTable();
+	~NamecheapHostTable();
+
+	// false once the collection has been modified or when the table was built from a different collection
+	bool isBuiltFrom(const NamecheapDomainProfileCollection & domainProfiles) const;
+	// zero when the table is empty
+	uint64_t getDomainProfileCollectionRevision() const;
+	void rebuild(const NamecheapDomainProfileCollection & domainProfiles);
+	void clear();
+	size_t numberOfHosts() const;
+
+	const std::vector<uint32_t> & getDomainProfileIndices() const;
+	const std::vector<uint32_t> & getHostIndices() const;
+	const std::vector<NamecheapDomainProfile::AddressFamily> & getHostAddressFamilies() const;
+	const std::vector<uint32_t> & getLastIPAddressIndices(IPAddressService::IPAddressType ipAddressType) const;
+	void setLastIPAddressIndex(size_t row, IPAddressService::IPAddressType ipAddressType, uint32_t ipAddressIndex);
+	// when each host was last successfully updated, the minimum time point when unknown
+	const std::vector<std::chrono::system_clock::time_point> & getLastUpdatedTimes(IPAddressService::IPAddressType ipAddressType) const;
+	void setLastUpdatedTime(size_t row, IPAddressService::IPAddressType ipAddressType, std::chrono::system_clock::time_point lastUpdatedTime);
+	bool isSuspended(size_t row, IPAddressService::IPAddressType ipAddressType) const;
+	void setSuspended(size_t row, IPAddressService::IPAddressType ipAddressType, bool suspended);
+	void clearSuspended();
+
+	size_t numberOfIPAddresses() const;
+	std::string_view getIPAddress(uint32_t ipAddressIndex) const;
+	// returns the index of the ip address, adding it when it is not yet in the table
+	uint32_t addIPAddress(std::string_view ipAddress);
+
+	static const uint32_t NO_IP_ADDRESS;
+
+private:
+	enum class HostState : uint8_t {
+		None = 0,
+		IPv4Suspended = 1,
+		IPv6Suspended = 2
+	};
+
+	static HostState getSuspendedState(IPAddressService::IPAddressType ipAddressType);
+
+	uint64_t m_domainProfileCollectionRevision;
+	std::vector<uint32_t> m_domainProfileIndices;
+	std::vector<uint32_t> m_hostIndices;
+	std::vector<NamecheapDomainProfile::AddressFamily> m_hostAddressFamilies;
+	std::vector<uint32_t> m_lastIPv4AddressIndices;
+	std::vector<uint32_t> m_lastIPv6AddressIndices;
+	std::vector<std::chrono::system_clock::time_point> m_lastIPv4UpdatedTimes;
+	std::vector<std::chrono::system_clock::time_point> m_lastIPv6UpdatedTimes;
+	std::vector<uint8_t> m_hostStates;
+	std::vector<std::string> m_ipAddresses;
+	std::unordered_map<std::string, uint32_t> m_ipAddressIndices;
+
+	NamecheapHostTable(const NamecheapHostTable &) = delete;
+	const NamecheapHostTable & operator = (const NamecheapHostTable &) = delete;
+};
+
+#endif // _NAMECHEAP_HOST_TABLE_H_
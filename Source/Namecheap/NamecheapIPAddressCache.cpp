@@ -0,0 +1,318 @@
+#include "NamecheapIPAddressCache.h"
+
+#include "IO/AtomicFileWriter.h"
+
+#include <Utilities/RapidJSONUtilities.h>
+#include <Utilities/StringUtilities.h>
+#include <Utilities/TimeUtilities.h>
+
+#include <rapidjson/istreamwrapper.h>
+#include <spdlog/spdlog.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+
+static constexpr const char * JSON_FILE_TYPE_PROPERTY_NAME = "fileType";
+static constexpr const char * JSON_FILE_FORMAT_VERSION_PROPERTY_NAME = "fileFormatVersion";
+static constexpr const char * JSON_HOSTS_PROPERTY_NAME = "hosts";
+static constexpr const char * JSON_HOST_PROPERTY_NAME = "host";
+static constexpr const char * JSON_DOMAIN_PROPERTY_NAME = "domain";
+static constexpr const char * JSON_IP_ADDRESS_PROPERTY_NAME = "ipAddress";
+static constexpr const char * JSON_LAST_UPDATED_PROPERTY_NAME = "lastUpdated";
+
+const std::string NamecheapIPAddressCache::FILE_TYPE("Namecheap Dynamic DNS Auto-Updater IP Address Cache");
+// version 1 caches could merge distinct hosts whose host and domain joined to the same name, so they are discarded rather than trusted
+const uint32_t NamecheapIPAddressCache::FILE_FORMAT_VERSION = 2;
+
+NamecheapIPAddressCache::NamecheapIPAddressCache()
+	: m_modified(false) { }
+
+NamecheapIPAddressCache::NamecheapIPAddressCache(NamecheapIPAddressCache && cache) noexcept
+	: m_entries(std::move(cache.m_entries))
+	, m_filePath(std::move(cache.m_filePath))
+	, m_modified(cache.m_modified) { }
+
+NamecheapIPAddressCache::NamecheapIPAddressCache(const NamecheapIPAddressCache & cache)
+	: m_entries(cache.m_entries)
+	, m_filePath(cache.m_filePath)
+	, m_modified(cache.m_modified) { }
+
+NamecheapIPAddressCache & NamecheapIPAddressCache::operator = (NamecheapIPAddressCache && cache) noexcept {
+	if(this != &cache) {
+		m_entries = std::move(cache.m_entries);
+		m_filePath = std::move(cache.m_filePath);
+		m_modified = cache.m_modified;
+	}
+
+	return *this;
+}
+
+NamecheapIPAddressCache & NamecheapIPAddressCache::operator = (const NamecheapIPAddressCache & cache) {
+	m_entries = cache.m_entries;
+	m_filePath = cache.m_filePath;
+	m_modified = cache.m_modified;
+
+	return *this;
+}
+
+NamecheapIPAddressCache::~NamecheapIPAddressCache() = default;
+
+IPAddressService::IPAddressType NamecheapIPAddressCache::getIPAddressType(std::string_view ipAddress) {
+	return ipAddress.find(':') != std::string_view::npos ? IPAddressService::IPAddressType::V6 : IPAddressService::IPAddressType::V4;
+}
+
+std::string NamecheapIPAddressCache::getEntryKey(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) {
+	// dual-stack hosts publish an address of each family, so they are cached separately, host and domain are joined with a character that cannot appear in either,
+	// since joining them with a dot would give host 'a.b' of domain 'c.com' and host 'a' of domain 'b.c.com' the same entry
+	return Utilities::toLowerCase(std::string(host) + '\n' + std::string(domain)) + (ipAddressType == IPAddressService::IPAddressType::V6 ? "/v6" : "");
+}
+
+size_t NamecheapIPAddressCache::numberOfEntries() const {
+	return m_entries.size();
+}
+
+bool NamecheapIPAddressCache::hasEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) const {
+	return getEntry(host, domain, ipAddressType) != nullptr;
+}
+
+const NamecheapIPAddressCache::Entry * NamecheapIPAddressCache::getEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) const {
+	std::unordered_map<std::string, Entry>::const_iterator entryIterator(m_entries.find(getEntryKey(host, domain, ipAddressType)));
+
+	if(entryIterator == m_entries.cend()) {
+		return nullptr;
+	}
+
+	return &entryIterator->second;
+}
+
+const std::string & NamecheapIPAddressCache::getIPAddress(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) const {
+	const Entry * entry = getEntry(host, domain, ipAddressType);
+
+	if(entry == nullptr) {
+		return Utilities::emptyString;
+	}
+
+	return entry->ipAddress;
+}
+
+bool NamecheapIPAddressCache::isIPAddressPublished(std::string_view host, std::string_view domain, std::string_view ipAddress) const {
+	const Entry * entry = getEntry(host, domain, getIPAddressType(ipAddress));
+
+	return entry != nullptr && !ipAddress.empty() && Utilities::areStringsEqualIgnoreCase(entry->ipAddress, ipAddress);
+}
+
+void NamecheapIPAddressCache::setIPAddress(std::string_view host, std::string_view domain, std::string_view ipAddress) {
+	setIPAddress(host, domain, ipAddress, std::chrono::system_clock::now());
+}
+
+void NamecheapIPAddressCache::setIPAddress(std::string_view host, std::string_view domain, std::string_view ipAddress, std::chrono::time_point<std::chrono::system_clock> lastUpdatedTimestamp) {
+	Entry & entry = m_entries[getEntryKey(host, domain, getIPAddressType(ipAddress))];
+
+	// a refresh to the same ip address still moves the timestamp forced refreshes are scheduled from, so it must reach the cache file too
+	if(!Utilities::areStringsEqualIgnoreCase(entry.ipAddress, ipAddress) || entry.lastUpdatedTimestamp != lastUpdatedTimestamp) {
+		m_modified = true;
+	}
+
+	entry.host = host;
+	entry.domain = domain;
+	entry.ipAddress = ipAddress;
+	entry.lastUpdatedTimestamp = lastUpdatedTimestamp;
+}
+
+bool NamecheapIPAddressCache::removeEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType) {
+	if(m_entries.erase(getEntryKey(host, domain, ipAddressType)) == 0) {
+		return false;
+	}
+
+	m_modified = true;
+
+	return true;
+}
+
+void NamecheapIPAddressCache::clearEntries() {
+	if(m_entries.empty()) {
+		return;
+	}
+
+	m_entries.clear();
+	m_modified = true;
+}
+
+bool NamecheapIPAddressCache::isModified() const {
+	return m_modified;
+}
+
+const std::string & NamecheapIPAddressCache::getFilePath() const {
+	return m_filePath;
+}
+
+void NamecheapIPAddressCache::setFilePath(std::string_view filePath) {
+	m_filePath = filePath;
+}
+
+rapidjson::Document NamecheapIPAddressCache::toJSON() const {
+	rapidjson::Document cacheDocument(rapidjson::kObjectType);
+	rapidjson::MemoryPoolAllocator<rapidjson::CrtAllocator> & allocator = cacheDocument.GetAllocator();
+
+	rapidjson::Value fileTypeValue(FILE_TYPE.c_str(), allocator);
+	cacheDocument.AddMember(rapidjson::StringRef(JSON_FILE_TYPE_PROPERTY_NAME), fileTypeValue, allocator);
+	cacheDocument.AddMember(rapidjson::StringRef(JSON_FILE_FORMAT_VERSION_PROPERTY_NAME), rapidjson::Value(FILE_FORMAT_VERSION), allocator);
+
+	rapidjson::Value hostsValue(rapidjson::kArrayType);
+	hostsValue.Reserve(m_entries.size(), allocator);
+
+	for(std::unordered_map<std::string, Entry>::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i) {
+		const Entry & entry = i->second;
+		rapidjson::Value entryValue(rapidjson::kObjectType);
+
+		rapidjson::Value hostValue(entry.host.c_str(), allocator);
+		entryValue.AddMember(rapidjson::StringRef(JSON_HOST_PROPERTY_NAME), hostValue, allocator);
+
+		rapidjson::Value domainValue(entry.domain.c_str(), allocator);
+		entryValue.AddMember(rapidjson::StringRef(JSON_DOMAIN_PROPERTY_NAME), domainValue, allocator);
+
+		rapidjson::Value ipAddressValue(entry.ipAddress.c_str(), allocator);
+		entryValue.AddMember(rapidjson::StringRef(JSON_IP_ADDRESS_PROPERTY_NAME), ipAddressValue, allocator);
+
+		rapidjson::Value lastUpdatedValue(Utilities::timePointToString(entry.lastUpdatedTimestamp, Utilities::TimeFormat::ISO8601).c_str(), allocator);
+		entryValue.AddMember(rapidjson::StringRef(JSON_LAST_UPDATED_PROPERTY_NAME), lastUpdatedValue, allocator);
+
+		hostsValue.PushBack(entryValue, allocator);
+	}
+
+	cacheDocument.AddMember(rapidjson::StringRef(JSON_HOSTS_PROPERTY_NAME), hostsValue, allocator);
+
+	return cacheDocument;
+}
+
+bool NamecheapIPAddressCache::parseFrom(const rapidjson::Value & cacheValue) {
+	if(!cacheValue.IsObject()) {
+		spdlog::error("Invalid Namecheap IP address cache type: '{}', expected 'object'.", Utilities::typeToString(cacheValue.GetType()));
+		return false;
+	}
+
+	if(!cacheValue.HasMember(JSON_FILE_TYPE_PROPERTY_NAME) || !cacheValue[JSON_FILE_TYPE_PROPERTY_NAME].IsString() || !Utilities::areStringsEqualIgnoreCase(cacheValue[JSON_FILE_TYPE_PROPERTY_NAME].GetString(), FILE_TYPE)) {
+		spdlog::error("Missing or incorrect Namecheap IP address cache file type, expected: '{}'.", FILE_TYPE);
+		return false;
+	}
+
+	if(!cacheValue.HasMember(JSON_FILE_FORMAT_VERSION_PROPERTY_NAME) || !cacheValue[JSON_FILE_FORMAT_VERSION_PROPERTY_NAME].IsUint() || cacheValue[JSON_FILE_FORMAT_VERSION_PROPERTY_NAME].GetUint() != FILE_FORMAT_VERSION) {
+		spdlog::error("Missing or unsupported Namecheap IP address cache file format version, only version {} is supported.", FILE_FORMAT_VERSION);
+		return false;
+	}
+
+	if(!cacheValue.HasMember(JSON_HOSTS_PROPERTY_NAME) || !cacheValue[JSON_HOSTS_PROPERTY_NAME].IsArray()) {
+		spdlog::error("Namecheap IP address cache is missing '{}' array property.", JSON_HOSTS_PROPERTY_NAME);
+		return false;
+	}
+
+	const rapidjson::Value & hostsValue = cacheValue[JSON_HOSTS_PROPERTY_NAME];
+	std::unordered_map<std::string, Entry> entries;
+
+	for(rapidjson::Value::ConstValueIterator i = hostsValue.Begin(); i != hostsValue.End(); ++i) {
+		const rapidjson::Value & entryValue = *i;
+
+		if(!entryValue.IsObject() ||
+		   !entryValue.HasMember(JSON_HOST_PROPERTY_NAME) || !entryValue[JSON_HOST_PROPERTY_NAME].IsString() ||
+		   !entryValue.HasMember(JSON_DOMAIN_PROPERTY_NAME) || !entryValue[JSON_DOMAIN_PROPERTY_NAME].IsString() ||
+		   !entryValue.HasMember(JSON_IP_ADDRESS_PROPERTY_NAME) || !entryValue[JSON_IP_ADDRESS_PROPERTY_NAME].IsString()) {
+			spdlog::warn("Skipping invalid Namecheap IP address cache entry #{}.", (i - hostsValue.Begin()) + 1);
+			continue;
+		}
+
+		Entry entry;
+		entry.host = entryValue[JSON_HOST_PROPERTY_NAME].GetString();
+		entry.domain = entryValue[JSON_DOMAIN_PROPERTY_NAME].GetString();
+		entry.ipAddress = entryValue[JSON_IP_ADDRESS_PROPERTY_NAME].GetString();
+
+		if(entryValue.HasMember(JSON_LAST_UPDATED_PROPERTY_NAME) && entryValue[JSON_LAST_UPDATED_PROPERTY_NAME].IsString()) {
+			std::optional<std::chrono::time_point<std::chrono::system_clock>> optionalLastUpdatedTimestamp(Utilities::parseTimePointFromString(entryValue[JSON_LAST_UPDATED_PROPERTY_NAME].GetString()));
+
+			if(optionalLastUpdatedTimestamp.has_value()) {
+				entry.lastUpdatedTimestamp = optionalLastUpdatedTimestamp.value();
+			}
+		}
+
+		std::string entryKey(getEntryKey(entry.host, entry.domain, getIPAddressType(entry.ipAddress)));
+		entries.emplace(std::move(entryKey), std::move(entry));
+	}
+
+	m_entries = std::move(entries);
+	m_modified = false;
+
+	return true;
+}
+
+bool NamecheapIPAddressCache::load() {
+	return loadFrom(m_filePath);
+}
+
+bool NamecheapIPAddressCache::save() {
+	if(!m_modified) {
+		return true;
+	}
+
+	if(!saveTo(m_filePath)) {
+		return false;
+	}
+
+	m_modified = false;
+
+	return true;
+}
+
+bool NamecheapIPAddressCache::loadFrom(const std::string & filePath) {
+	if(filePath.empty()) {
+		return false;
+	}
+
+	if(!std::filesystem::is_regular_file(std::filesystem::path(filePath))) {
+		spdlog::debug("Namecheap IP address cache file '{}' does not exist yet.", filePath);
+		return false;
+	}
+
+	std::ifstream fileStream(filePath);
+
+	if(!fileStream.is_open()) {
+		spdlog::error("Failed to open Namecheap IP address cache file '{}' for parsing!", filePath);
+		return false;
+	}
+
+	rapidjson::Document cacheDocument;
+	rapidjson::IStreamWrapper fileStreamWrapper(fileStream);
+
+	if(cacheDocument.ParseStream(fileStreamWrapper).HasParseError()) {
+		spdlog::error("Failed to parse Namecheap IP address cache file '{}' JSON data!", filePath);
+		return false;
+	}
+
+	fileStream.close();
+
+	if(!parseFrom(cacheDocument)) {
+		spdlog::error("Failed to parse Namecheap IP address cache from file '{}'!", filePath);
+		return false;
+	}
+
+	spdlog::debug("Loaded {} published IP addresses from Namecheap IP address cache file '{}'.", m_entries.size(), filePath);
+
+	return true;
+}
+
+bool NamecheapIPAddressCache::saveTo(const std::string & filePath, bool overwrite) const {
+	if(filePath.empty()) {
+		return false;
+	}
+
+	if (!overwrite && std::filesystem::exists(std::filesystem::path(filePath))) {
+		spdlog::warn("File '{}' already exists, use overwrite to force write.", filePath);
+		return false;
+	}
+
+	if(!AtomicFileWriter::writeJSONTo(filePath, toJSON())) {
+		spdlog::error("Failed to write Namecheap IP address cache file '{}'!", filePath);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,63 @@
+#ifndef _NAMECHEAP_IP_ADDRESS_CACHE_H_
+#define _NAMECHEAP_IP_ADDRESS_CACHE_H_
+
+#include <Network/IPAddressService.h>
+
+#include <rapidjson/document.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class NamecheapIPAddressCache final {
+public:
+	struct Entry {
+		std::string host;
+		std::string domain;
+		std::string ipAddress;
+		std::chrono::time_point<std::chrono::system_clock> lastUpdatedTimestamp;
+	};
+
+	NamecheapIPAddressCache();
+	NamecheapIPAddressCache(NamecheapIPAddressCache && cache) noexcept;
+	NamecheapIPAddressCache(const NamecheapIPAddressCache & cache);
+	NamecheapIPAddressCache & operator = (NamecheapIPAddressCache && cache) noexcept;
+	NamecheapIPAddressCache & operator = (const NamecheapIPAddressCache & cache);
+	~NamecheapIPAddressCache();
+
+	size_t numberOfEntries() const;
+	bool hasEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	const Entry * getEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	const std::string & getIPAddress(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4) const;
+	bool isIPAddressPublished(std::string_view host, std::string_view domain, std::string_view ipAddress) const;
+	void setIPAddress(std::string_view host, std::string_view domain, std::string_view ipAddress);
+	void setIPAddress(std::string_view host, std::string_view domain, std::string_view ipAddress, std::chrono::time_point<std::chrono::system_clock> lastUpdatedTimestamp);
+	bool removeEntry(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4);
+	void clearEntries();
+	bool isModified() const;
+
+	const std::string & getFilePath() const;
+	void setFilePath(std::string_view filePath);
+
+	rapidjson::Document toJSON() const;
+	bool parseFrom(const rapidjson::Value & cacheValue);
+	bool load();
+	bool save();
+	bool loadFrom(const std::string & filePath);
+	bool saveTo(const std::string & filePath, bool overwrite = true) const;
+
+	static const std::string FILE_TYPE;
+	static const uint32_t FILE_FORMAT_VERSION;
+
+private:
+	static IPAddressService::IPAddressType getIPAddressType(std::string_view ipAddress);
+	static std::string getEntryKey(std::string_view host, std::string_view domain, IPAddressService::IPAddressType ipAddressType);
+
+	std::unordered_map<std::string, Entry> m_entries;
+	std::string m_filePath;
+	bool m_modified;
+};
+
+#endif // _NAMECHEAP_IP_ADDRESS_CACHE_H_
@@ -0,0 +1,396 @@
+#include "NamecheapUpdateJournal.h"
+
+#include "NamecheapIPAddressCache.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string_view>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN32
+
+static constexpr std::array<char, 8> JOURNAL_MAGIC({ 'N', 'C', 'D', 'D', 'N', 'S', 'J', 'R' });
+static constexpr uint32_t JOURNAL_BYTE_ORDER_MARKER = 0x01020304;
+static constexpr uint32_t JOURNAL_FORMAT_VERSION = 1;
+
+const size_t NamecheapUpdateJournal::DEFAULT_COMPACTION_THRESHOLD = 1024 * 1024;
+
+// journals are laid out as a header followed by records, each a fixed size record header immediately followed by the host, domain and ip address strings
+struct JournalHeader {
+	std::array<char, 8> magic;
+	uint32_t fileFormatVersion;
+	uint32_t byteOrderMarker;
+};
+
+static_assert(sizeof(JournalHeader) == 16);
+
+struct JournalRecordHeader {
+	// milliseconds since the unix epoch
+	int64_t timestamp;
+	// fnv-1a hash of the record header with this field zeroed followed by its strings, identifies records torn by a crash during a write
+	uint32_t checksum;
+	uint16_t hostLength;
+	uint16_t domainLength;
+	uint16_t ipAddressLength;
+	uint8_t outcome;
+	uint8_t reserved;
+	uint32_t numberOfAttempts;
+};
+
+static_assert(sizeof(JournalRecordHeader) == 24);
+
+typedef std::function<void(const JournalRecordHeader & recordHeader, std::string_view host, std::string_view domain, std::string_view ipAddress)> JournalRecordFunction;
+
+static uint32_t calculateRecordChecksum(JournalRecordHeader recordHeader, std::string_view recordStrings) {
+	recordHeader.checksum = 0;
+
+	uint32_t checksum = 2166136261u;
+
+	for(char character : std::string_view(reinterpret_cast<const char *>(&recordHeader), sizeof(JournalRecordHeader))) {
+		checksum = (checksum ^ static_cast<uint8_t>(character)) * 16777619u;
+	}
+
+	for(char character : recordStrings) {
+		checksum = (checksum ^ static_cast<uint8_t>(character)) * 16777619u;
+	}
+
+	return checksum;
+}
+
+// reads every intact record up to the first torn or corrupt one, returning the length of the valid prefix or zero if the header is unusable
+static size_t readJournal(const std::string & filePath, const JournalRecordFunction & recordFunction) {
+	std::ifstream fileStream(filePath, std::ios::binary);
+
+	if(!fileStream.is_open()) {
+		return 0;
+	}
+
+	std::string data((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+
+	if(data.length() < sizeof(JournalHeader)) {
+		return 0;
+	}
+
+	JournalHeader header;
+	std::memcpy(&header, data.data(), sizeof(JournalHeader));
+
+	if(header.magic != JOURNAL_MAGIC || header.byteOrderMarker != JOURNAL_BYTE_ORDER_MARKER || header.fileFormatVersion != JOURNAL_FORMAT_VERSION) {
+		spdlog::warn("Ignoring Namecheap update journal '{}' with an unsupported file format.", filePath);
+		return 0;
+	}
+
+	size_t offset = sizeof(JournalHeader);
+
+	while(data.length() - offset >= sizeof(JournalRecordHeader)) {
+		JournalRecordHeader recordHeader;
+		std::memcpy(&recordHeader, data.data() + offset, sizeof(JournalRecordHeader));
+
+		size_t recordStringsLength = static_cast<size_t>(recordHeader.hostLength) + recordHeader.domainLength + recordHeader.ipAddressLength;
+
+		if(data.length() - offset - sizeof(JournalRecordHeader) < recordStringsLength) {
+			break;
+		}
+
+		std::string_view recordStrings(data.data() + offset + sizeof(JournalRecordHeader), recordStringsLength);
+
+		if(calculateRecordChecksum(recordHeader, recordStrings) != recordHeader.checksum) {
+			break;
+		}
+
+		if(recordFunction != nullptr) {
+			recordFunction(recordHeader, recordStrings.substr(0, recordHeader.hostLength), recordStrings.substr(recordHeader.hostLength, recordHeader.domainLength), recordStrings.substr(recordHeader.hostLength + recordHeader.domainLength));
+		}
+
+		offset += sizeof(JournalRecordHeader) + recordStringsLength;
+	}
+
+	if(offset != data.length()) {
+		spdlog::warn("Discarding {} bytes of incomplete records at the end of Namecheap update journal '{}'.", data.length() - offset, filePath);
+	}
+
+	return offset;
+}
+
+// std::ofstream does not expose its file descriptor, so the journal is synced through a second handle to the same file
+static bool syncFile(const std::string & filePath) {
+#if _WIN32
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if(fileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	bool syncSucceeded = FlushFileBuffers(fileHandle);
+	CloseHandle(fileHandle);
+#else
+	int fileDescriptor = open(filePath.c_str(), O_WRONLY | O_CLOEXEC);
+
+	if(fileDescriptor < 0) {
+		return false;
+	}
+
+#if __APPLE__
+	bool syncSucceeded = fsync(fileDescriptor) == 0;
+#else
+	// records are only ever appended, so only the data and file size need to reach the disk
+	bool syncSucceeded = fdatasync(fileDescriptor) == 0;
+#endif // __APPLE__
+
+	syncSucceeded = close(fileDescriptor) == 0 && syncSucceeded;
+#endif // _WIN32
+
+	return syncSucceeded;
+}
+
+NamecheapUpdateJournal::NamecheapUpdateJournal(const std::string & filePath, size_t compactionThreshold)
+	: m_filePath(filePath)
+	, m_numberOfRecords(0)
+	, m_fileSize(0)
+	, m_compactionThreshold(compactionThreshold) { }
+
+NamecheapUpdateJournal::~NamecheapUpdateJournal() {
+	close();
+}
+
+const std::string & NamecheapUpdateJournal::getFilePath() const {
+	return m_filePath;
+}
+
+bool NamecheapUpdateJournal::isOpen() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_fileStream.is_open();
+}
+
+size_t NamecheapUpdateJournal::numberOfRecords() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_numberOfRecords;
+}
+
+size_t NamecheapUpdateJournal::getFileSize() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_fileSize;
+}
+
+size_t NamecheapUpdateJournal::getCompactionThreshold() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_compactionThreshold;
+}
+
+void NamecheapUpdateJournal::setCompactionThreshold(size_t compactionThreshold) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_compactionThreshold = compactionThreshold;
+}
+
+bool NamecheapUpdateJournal::needsCompaction() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_fileSize >= m_compactionThreshold || !m_fileStream.is_open();
+}
+
+bool NamecheapUpdateJournal::open() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_fileStream.is_open()) {
+		return true;
+	}
+
+	if(m_filePath.empty()) {
+		return false;
+	}
+
+	size_t numberOfRecords = 0;
+	size_t validLength = readJournal(m_filePath, [&numberOfRecords](const JournalRecordHeader &, std::string_view, std::string_view, std::string_view) {
+		numberOfRecords++;
+	});
+
+	if(validLength == 0) {
+		return writeHeader();
+	}
+
+	// drop a torn trailing record, otherwise every record appended after it would be unreachable
+	std::error_code errorCode;
+
+	if(std::filesystem::file_size(std::filesystem::path(m_filePath), errorCode) != validLength && !errorCode) {
+		std::filesystem::resize_file(std::filesystem::path(m_filePath), validLength, errorCode);
+	}
+
+	if(errorCode) {
+		spdlog::error("Failed to truncate Namecheap update journal '{}': {}", m_filePath, errorCode.message());
+		return false;
+	}
+
+	m_fileStream.open(m_filePath, std::ios::binary | std::ios::app);
+
+	if(!m_fileStream.is_open()) {
+		spdlog::error("Failed to open Namecheap update journal '{}' for writing.", m_filePath);
+		return false;
+	}
+
+	m_numberOfRecords = numberOfRecords;
+	m_fileSize = validLength;
+
+	return true;
+}
+
+void NamecheapUpdateJournal::close() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_fileStream.is_open()) {
+		m_fileStream.close();
+	}
+}
+
+bool NamecheapUpdateJournal::writeHeader() {
+	if(m_fileStream.is_open()) {
+		m_fileStream.close();
+	}
+
+	m_numberOfRecords = 0;
+	m_fileSize = 0;
+	m_fileStream.open(m_filePath, std::ios::binary | std::ios::trunc);
+
+	if(!m_fileStream.is_open()) {
+		spdlog::error("Failed to create Namecheap update journal '{}'.", m_filePath);
+		return false;
+	}
+
+	JournalHeader header;
+	header.magic = JOURNAL_MAGIC;
+	header.fileFormatVersion = JOURNAL_FORMAT_VERSION;
+	header.byteOrderMarker = JOURNAL_BYTE_ORDER_MARKER;
+
+	m_fileStream.write(reinterpret_cast<const char *>(&header), sizeof(JournalHeader));
+	m_fileStream.flush();
+
+	if(m_fileStream.fail()) {
+		spdlog::error("Failed to write Namecheap update journal '{}' header.", m_filePath);
+		m_fileStream.close();
+		return false;
+	}
+
+	m_fileSize = sizeof(JournalHeader);
+
+	return true;
+}
+
+bool NamecheapUpdateJournal::append(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult) {
+	if(hostResult.host.length() > std::numeric_limits<uint16_t>::max() || hostResult.domain.length() > std::numeric_limits<uint16_t>::max() || hostResult.ipAddress.length() > std::numeric_limits<uint16_t>::max()) {
+		return false;
+	}
+
+	JournalRecordHeader recordHeader;
+	recordHeader.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	recordHeader.hostLength = static_cast<uint16_t>(hostResult.host.length());
+	recordHeader.domainLength = static_cast<uint16_t>(hostResult.domain.length());
+	recordHeader.ipAddressLength = static_cast<uint16_t>(hostResult.ipAddress.length());
+	recordHeader.reserved = 0;
+	recordHeader.numberOfAttempts = static_cast<uint32_t>(std::min(hostResult.numberOfAttempts, static_cast<size_t>(std::numeric_limits<uint32_t>::max())));
+
+	if(hostResult.success) {
+		recordHeader.outcome = static_cast<uint8_t>(Outcome::Success);
+	}
+	else if(hostResult.errorClass == NamecheapDynamicDNSResponse::ErrorClass::Permanent) {
+		recordHeader.outcome = static_cast<uint8_t>(Outcome::PermanentFailure);
+	}
+	else {
+		recordHeader.outcome = static_cast<uint8_t>(Outcome::RetryableFailure);
+	}
+
+	std::string record(sizeof(JournalRecordHeader), '\0');
+	record.append(hostResult.host);
+	record.append(hostResult.domain);
+	record.append(hostResult.ipAddress);
+
+	recordHeader.checksum = calculateRecordChecksum(recordHeader, std::string_view(record).substr(sizeof(JournalRecordHeader)));
+	std::memcpy(record.data(), &recordHeader, sizeof(JournalRecordHeader));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(!m_fileStream.is_open()) {
+		return false;
+	}
+
+	// flushed per record so that the outcome survives the process exiting before the update cycle completes, syncing to disk is left to the end of the cycle
+	m_fileStream.write(record.data(), static_cast<std::streamsize>(record.length()));
+	m_fileStream.flush();
+
+	if(m_fileStream.fail()) {
+		spdlog::error("Failed to append to Namecheap update journal '{}'.", m_filePath);
+		m_fileStream.clear();
+		return false;
+	}
+
+	m_numberOfRecords++;
+	m_fileSize += record.length();
+
+	return true;
+}
+
+bool NamecheapUpdateJournal::sync() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(!m_fileStream.is_open()) {
+		return false;
+	}
+
+	m_fileStream.flush();
+
+	if(m_fileStream.fail() || !syncFile(m_filePath)) {
+		spdlog::error("Failed to sync Namecheap update journal '{}' to disk.", m_filePath);
+		m_fileStream.clear();
+		return false;
+	}
+
+	return true;
+}
+
+size_t NamecheapUpdateJournal::replayInto(NamecheapIPAddressCache & ipAddressCache) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	size_t numberOfConfirmedUpdates = 0;
+
+	// only successes are applied, hosts whose last attempt failed remain unconfirmed and are sent again on the next cycle
+	readJournal(m_filePath, [&ipAddressCache, &numberOfConfirmedUpdates](const JournalRecordHeader & recordHeader, std::string_view host, std::string_view domain, std::string_view ipAddress) {
+		if(recordHeader.outcome != static_cast<uint8_t>(Outcome::Success)) {
+			return;
+		}
+
+		ipAddressCache.setIPAddress(host, domain, ipAddress, std::chrono::time_point<std::chrono::system_clock>(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(recordHeader.timestamp))));
+		numberOfConfirmedUpdates++;
+	});
+
+	return numberOfConfirmedUpdates;
+}
+
+bool NamecheapUpdateJournal::compact(NamecheapIPAddressCache & ipAddressCache) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_numberOfRecords == 0 && m_fileStream.is_open()) {
+		return true;
+	}
+
+	// compacts from the cache in memory rather than re-reading the journal, which may only be discarded once everything it confirmed is safely in the cache file
+	if(ipAddressCache.isModified() && !ipAddressCache.save()) {
+		spdlog::warn("Failed to save Namecheap IP address cache, keeping {} record(s) in update journal '{}'.", m_numberOfRecords, m_filePath);
+		return false;
+	}
+
+	return writeHeader();
+}
@@ -0,0 +1,59 @@
+#ifndef _NAMECHEAP_UPDATE_JOURNAL_H_
+#define _NAMECHEAP_UPDATE_JOURNAL_H_
+
+#include "NamecheapDynamicDNSUpdateReport.h"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+class NamecheapIPAddressCache;
+
+// append-only record of every host update attempt and its outcome, written as each request completes so that an update cycle
+// interrupted by a crash or restart can resume from the hosts which were not yet confirmed, rather than re-sending every update
+// the IP address cache serves as the journal snapshot, once the journal grows past its compaction threshold the cache is saved and the journal truncated
+class NamecheapUpdateJournal final {
+public:
+	enum class Outcome : uint8_t {
+		Success = 1,
+		RetryableFailure = 2,
+		PermanentFailure = 3
+	};
+
+	NamecheapUpdateJournal(const std::string & filePath, size_t compactionThreshold = DEFAULT_COMPACTION_THRESHOLD);
+	~NamecheapUpdateJournal();
+
+	const std::string & getFilePath() const;
+	bool isOpen() const;
+	size_t numberOfRecords() const;
+	size_t getFileSize() const;
+	// size in bytes the journal may grow to before the service compacts it
+	size_t getCompactionThreshold() const;
+	void setCompactionThreshold(size_t compactionThreshold);
+	bool needsCompaction() const;
+	bool open();
+	void close();
+	bool append(const NamecheapDynamicDNSUpdateReport::HostResult & hostResult);
+	// flushes appended records to disk, called once per update cycle rather than per record
+	bool sync();
+	size_t replayInto(NamecheapIPAddressCache & ipAddressCache) const;
+	// the cache must already hold every update confirmed by the journal, as it does once the journal is replayed into it on startup
+	bool compact(NamecheapIPAddressCache & ipAddressCache);
+
+	static const size_t DEFAULT_COMPACTION_THRESHOLD;
+
+private:
+	bool writeHeader();
+
+	std::string m_filePath;
+	std::ofstream m_fileStream;
+	size_t m_numberOfRecords;
+	size_t m_fileSize;
+	size_t m_compactionThreshold;
+	mutable std::mutex m_mutex;
+
+	NamecheapUpdateJournal(const NamecheapUpdateJournal &) = delete;
+	const NamecheapUpdateJournal & operator = (const NamecheapUpdateJournal &) = delete;
+};
+
+#endif // _NAMECHEAP_UPDATE_JOURNAL_H_
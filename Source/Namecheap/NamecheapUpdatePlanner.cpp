@@ -0,0 +1,312 @@
+#include "NamecheapUpdatePlanner.h"
+
+#include "NamecheapHostTable.h"
+
+#include <algorithm>
+
+const std::chrono::seconds NamecheapUpdatePlanner::DEFAULT_FORCED_REFRESH_INTERVAL(0);
+
+bool NamecheapUpdatePlanner::Refresh::operator > (const Refresh & refresh) const {
+	return dueTime > refresh.dueTime;
+}
+
+NamecheapUpdatePlanner::NamecheapUpdatePlanner(std::chrono::seconds forcedRefreshInterval)
+	: m_forcedRefreshInterval(forcedRefreshInterval)
+	, m_domainProfileCollectionRevision(0)
+	, m_numberOfHosts(0)
+	, m_ipAddressIndices({ NamecheapHostTable::NO_IP_ADDRESS, NamecheapHostTable::NO_IP_ADDRESS })
+	, m_numberOfEligibleHosts({ 0, 0 })
+	, m_numberOfSuspendedHosts({ 0, 0 }) { }
+
+NamecheapUpdatePlanner::~NamecheapUpdatePlanner() = default;
+
+std::chrono::seconds NamecheapUpdatePlanner::getForcedRefreshInterval() const {
+	return m_forcedRefreshInterval;
+}
+
+void NamecheapUpdatePlanner::setForcedRefreshInterval(std::chrono::seconds forcedRefreshInterval) {
+	if(m_forcedRefreshInterval == forcedRefreshInterval) {
+		return;
+	}
+
+	m_forcedRefreshInterval = forcedRefreshInterval;
+
+	// scheduled refreshes were due after the previous interval, so they are scheduled again from the host table on the next cycle
+	clear();
+}
+
+bool NamecheapUpdatePlanner::isBuiltFrom(const NamecheapHostTable & hostTable) const {
+	return m_domainProfileCollectionRevision == hostTable.getDomainProfileCollectionRevision() && m_numberOfHosts == hostTable.numberOfHosts();
+}
+
+void NamecheapUpdatePlanner::reset(const NamecheapHostTable & hostTable) {
+	clear();
+
+	m_domainProfileCollectionRevision = hostTable.getDomainProfileCollectionRevision();
+	m_numberOfHosts = hostTable.numberOfHosts();
+	m_hostStates.assign(m_numberOfHosts, static_cast<uint8_t>(HostState::None));
+	m_dirtyRows.reserve(m_numberOfHosts);
+
+	for(std::vector<std::chrono::system_clock::time_point> & refreshDueTimes : m_refreshDueTimes) {
+		refreshDueTimes.assign(m_numberOfHosts, std::chrono::system_clock::time_point::max());
+	}
+
+	std::vector<Refresh> refreshes;
+	const std::vector<NamecheapDomainProfile::AddressFamily> & hostAddressFamilies = hostTable.getHostAddressFamilies();
+
+	for(size_t i = 0; i < m_numberOfHosts; i++) {
+		for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+			if(!NamecheapDomainProfile::includesAddressFamily(hostAddressFamilies[i], ipAddressType == IPAddressService::IPAddressType::V6 ? NamecheapDomainProfile::AddressFamily::IPv6 : NamecheapDomainProfile::AddressFamily::IPv4)) {
+				continue;
+			}
+
+			m_numberOfEligibleHosts[getAddressFamilyIndex(ipAddressType)]++;
+
+			if(hostTable.isSuspended(i, ipAddressType)) {
+				m_numberOfSuspendedHosts[getAddressFamilyIndex(ipAddressType)]++;
+			}
+
+			std::chrono::system_clock::time_point lastUpdatedTime(hostTable.getLastUpdatedTimes(ipAddressType)[i]);
+
+			// the refresh interval carries on from the last update rather than restarting whenever the table is rebuilt or the process restarts
+			if(m_forcedRefreshInterval > std::chrono::seconds::zero() && lastUpdatedTime != std::chrono::system_clock::time_point::min()) {
+				std::chrono::system_clock::time_point dueTime(lastUpdatedTime + m_forcedRefreshInterval);
+				m_refreshDueTimes[getAddressFamilyIndex(ipAddressType)][i] = dueTime;
+				refreshes.push_back({ dueTime, static_cast<uint32_t>(i), ipAddressType });
+			}
+		}
+	}
+
+	m_refreshes = std::priority_queue<Refresh, std::vector<Refresh>, std::greater<Refresh>>(std::greater<Refresh>(), std::move(refreshes));
+
+	// nothing is known about which hosts of a rebuilt table changed, so each one is compared against the current ip address once
+	addHostStateToAllHosts(static_cast<uint8_t>(HostState::IPv4Dirty) | static_cast<uint8_t>(HostState::IPv6Dirty));
+}
+
+void NamecheapUpdatePlanner::clear() {
+	m_domainProfileCollectionRevision = 0;
+	m_numberOfHosts = 0;
+	m_hostStates.clear();
+	m_dirtyRows.clear();
+	m_ipAddressIndices.fill(NamecheapHostTable::NO_IP_ADDRESS);
+	m_numberOfEligibleHosts.fill(0);
+	m_numberOfSuspendedHosts.fill(0);
+
+	for(std::vector<std::chrono::system_clock::time_point> & refreshDueTimes : m_refreshDueTimes) {
+		refreshDueTimes.clear();
+	}
+
+	m_refreshes = {};
+}
+
+size_t NamecheapUpdatePlanner::numberOfDirtyHosts() const {
+	return m_dirtyRows.size();
+}
+
+size_t NamecheapUpdatePlanner::numberOfPendingRefreshes() const {
+	return m_refreshes.size();
+}
+
+void NamecheapUpdatePlanner::markDirty(size_t row, IPAddressService::IPAddressType ipAddressType, bool refresh) {
+	addHostState(row, getHostState(ipAddressType, refresh));
+}
+
+void NamecheapUpdatePlanner::markAllDirty(bool refresh) {
+	addHostStateToAllHosts(static_cast<uint8_t>(getHostState(IPAddressService::IPAddressType::V4, refresh) | getHostState(IPAddressService::IPAddressType::V6, refresh)));
+}
+
+NamecheapUpdatePlanner::Plan NamecheapUpdatePlanner::planCycle(NamecheapHostTable & hostTable, uint32_t ipv4AddressIndex, uint32_t ipv6AddressIndex, std::chrono::system_clock::time_point currentTime, bool force) {
+	if(!isBuiltFrom(hostTable)) {
+		reset(hostTable);
+	}
+
+	const std::array<uint32_t, 2> ipAddressIndices({ ipv4AddressIndex, ipv6AddressIndex });
+
+	for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+		size_t addressFamilyIndex = getAddressFamilyIndex(ipAddressType);
+
+		if(ipAddressIndices[addressFamilyIndex] == m_ipAddressIndices[addressFamilyIndex]) {
+			continue;
+		}
+
+		// every host may point to the old ip address, an address family which is skipped this cycle is compared again in full once it returns
+		m_ipAddressIndices[addressFamilyIndex] = ipAddressIndices[addressFamilyIndex];
+
+		if(ipAddressIndices[addressFamilyIndex] != NamecheapHostTable::NO_IP_ADDRESS) {
+			addHostStateToAllHosts(getHostState(ipAddressType, false));
+		}
+	}
+
+	expireRefreshes(currentTime);
+
+	if(force) {
+		markAllDirty(true);
+	}
+
+	Plan plan;
+	std::array<size_t, 2> numberOfPlannedUpdates({ 0, 0 });
+	const std::vector<NamecheapDomainProfile::AddressFamily> & hostAddressFamilies = hostTable.getHostAddressFamilies();
+
+	size_t numberOfRetainedDirtyRows = 0;
+
+	for(uint32_t row : m_dirtyRows) {
+		uint8_t hostState = m_hostStates[row];
+		m_hostStates[row] = static_cast<uint8_t>(HostState::None);
+
+		for(IPAddressService::IPAddressType ipAddressType : { IPAddressService::IPAddressType::V4, IPAddressService::IPAddressType::V6 }) {
+			size_t addressFamilyIndex = getAddressFamilyIndex(ipAddressType);
+			uint32_t ipAddressIndex = ipAddressIndices[addressFamilyIndex];
+			bool refresh = (hostState & getHostState(ipAddressType, true) & ~getHostState(ipAddressType, false)) != 0;
+
+			if((hostState & getHostState(ipAddressType, false)) == 0) {
+				continue;
+			}
+
+			// checked before retaining refreshes, otherwise rows marked dirty for every address family would be retained for one they never use
+			if(!NamecheapDomainProfile::includesAddressFamily(hostAddressFamilies[row], ipAddressType == IPAddressService::IPAddressType::V6 ? NamecheapDomainProfile::AddressFamily::IPv6 : NamecheapDomainProfile::AddressFamily::IPv4)) {
+				continue;
+			}
+
+			if(ipAddressIndex == NamecheapHostTable::NO_IP_ADDRESS) {
+				// the full comparison once the address family returns would miss refreshes and retries of hosts already recorded with that ip address
+				if(refresh) {
+					m_hostStates[row] |= getHostState(ipAddressType, true);
+				}
+
+				continue;
+			}
+
+			if(!force && hostTable.isSuspended(row, ipAddressType)) {
+				continue;
+			}
+
+			if(!refresh && hostTable.getLastIPAddressIndices(ipAddressType)[row] == ipAddressIndex) {
+				continue;
+			}
+
+			plan.workItems.push_back({ row, ipAddressType });
+			numberOfPlannedUpdates[addressFamilyIndex]++;
+		}
+
+		// retained rows are moved to the front of the dirty rows, which never overtakes the row being read
+		if(m_hostStates[row] != static_cast<uint8_t>(HostState::None)) {
+			m_dirtyRows[numberOfRetainedDirtyRows++] = row;
+		}
+	}
+
+	m_dirtyRows.resize(numberOfRetainedDirtyRows);
+
+	// hosts which were not visited are known to be up to date or suspended, so the counts come from the totals rather than a scan
+	for(size_t i = 0; i < ipAddressIndices.size(); i++) {
+		if(ipAddressIndices[i] == NamecheapHostTable::NO_IP_ADDRESS) {
+			continue;
+		}
+
+		size_t numberOfSuspendedUpdates = force ? 0 : m_numberOfSuspendedHosts[i];
+
+		plan.numberOfSuspendedUpdates += numberOfSuspendedUpdates;
+		plan.numberOfSkippedUpdates += m_numberOfEligibleHosts[i] - std::min(m_numberOfEligibleHosts[i], numberOfSuspendedUpdates + numberOfPlannedUpdates[i]);
+	}
+
+	return plan;
+}
+
+void NamecheapUpdatePlanner::recordSuccess(NamecheapHostTable & hostTable, const WorkItem & workItem, std::chrono::system_clock::time_point currentTime) {
+	if(workItem.row >= m_numberOfHosts) {
+		return;
+	}
+
+	size_t addressFamilyIndex = getAddressFamilyIndex(workItem.ipAddressType);
+
+	hostTable.setLastIPAddressIndex(workItem.row, workItem.ipAddressType, m_ipAddressIndices[addressFamilyIndex]);
+	hostTable.setLastUpdatedTime(workItem.row, workItem.ipAddressType, currentTime);
+
+	if(m_forcedRefreshInterval <= std::chrono::seconds::zero()) {
+		return;
+	}
+
+	std::chrono::system_clock::time_point dueTime(currentTime + m_forcedRefreshInterval);
+	m_refreshDueTimes[addressFamilyIndex][workItem.row] = dueTime;
+	m_refreshes.push({ dueTime, workItem.row, workItem.ipAddressType });
+}
+
+void NamecheapUpdatePlanner::recordFailure(NamecheapHostTable & hostTable, const WorkItem & workItem, bool permanent) {
+	if(workItem.row >= m_numberOfHosts) {
+		return;
+	}
+
+	if(!permanent) {
+		// retried even if the host table already records the current ip address, since the update may not have been applied
+		addHostState(workItem.row, getHostState(workItem.ipAddressType, true));
+		return;
+	}
+
+	if(hostTable.isSuspended(workItem.row, workItem.ipAddressType)) {
+		return;
+	}
+
+	hostTable.setSuspended(workItem.row, workItem.ipAddressType, true);
+	m_numberOfSuspendedHosts[getAddressFamilyIndex(workItem.ipAddressType)]++;
+}
+
+void NamecheapUpdatePlanner::clearSuspended(NamecheapHostTable & hostTable) {
+	hostTable.clearSuspended();
+	m_numberOfSuspendedHosts.fill(0);
+
+	// suspended hosts were dropped from the dirty set, so every host is compared again
+	markAllDirty(false);
+}
+
+void NamecheapUpdatePlanner::clearSuspended(NamecheapHostTable & hostTable, size_t row, IPAddressService::IPAddressType ipAddressType) {
+	if(row >= m_numberOfHosts || !hostTable.isSuspended(row, ipAddressType)) {
+		return;
+	}
+
+	hostTable.setSuspended(row, ipAddressType, false);
+	m_numberOfSuspendedHosts[getAddressFamilyIndex(ipAddressType)]--;
+	markDirty(row, ipAddressType);
+}
+
+size_t NamecheapUpdatePlanner::getAddressFamilyIndex(IPAddressService::IPAddressType ipAddressType) {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? 1 : 0;
+}
+
+uint8_t NamecheapUpdatePlanner::getHostState(IPAddressService::IPAddressType ipAddressType, bool refresh) {
+	if(ipAddressType == IPAddressService::IPAddressType::V6) {
+		return static_cast<uint8_t>(HostState::IPv6Dirty) | (refresh ? static_cast<uint8_t>(HostState::IPv6Refresh) : 0);
+	}
+
+	return static_cast<uint8_t>(HostState::IPv4Dirty) | (refresh ? static_cast<uint8_t>(HostState::IPv4Refresh) : 0);
+}
+
+void NamecheapUpdatePlanner::addHostState(size_t row, uint8_t hostState) {
+	if(row >= m_numberOfHosts) {
+		return;
+	}
+
+	if(m_hostStates[row] == static_cast<uint8_t>(HostState::None)) {
+		m_dirtyRows.push_back(static_cast<uint32_t>(row));
+	}
+
+	m_hostStates[row] |= hostState;
+}
+
+void NamecheapUpdatePlanner::addHostStateToAllHosts(uint8_t hostState) {
+	for(size_t i = 0; i < m_numberOfHosts; i++) {
+		addHostState(i, hostState);
+	}
+}
+
+void NamecheapUpdatePlanner::expireRefreshes(std::chrono::system_clock::time_point currentTime) {
+	while(!m_refreshes.empty() && m_refreshes.top().dueTime <= currentTime) {
+		const Refresh & refresh = m_refreshes.top();
+		std::vector<std::chrono::system_clock::time_point> & refreshDueTimes = m_refreshDueTimes[getAddressFamilyIndex(refresh.ipAddressType)];
+
+		if(refresh.row < refreshDueTimes.size() && refreshDueTimes[refresh.row] == refresh.dueTime) {
+			refreshDueTimes[refresh.row] = std::chrono::system_clock::time_point::max();
+			addHostState(refresh.row, getHostState(refresh.ipAddressType, true));
+		}
+
+		m_refreshes.pop();
+	}
+}
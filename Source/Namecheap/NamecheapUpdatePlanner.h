@@ -0,0 +1,98 @@
+#ifndef _NAMECHEAP_UPDATE_PLANNER_H_
+#define _NAMECHEAP_UPDATE_PLANNER_H_
+
+#include <Network/IPAddressService.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+class NamecheapHostTable;
+
+// tracks which host table rows may need an update, so that planning an update cycle only visits hosts whose ip address, profile or last attempt changed,
+// or whose forced refresh is due, rather than scanning every host, a cycle with an unchanged ip address and nothing due produces an empty plan in constant time
+class NamecheapUpdatePlanner final {
+public:
+	struct WorkItem {
+		uint32_t row;
+		IPAddressService::IPAddressType ipAddressType;
+	};
+
+	struct Plan {
+		std::vector<WorkItem> workItems;
+		size_t numberOfSkippedUpdates = 0;
+		size_t numberOfSuspendedUpdates = 0;
+	};
+
+	NamecheapUpdatePlanner(std::chrono::seconds forcedRefreshInterval = DEFAULT_FORCED_REFRESH_INTERVAL);
+	~NamecheapUpdatePlanner();
+
+	// zero disables forced refreshes, otherwise hosts are updated again once this long has passed since their last successful update, even if their ip address is unchanged,
+	// measured in wall clock time so that last updated times recorded by an earlier process carry over
+	std::chrono::seconds getForcedRefreshInterval() const;
+	void setForcedRefreshInterval(std::chrono::seconds forcedRefreshInterval);
+	// false once the host table has been rebuilt from a different collection revision, planning a cycle then starts over with every host dirty
+	bool isBuiltFrom(const NamecheapHostTable & hostTable) const;
+	// schedules each host's forced refresh from the last updated times recorded in the host table
+	void reset(const NamecheapHostTable & hostTable);
+	void clear();
+	size_t numberOfDirtyHosts() const;
+	size_t numberOfPendingRefreshes() const;
+
+	void markDirty(size_t row, IPAddressService::IPAddressType ipAddressType, bool refresh = false);
+	void markAllDirty(bool refresh = false);
+	// ip address indices are those of the host table, no ip address skips the address family for this cycle, forcing plans every host regardless of its state
+	Plan planCycle(NamecheapHostTable & hostTable, uint32_t ipv4AddressIndex, uint32_t ipv6AddressIndex, std::chrono::system_clock::time_point currentTime, bool force = false);
+	void recordSuccess(NamecheapHostTable & hostTable, const WorkItem & workItem, std::chrono::system_clock::time_point currentTime);
+	// permanent failures suspend the host until its profile changes or suspensions are cleared, any other failure is retried on the next cycle
+	void recordFailure(NamecheapHostTable & hostTable, const WorkItem & workItem, bool permanent);
+	void clearSuspended(NamecheapHostTable & hostTable);
+	void clearSuspended(NamecheapHostTable & hostTable, size_t row, IPAddressService::IPAddressType ipAddressType);
+
+	static const std::chrono::seconds DEFAULT_FORCED_REFRESH_INTERVAL;
+
+private:
+	enum class HostState : uint8_t {
+		None = 0,
+		IPv4Dirty = 1,
+		IPv6Dirty = 2,
+		IPv4Refresh = 4,
+		IPv6Refresh = 8
+	};
+
+	struct Refresh {
+		std::chrono::system_clock::time_point dueTime;
+		uint32_t row;
+		IPAddressService::IPAddressType ipAddressType;
+
+		bool operator > (const Refresh & refresh) const;
+	};
+
+	static size_t getAddressFamilyIndex(IPAddressService::IPAddressType ipAddressType);
+	static uint8_t getHostState(IPAddressService::IPAddressType ipAddressType, bool refresh);
+	void addHostState(size_t row, uint8_t hostState);
+	void addHostStateToAllHosts(uint8_t hostState);
+	void expireRefreshes(std::chrono::system_clock::time_point currentTime);
+
+	std::chrono::seconds m_forcedRefreshInterval;
+	uint64_t m_domainProfileCollectionRevision;
+	size_t m_numberOfHosts;
+	std::vector<uint8_t> m_hostStates;
+	// each dirty row once, in the order they became dirty
+	std::vector<uint32_t> m_dirtyRows;
+	// ip address index each address family was last planned for, indexed by address family
+	std::array<uint32_t, 2> m_ipAddressIndices;
+	std::array<size_t, 2> m_numberOfEligibleHosts;
+	std::array<size_t, 2> m_numberOfSuspendedHosts;
+	// superseded refreshes are left in the queue and discarded when they no longer match the row's due time
+	std::array<std::vector<std::chrono::system_clock::time_point>, 2> m_refreshDueTimes;
+	std::priority_queue<Refresh, std::vector<Refresh>, std::greater<Refresh>> m_refreshes;
+
+	NamecheapUpdatePlanner(const NamecheapUpdatePlanner &) = delete;
+	const NamecheapUpdatePlanner & operator = (const NamecheapUpdatePlanner &) = delete;
+};
+
+#endif // _NAMECHEAP_UPDATE_PLANNER_H_
@@ -0,0 +1,252 @@
+#include "AddressChangeMonitor.h"
+
+#include <spdlog/spdlog.h>
+
+#if !_WIN32
+#include <arpa/inet.h>
+#include <ifaddrs.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+#if __linux__
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <poll.h>
+#include <sys/socket.h>
+#endif // __linux__
+
+const std::chrono::milliseconds AddressChangeMonitor::DEFAULT_DEBOUNCE_INTERVAL(2000);
+const std::chrono::milliseconds AddressChangeMonitor::POLL_INTERVAL(250);
+const std::chrono::milliseconds AddressChangeMonitor::ADDRESS_POLL_INTERVAL(5000);
+
+AddressChangeMonitor::AddressChangeMonitor(ChangeCallback changeCallback, const std::string & interfaceName, std::chrono::milliseconds debounceInterval)
+	: m_changeCallback(changeCallback)
+	, m_interfaceName(interfaceName)
+	, m_debounceInterval(debounceInterval)
+	, m_running(false)
+#if __linux__
+	, m_netlinkSocket(-1)
+#endif // __linux__
+{ }
+
+AddressChangeMonitor::~AddressChangeMonitor() {
+	stop();
+}
+
+const std::string & AddressChangeMonitor::getInterfaceName() const {
+	return m_interfaceName;
+}
+
+bool AddressChangeMonitor::isRunning() const {
+	return m_running;
+}
+
+bool AddressChangeMonitor::start() {
+	if(m_running) {
+		return true;
+	}
+
+	if(m_changeCallback == nullptr) {
+		return false;
+	}
+
+#if _WIN32
+	spdlog::warn("Monitoring network address changes is not supported on this platform.");
+
+	return false;
+#else
+#if __linux__
+	m_netlinkSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_ROUTE);
+
+	if(m_netlinkSocket < 0) {
+		spdlog::warn("Failed to open rtnetlink socket, falling back to polling for network address changes.");
+	}
+	else {
+		sockaddr_nl netlinkAddress = {};
+		netlinkAddress.nl_family = AF_NETLINK;
+		netlinkAddress.nl_groups = RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+
+		if(bind(m_netlinkSocket, reinterpret_cast<sockaddr *>(&netlinkAddress), sizeof(netlinkAddress)) < 0) {
+			spdlog::warn("Failed to subscribe to rtnetlink address events, falling back to polling for network address changes.");
+
+			close(m_netlinkSocket);
+			m_netlinkSocket = -1;
+		}
+	}
+
+	if(m_netlinkSocket < 0)
+#endif // __linux__
+	{
+		m_interfaceAddresses = getInterfaceAddresses();
+		m_lastAddressPollTime = std::chrono::steady_clock::now();
+	}
+
+	m_running = true;
+	m_monitorThread = std::thread(&AddressChangeMonitor::run, this);
+
+	return true;
+#endif // _WIN32
+}
+
+void AddressChangeMonitor::stop() {
+	if(!m_running) {
+		return;
+	}
+
+	m_running = false;
+
+	if(m_monitorThread.joinable()) {
+		m_monitorThread.join();
+	}
+
+#if __linux__
+	if(m_netlinkSocket >= 0) {
+		close(m_netlinkSocket);
+		m_netlinkSocket = -1;
+	}
+#endif // __linux__
+
+	m_interfaceAddresses.clear();
+}
+
+void AddressChangeMonitor::run() {
+	bool changePending = false;
+	std::chrono::steady_clock::time_point lastChangeTime;
+
+	while(m_running) {
+		if(collectAddressChanges()) {
+			changePending = true;
+			lastChangeTime = std::chrono::steady_clock::now();
+		}
+
+		// re-addressing usually removes the old address and adds the new one in quick succession, so report the burst once it settles
+		if(!changePending || std::chrono::steady_clock::now() - lastChangeTime < m_debounceInterval) {
+			continue;
+		}
+
+		changePending = false;
+
+		m_changeCallback();
+	}
+}
+
+bool AddressChangeMonitor::collectAddressChanges() {
+#if __linux__
+	if(m_netlinkSocket >= 0) {
+		pollfd netlinkPollEntry;
+		netlinkPollEntry.fd = m_netlinkSocket;
+		netlinkPollEntry.events = POLLIN;
+		netlinkPollEntry.revents = 0;
+
+		if(poll(&netlinkPollEntry, 1, static_cast<int>(POLL_INTERVAL.count())) <= 0) {
+			return false;
+		}
+
+		bool addressChanged = false;
+		alignas(nlmsghdr) char messageBuffer[8192];
+		ssize_t numberOfBytesRead = 0;
+
+		while((numberOfBytesRead = recv(m_netlinkSocket, messageBuffer, sizeof(messageBuffer), 0)) > 0) {
+			size_t remainingLength = static_cast<size_t>(numberOfBytesRead);
+
+			for(const nlmsghdr * message = reinterpret_cast<const nlmsghdr *>(messageBuffer); NLMSG_OK(message, remainingLength); message = NLMSG_NEXT(message, remainingLength)) {
+				if(message->nlmsg_type != RTM_NEWADDR && message->nlmsg_type != RTM_DELADDR) {
+					continue;
+				}
+
+				const ifaddrmsg * addressMessage = reinterpret_cast<const ifaddrmsg *>(NLMSG_DATA(message));
+
+				// host and link scoped addresses are never the address the outside world sees
+				if(addressMessage->ifa_scope != RT_SCOPE_UNIVERSE) {
+					continue;
+				}
+
+				if(!m_interfaceName.empty()) {
+					char interfaceName[IF_NAMESIZE] = { '\0' };
+
+					if(if_indextoname(addressMessage->ifa_index, interfaceName) == nullptr || m_interfaceName != interfaceName) {
+						continue;
+					}
+				}
+
+				addressChanged = true;
+			}
+		}
+
+		return addressChanged;
+	}
+#endif // __linux__
+
+	std::this_thread::sleep_for(POLL_INTERVAL);
+
+	if(std::chrono::steady_clock::now() - m_lastAddressPollTime < ADDRESS_POLL_INTERVAL) {
+		return false;
+	}
+
+	m_lastAddressPollTime = std::chrono::steady_clock::now();
+
+	std::set<std::string> interfaceAddresses(getInterfaceAddresses());
+
+	if(interfaceAddresses == m_interfaceAddresses) {
+		return false;
+	}
+
+	m_interfaceAddresses = std::move(interfaceAddresses);
+
+	return true;
+}
+
+std::set<std::string> AddressChangeMonitor::getInterfaceAddresses() const {
+	std::set<std::string> interfaceAddresses;
+
+#if !_WIN32
+	ifaddrs * interfaceAddressList = nullptr;
+
+	if(getifaddrs(&interfaceAddressList) != 0) {
+		return interfaceAddresses;
+	}
+
+	for(const ifaddrs * interfaceAddress = interfaceAddressList; interfaceAddress != nullptr; interfaceAddress = interfaceAddress->ifa_next) {
+		if(interfaceAddress->ifa_addr == nullptr || (interfaceAddress->ifa_flags & IFF_LOOPBACK) != 0) {
+			continue;
+		}
+
+		if(!m_interfaceName.empty() && m_interfaceName != interfaceAddress->ifa_name) {
+			continue;
+		}
+
+		char addressText[INET6_ADDRSTRLEN] = { '\0' };
+
+		if(interfaceAddress->ifa_addr->sa_family == AF_INET) {
+			const in_addr & address = reinterpret_cast<const sockaddr_in *>(interfaceAddress->ifa_addr)->sin_addr;
+
+			// skip 169.254.0.0/16 link-local addresses
+			if((ntohl(address.s_addr) & 0xFFFF0000u) == 0xA9FE0000u) {
+				continue;
+			}
+
+			inet_ntop(AF_INET, &address, addressText, sizeof(addressText));
+		}
+		else if(interfaceAddress->ifa_addr->sa_family == AF_INET6) {
+			const in6_addr & address = reinterpret_cast<const sockaddr_in6 *>(interfaceAddress->ifa_addr)->sin6_addr;
+
+			if(IN6_IS_ADDR_LINKLOCAL(&address)) {
+				continue;
+			}
+
+			inet_ntop(AF_INET6, &address, addressText, sizeof(addressText));
+		}
+		else {
+			continue;
+		}
+
+		interfaceAddresses.insert(std::string(interfaceAddress->ifa_name) + "/" + addressText);
+	}
+
+	freeifaddrs(interfaceAddressList);
+#endif // !_WIN32
+
+	return interfaceAddresses;
+}
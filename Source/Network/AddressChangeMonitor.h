@@ -0,0 +1,50 @@
+#ifndef _ADDRESS_CHANGE_MONITOR_H_
+#define _ADDRESS_CHANGE_MONITOR_H_
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <set>
+#include <string>
+#include <thread>
+
+// notifies when a global IPv4 or IPv6 address is added to or removed from a network interface,
+// using rtnetlink on Linux and falling back to periodically comparing interface addresses elsewhere
+class AddressChangeMonitor final {
+public:
+	typedef std::function<void()> ChangeCallback;
+
+	AddressChangeMonitor(ChangeCallback changeCallback, const std::string & interfaceName = {}, std::chrono::milliseconds debounceInterval = DEFAULT_DEBOUNCE_INTERVAL);
+	~AddressChangeMonitor();
+
+	const std::string & getInterfaceName() const;
+	bool isRunning() const;
+	bool start();
+	void stop();
+
+	static const std::chrono::milliseconds DEFAULT_DEBOUNCE_INTERVAL;
+	static const std::chrono::milliseconds POLL_INTERVAL;
+	static const std::chrono::milliseconds ADDRESS_POLL_INTERVAL;
+
+private:
+	void run();
+	bool collectAddressChanges();
+	std::set<std::string> getInterfaceAddresses() const;
+
+	ChangeCallback m_changeCallback;
+	std::string m_interfaceName;
+	std::chrono::milliseconds m_debounceInterval;
+	std::atomic<bool> m_running;
+	std::thread m_monitorThread;
+	// interface addresses when last checked, only used by the polling fallback
+	std::set<std::string> m_interfaceAddresses;
+	std::chrono::steady_clock::time_point m_lastAddressPollTime;
+#if __linux__
+	int m_netlinkSocket;
+#endif // __linux__
+
+	AddressChangeMonitor(const AddressChangeMonitor &) = delete;
+	const AddressChangeMonitor & operator = (const AddressChangeMonitor &) = delete;
+};
+
+#endif // _ADDRESS_CHANGE_MONITOR_H_
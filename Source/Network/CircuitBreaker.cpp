@@ -0,0 +1,129 @@
+#include "CircuitBreaker.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+const size_t CircuitBreaker::DEFAULT_FAILURE_THRESHOLD = 5;
+const std::chrono::milliseconds CircuitBreaker::DEFAULT_RESET_TIMEOUT(60000);
+
+CircuitBreaker::CircuitBreaker(const std::string & name, size_t failureThreshold, std::chrono::milliseconds resetTimeout)
+	: m_name(name)
+	, m_failureThreshold(std::max(failureThreshold, static_cast<size_t>(1)))
+	, m_resetTimeout(std::max(resetTimeout, std::chrono::milliseconds(0)))
+	, m_state(State::Closed)
+	, m_numberOfConsecutiveFailures(0)
+	, m_trialRequestInProgress(false) { }
+
+CircuitBreaker::~CircuitBreaker() { }
+
+const std::string & CircuitBreaker::getName() const {
+	return m_name;
+}
+
+size_t CircuitBreaker::getFailureThreshold() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_failureThreshold;
+}
+
+void CircuitBreaker::setFailureThreshold(size_t failureThreshold) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_failureThreshold = std::max(failureThreshold, static_cast<size_t>(1));
+}
+
+std::chrono::milliseconds CircuitBreaker::getResetTimeout() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_resetTimeout;
+}
+
+void CircuitBreaker::setResetTimeout(std::chrono::milliseconds resetTimeout) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_resetTimeout = std::max(resetTimeout, std::chrono::milliseconds(0));
+}
+
+CircuitBreaker::State CircuitBreaker::getState() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_state;
+}
+
+size_t CircuitBreaker::numberOfConsecutiveFailures() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_numberOfConsecutiveFailures;
+}
+
+bool CircuitBreaker::allowRequest() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	switch(m_state) {
+		case State::Closed:
+			return true;
+
+		case State::Open:
+			if(std::chrono::steady_clock::now() - m_openedTime < m_resetTimeout) {
+				return false;
+			}
+
+			spdlog::info("Circuit breaker for '{}' is half open, sending a trial request.", m_name);
+
+			m_state = State::HalfOpen;
+			m_trialRequestInProgress = true;
+
+			return true;
+
+		case State::HalfOpen:
+			// only a single trial request is let through until it reports back
+			if(m_trialRequestInProgress) {
+				return false;
+			}
+
+			m_trialRequestInProgress = true;
+
+			return true;
+	}
+
+	return false;
+}
+
+void CircuitBreaker::recordSuccess() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(m_state != State::Closed) {
+		spdlog::info("Circuit breaker for '{}' closed, requests will resume.", m_name);
+	}
+
+	m_state = State::Closed;
+	m_numberOfConsecutiveFailures = 0;
+	m_trialRequestInProgress = false;
+}
+
+void CircuitBreaker::recordFailure() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_numberOfConsecutiveFailures++;
+
+	if(m_state == State::Open) {
+		return;
+	}
+
+	if(m_state == State::HalfOpen || m_numberOfConsecutiveFailures >= m_failureThreshold) {
+		spdlog::warn("Circuit breaker for '{}' opened after {} consecutive failures, suspending requests for {} ms.", m_name, m_numberOfConsecutiveFailures, m_resetTimeout.count());
+
+		m_state = State::Open;
+		m_trialRequestInProgress = false;
+		m_openedTime = std::chrono::steady_clock::now();
+	}
+}
+
+void CircuitBreaker::reset() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_state = State::Closed;
+	m_numberOfConsecutiveFailures = 0;
+	m_trialRequestInProgress = false;
+}
@@ -0,0 +1,50 @@
+#ifndef _CIRCUIT_BREAKER_H_
+#define _CIRCUIT_BREAKER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+class CircuitBreaker final {
+public:
+	enum class State {
+		Closed,
+		Open,
+		HalfOpen
+	};
+
+	CircuitBreaker(const std::string & name, size_t failureThreshold = DEFAULT_FAILURE_THRESHOLD, std::chrono::milliseconds resetTimeout = DEFAULT_RESET_TIMEOUT);
+	~CircuitBreaker();
+
+	const std::string & getName() const;
+	size_t getFailureThreshold() const;
+	void setFailureThreshold(size_t failureThreshold);
+	std::chrono::milliseconds getResetTimeout() const;
+	void setResetTimeout(std::chrono::milliseconds resetTimeout);
+	State getState() const;
+	size_t numberOfConsecutiveFailures() const;
+
+	bool allowRequest();
+	void recordSuccess();
+	void recordFailure();
+	void reset();
+
+	static const size_t DEFAULT_FAILURE_THRESHOLD;
+	static const std::chrono::milliseconds DEFAULT_RESET_TIMEOUT;
+
+private:
+	std::string m_name;
+	size_t m_failureThreshold;
+	std::chrono::milliseconds m_resetTimeout;
+	State m_state;
+	size_t m_numberOfConsecutiveFailures;
+	bool m_trialRequestInProgress;
+	std::chrono::steady_clock::time_point m_openedTime;
+	mutable std::mutex m_mutex;
+
+	CircuitBreaker(const CircuitBreaker &) = delete;
+	const CircuitBreaker & operator = (const CircuitBreaker &) = delete;
+};
+
+#endif // _CIRCUIT_BREAKER_H_
@@ -0,0 +1,240 @@
+#include "ExternalIPAddressResolver.h"
+
+#include "HTTPSessionPool.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <map>
+
+#if _WIN32
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#endif // _WIN32
+
+const std::vector<std::string> ExternalIPAddressResolver::DEFAULT_ENDPOINT_URLS({
+	"https://api.ipify.org",
+	"https://ipv4.icanhazip.com",
+	"https://checkip.amazonaws.com"
+});
+const std::vector<std::string> ExternalIPAddressResolver::DEFAULT_IPV6_ENDPOINT_URLS({
+	"https://api6.ipify.org",
+	"https://ipv6.icanhazip.com"
+});
+const size_t ExternalIPAddressResolver::DEFAULT_REQUIRED_AGREEMENT = 1;
+const std::chrono::milliseconds ExternalIPAddressResolver::DEFAULT_CACHE_DURATION(30000);
+const std::chrono::milliseconds ExternalIPAddressResolver::DEFAULT_TIMEOUT(10000);
+
+struct ExternalIPAddressResolver::Resolution {
+	std::mutex mutex;
+	std::condition_variable responseReceived;
+	std::map<std::string, size_t> ipAddressCounts;
+	size_t numberOfResponses = 0;
+	std::string ipAddress;
+	std::atomic<bool> cancelled = false;
+};
+
+ExternalIPAddressResolver::ExternalIPAddressResolver(std::shared_ptr<HTTPSessionPool> sessionPool, const std::vector<std::string> & endpointURLs, size_t requiredAgreement, std::chrono::milliseconds cacheDuration, std::chrono::milliseconds timeout, IPAddressService::IPAddressType ipAddressType)
+	: m_sessionPool(sessionPool)
+	, m_endpointURLs(endpointURLs)
+	, m_requiredAgreement(std::max(requiredAgreement, static_cast<size_t>(1)))
+	, m_cacheDuration(std::max(cacheDuration, std::chrono::milliseconds(0)))
+	, m_timeout(std::max(timeout, std::chrono::milliseconds(1)))
+	, m_ipAddressType(ipAddressType) { }
+
+ExternalIPAddressResolver::~ExternalIPAddressResolver() {
+	joinRequestThreads();
+}
+
+IPAddressService::IPAddressType ExternalIPAddressResolver::getIPAddressType() const {
+	return m_ipAddressType;
+}
+
+const std::vector<std::string> & ExternalIPAddressResolver::getEndpointURLs() const {
+	return m_endpointURLs;
+}
+
+void ExternalIPAddressResolver::setEndpointURLs(const std::vector<std::string> & endpointURLs) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_endpointURLs = endpointURLs;
+	m_cachedIPAddress.clear();
+}
+
+size_t ExternalIPAddressResolver::getRequiredAgreement() const {
+	return m_requiredAgreement;
+}
+
+void ExternalIPAddressResolver::setRequiredAgreement(size_t requiredAgreement) {
+	m_requiredAgreement = std::max(requiredAgreement, static_cast<size_t>(1));
+}
+
+std::chrono::milliseconds ExternalIPAddressResolver::getCacheDuration() const {
+	return m_cacheDuration;
+}
+
+void ExternalIPAddressResolver::setCacheDuration(std::chrono::milliseconds cacheDuration) {
+	m_cacheDuration = std::max(cacheDuration, std::chrono::milliseconds(0));
+}
+
+std::chrono::milliseconds ExternalIPAddressResolver::getTimeout() const {
+	return m_timeout;
+}
+
+void ExternalIPAddressResolver::setTimeout(std::chrono::milliseconds timeout) {
+	m_timeout = std::max(timeout, std::chrono::milliseconds(1));
+}
+
+void ExternalIPAddressResolver::clearCache() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_cachedIPAddress.clear();
+}
+
+bool ExternalIPAddressResolver::isValidIPv4Address(std::string_view ipAddress) {
+	size_t numberOfOctets = 0;
+	size_t numberOfDigits = 0;
+	uint16_t octet = 0;
+
+	for(char character : ipAddress) {
+		if(character == '.') {
+			if(numberOfDigits == 0) {
+				return false;
+			}
+
+			numberOfOctets++;
+			numberOfDigits = 0;
+			octet = 0;
+		}
+		else if(character >= '0' && character <= '9') {
+			octet = static_cast<uint16_t>(octet * 10 + (character - '0'));
+
+			if(++numberOfDigits > 3 || octet > 255) {
+				return false;
+			}
+		}
+		else {
+			return false;
+		}
+	}
+
+	return numberOfDigits != 0 && numberOfOctets == 3;
+}
+
+bool ExternalIPAddressResolver::isValidIPv6Address(std::string_view ipAddress) {
+	if(ipAddress.empty() || ipAddress.length() >= INET6_ADDRSTRLEN) {
+		return false;
+	}
+
+	std::string ipAddressString(ipAddress);
+	in6_addr address;
+
+	return inet_pton(AF_INET6, ipAddressString.c_str(), &address) == 1;
+}
+
+bool ExternalIPAddressResolver::isValidIPAddress(std::string_view ipAddress, IPAddressService::IPAddressType ipAddressType) {
+	return ipAddressType == IPAddressService::IPAddressType::V6 ? isValidIPv6Address(ipAddress) : isValidIPv4Address(ipAddress);
+}
+
+void ExternalIPAddressResolver::joinRequestThreads() {
+	for(std::thread & requestThread : m_requestThreads) {
+		if(requestThread.joinable()) {
+			requestThread.join();
+		}
+	}
+
+	m_requestThreads.clear();
+}
+
+std::string ExternalIPAddressResolver::resolveIPAddress(bool bypassCache) {
+	// only one resolution runs at a time, concurrent callers receive its cached result
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	if(!bypassCache && !m_cachedIPAddress.empty() && std::chrono::steady_clock::now() - m_cachedTime < m_cacheDuration) {
+		return m_cachedIPAddress;
+	}
+
+	if(m_sessionPool == nullptr || m_endpointURLs.empty()) {
+		spdlog::error("External IP address resolver has no session pool or endpoints to query.");
+		return {};
+	}
+
+	joinRequestThreads();
+
+	std::shared_ptr<Resolution> resolution(std::make_shared<Resolution>());
+	size_t numberOfEndpoints = m_endpointURLs.size();
+	size_t requiredAgreement = std::min(m_requiredAgreement, numberOfEndpoints);
+
+	for(const std::string & endpointURL : m_endpointURLs) {
+		m_requestThreads.emplace_back([sessionPool = m_sessionPool, resolution, endpointURL, requiredAgreement, ipAddressType = m_ipAddressType]() {
+			HTTPSessionPool::Response response(sessionPool->get(endpointURL, {}, &resolution->cancelled));
+			std::string ipAddress;
+
+			if(response.isFailure()) {
+				if(!resolution->cancelled) {
+					spdlog::debug("External IP address request to '{}' failed: {}", endpointURL, response.errorMessage);
+				}
+			}
+			else if(response.isFailureStatusCode()) {
+				spdlog::debug("External IP address request to '{}' failed with HTTP status code {}.", endpointURL, response.statusCode);
+			}
+			else {
+				ipAddress = Utilities::trimString(response.body);
+
+				if(!isValidIPAddress(ipAddress, ipAddressType)) {
+					spdlog::debug("External IP address endpoint '{}' returned an invalid IP address: '{}'.", endpointURL, ipAddress);
+					ipAddress.clear();
+				}
+			}
+
+			std::lock_guard<std::mutex> resolutionLock(resolution->mutex);
+
+			resolution->numberOfResponses++;
+
+			if(!ipAddress.empty() && resolution->ipAddress.empty() && ++resolution->ipAddressCounts[ipAddress] >= requiredAgreement) {
+				resolution->ipAddress = ipAddress;
+			}
+
+			resolution->responseReceived.notify_all();
+		});
+	}
+
+	std::string ipAddress;
+
+	{
+		std::unique_lock<std::mutex> resolutionLock(resolution->mutex);
+
+		resolution->responseReceived.wait_for(resolutionLock, m_timeout, [resolution, numberOfEndpoints]() {
+			return !resolution->ipAddress.empty() || resolution->numberOfResponses == numberOfEndpoints;
+		});
+
+		ipAddress = resolution->ipAddress;
+
+		if(ipAddress.empty()) {
+			if(resolution->ipAddressCounts.size() > 1) {
+				spdlog::error("External IP address endpoints disagreed, {} distinct addresses were reported with {} required to agree.", resolution->ipAddressCounts.size(), requiredAgreement);
+			}
+			else if(resolution->numberOfResponses < numberOfEndpoints) {
+				spdlog::error("Timed out after {} ms waiting for {} external IP address endpoint(s) to agree.", m_timeout.count(), requiredAgreement);
+			}
+			else {
+				spdlog::error("None of the {} external IP address endpoint(s) returned a usable IP address.", numberOfEndpoints);
+			}
+		}
+	}
+
+	// abort outstanding requests, their threads finish on their own and are joined on the next resolution
+	resolution->cancelled = true;
+
+	if(!ipAddress.empty()) {
+		m_cachedIPAddress = ipAddress;
+		m_cachedTime = std::chrono::steady_clock::now();
+	}
+
+	return ipAddress;
+}
@@ -0,0 +1,67 @@
+#ifndef _EXTERNAL_IP_ADDRESS_RESOLVER_H_
+#define _EXTERNAL_IP_ADDRESS_RESOLVER_H_
+
+#include <Network/IPAddressService.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+class HTTPSessionPool;
+
+// determines the external IP address by querying several plain text IP address echo endpoints at once,
+// accepting the first address reported by enough endpoints and cancelling the requests which are still outstanding
+class ExternalIPAddressResolver final {
+public:
+	ExternalIPAddressResolver(std::shared_ptr<HTTPSessionPool> sessionPool, const std::vector<std::string> & endpointURLs = DEFAULT_ENDPOINT_URLS, size_t requiredAgreement = DEFAULT_REQUIRED_AGREEMENT, std::chrono::milliseconds cacheDuration = DEFAULT_CACHE_DURATION, std::chrono::milliseconds timeout = DEFAULT_TIMEOUT, IPAddressService::IPAddressType ipAddressType = IPAddressService::IPAddressType::V4);
+	~ExternalIPAddressResolver();
+
+	IPAddressService::IPAddressType getIPAddressType() const;
+	const std::vector<std::string> & getEndpointURLs() const;
+	void setEndpointURLs(const std::vector<std::string> & endpointURLs);
+	size_t getRequiredAgreement() const;
+	void setRequiredAgreement(size_t requiredAgreement);
+	std::chrono::milliseconds getCacheDuration() const;
+	void setCacheDuration(std::chrono::milliseconds cacheDuration);
+	std::chrono::milliseconds getTimeout() const;
+	void setTimeout(std::chrono::milliseconds timeout);
+
+	std::string resolveIPAddress(bool bypassCache = false);
+	void clearCache();
+
+	static bool isValidIPv4Address(std::string_view ipAddress);
+	static bool isValidIPv6Address(std::string_view ipAddress);
+	static bool isValidIPAddress(std::string_view ipAddress, IPAddressService::IPAddressType ipAddressType);
+
+	static const std::vector<std::string> DEFAULT_ENDPOINT_URLS;
+	static const std::vector<std::string> DEFAULT_IPV6_ENDPOINT_URLS;
+	static const size_t DEFAULT_REQUIRED_AGREEMENT;
+	static const std::chrono::milliseconds DEFAULT_CACHE_DURATION;
+	static const std::chrono::milliseconds DEFAULT_TIMEOUT;
+
+private:
+	struct Resolution;
+
+	void joinRequestThreads();
+
+	std::shared_ptr<HTTPSessionPool> m_sessionPool;
+	std::vector<std::string> m_endpointURLs;
+	size_t m_requiredAgreement;
+	std::chrono::milliseconds m_cacheDuration;
+	std::chrono::milliseconds m_timeout;
+	IPAddressService::IPAddressType m_ipAddressType;
+	std::string m_cachedIPAddress;
+	std::chrono::steady_clock::time_point m_cachedTime;
+	// cancelled requests which may still be unwinding, joined before the next resolution starts
+	std::vector<std::thread> m_requestThreads;
+	mutable std::mutex m_mutex;
+
+	ExternalIPAddressResolver(const ExternalIPAddressResolver &) = delete;
+	const ExternalIPAddressResolver & operator = (const ExternalIPAddressResolver &) = delete;
+};
+
+#endif // _EXTERNAL_IP_ADDRESS_RESOLVER_H_
@@ -0,0 +1,337 @@
+#include "HTTPEventLoop.h"
+
+#include <spdlog/spdlog.h>
+
+#include <curl/curl.h>
+
+#include <algorithm>
+#include <thread>
+
+static_assert(CURL_ERROR_SIZE <= 256, "HTTP event loop request error buffer is too small.");
+
+const size_t HTTPEventLoop::DEFAULT_MAXIMUM_ACTIVE_REQUESTS = 64;
+const std::chrono::milliseconds HTTPEventLoop::MAXIMUM_POLL_INTERVAL(1000);
+
+bool HTTPEventLoop::Timer::operator > (const Timer & timer) const {
+	if(dueTime != timer.dueTime) {
+		return dueTime > timer.dueTime;
+	}
+
+	// timers due at the same time fire in the order they were added
+	return sequenceNumber > timer.sequenceNumber;
+}
+
+HTTPEventLoop::RequestAwaitable::RequestAwaitable(HTTPEventLoop & eventLoop, const std::string & url, const HTTPSessionPool::QueryParameters & queryParameters)
+	: m_eventLoop(eventLoop) {
+	// the query parameters are copied since the request may only start long after the caller's arguments have gone out of scope
+	m_request.url = url;
+	m_request.queryParameters.reserve(queryParameters.size());
+
+	for(const std::pair<std::string_view, std::string_view> & queryParameter : queryParameters) {
+		m_request.queryParameters.emplace_back(queryParameter.first, queryParameter.second);
+	}
+}
+
+bool HTTPEventLoop::RequestAwaitable::await_ready() const noexcept {
+	return false;
+}
+
+void HTTPEventLoop::RequestAwaitable::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+	m_request.awaitingCoroutine = awaitingCoroutine;
+
+	m_eventLoop.submitRequest(&m_request);
+}
+
+HTTPSessionPool::Response HTTPEventLoop::RequestAwaitable::await_resume() {
+	return std::move(m_request.response);
+}
+
+HTTPEventLoop::SleepAwaitable::SleepAwaitable(HTTPEventLoop & eventLoop, std::chrono::steady_clock::time_point dueTime)
+	: m_eventLoop(eventLoop)
+	, m_dueTime(dueTime) { }
+
+bool HTTPEventLoop::SleepAwaitable::await_ready() const noexcept {
+	return m_dueTime <= std::chrono::steady_clock::now();
+}
+
+void HTTPEventLoop::SleepAwaitable::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+	m_eventLoop.addTimer(m_dueTime, awaitingCoroutine);
+}
+
+void HTTPEventLoop::SleepAwaitable::await_resume() const noexcept { }
+
+HTTPEventLoop::HTTPEventLoop(const HTTPSessionPool::Configuration & configuration, size_t maximumActiveRequests)
+	: m_configuration(configuration)
+	, m_maximumActiveRequests(std::max(maximumActiveRequests, static_cast<size_t>(1)))
+	, m_multi(nullptr)
+	, m_numberOfActiveRequests(0)
+	, m_nextTimerSequenceNumber(0)
+	, m_numberOfRequestsSent(0)
+	, m_numberOfConnectionsOpened(0) {
+	// reference counted by cURL, safe to call alongside the HTTP service and session pool
+	if(curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+		spdlog::error("Failed to initialize cURL for HTTP event loop.");
+		return;
+	}
+
+	CURLM * multi = curl_multi_init();
+
+	if(multi == nullptr) {
+		spdlog::error("Failed to create cURL multi handle for HTTP event loop.");
+		curl_global_cleanup();
+		return;
+	}
+
+	// every request made through the multi handle shares its connection cache, so with HTTP/2 concurrent requests to one host are multiplexed over a single connection
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+	curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, static_cast<long>(m_maximumActiveRequests));
+	curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(m_maximumActiveRequests));
+
+	m_multi = multi;
+}
+
+HTTPEventLoop::~HTTPEventLoop() {
+	for(void * session : m_idleSessions) {
+		curl_easy_cleanup(session);
+	}
+
+	m_idleSessions.clear();
+
+	if(m_multi != nullptr) {
+		curl_multi_cleanup(m_multi);
+		m_multi = nullptr;
+
+		curl_global_cleanup();
+	}
+}
+
+bool HTTPEventLoop::isValid() const {
+	return m_multi != nullptr;
+}
+
+const HTTPSessionPool::Configuration & HTTPEventLoop::getConfiguration() const {
+	return m_configuration;
+}
+
+size_t HTTPEventLoop::getMaximumActiveRequests() const {
+	return m_maximumActiveRequests;
+}
+
+size_t HTTPEventLoop::numberOfActiveRequests() const {
+	return m_numberOfActiveRequests;
+}
+
+size_t HTTPEventLoop::numberOfPendingRequests() const {
+	return m_pendingRequests.size();
+}
+
+size_t HTTPEventLoop::numberOfRequestsSent() const {
+	return m_numberOfRequestsSent;
+}
+
+size_t HTTPEventLoop::numberOfConnectionsOpened() const {
+	return m_numberOfConnectionsOpened;
+}
+
+HTTPEventLoop::RequestAwaitable HTTPEventLoop::get(const std::string & url, const HTTPSessionPool::QueryParameters & queryParameters) {
+	return RequestAwaitable(*this, url, queryParameters);
+}
+
+HTTPEventLoop::SleepAwaitable HTTPEventLoop::sleepFor(std::chrono::steady_clock::duration delay) {
+	return SleepAwaitable(*this, std::chrono::steady_clock::now() + delay);
+}
+
+HTTPEventLoop::SleepAwaitable HTTPEventLoop::sleepUntil(std::chrono::steady_clock::time_point dueTime) {
+	return SleepAwaitable(*this, dueTime);
+}
+
+void HTTPEventLoop::run(std::vector<Task<void>> & tasks) {
+	std::lock_guard<std::mutex> lock(m_runMutex);
+
+	for(const Task<void> & task : tasks) {
+		schedule(task.getHandle());
+	}
+
+	while(runOnce()) { }
+}
+
+void HTTPEventLoop::schedule(std::coroutine_handle<> coroutine) {
+	if(coroutine) {
+		m_readyCoroutines.push_back(coroutine);
+	}
+}
+
+void HTTPEventLoop::submitRequest(Request * request) {
+	if(m_numberOfActiveRequests >= m_maximumActiveRequests) {
+		m_pendingRequests.push_back(request);
+		return;
+	}
+
+	startRequest(request);
+}
+
+void HTTPEventLoop::startRequest(Request * request) {
+	if(m_multi == nullptr) {
+		request->response.errorMessage = "HTTP event loop is not initialized.";
+		schedule(request->awaitingCoroutine);
+		return;
+	}
+
+	CURL * session = acquireSession();
+
+	if(session == nullptr) {
+		request->response.errorMessage = "Failed to create cURL session.";
+		schedule(request->awaitingCoroutine);
+		return;
+	}
+
+	HTTPSessionPool::QueryParameters queryParameters;
+	queryParameters.reserve(request->queryParameters.size());
+
+	for(const std::pair<std::string, std::string> & queryParameter : request->queryParameters) {
+		queryParameters.emplace_back(queryParameter.first, queryParameter.second);
+	}
+
+	request->session = session;
+	request->fullURL = HTTPSessionPool::createURL(session, request->url, queryParameters);
+	request->errorBuffer[0] = '\0';
+
+	HTTPSessionPool::configureSession(session, m_configuration);
+	curl_easy_setopt(session, CURLOPT_URL, request->fullURL.c_str());
+	curl_easy_setopt(session, CURLOPT_ERRORBUFFER, request->errorBuffer.data());
+	curl_easy_setopt(session, CURLOPT_WRITEDATA, &request->response.body);
+	curl_easy_setopt(session, CURLOPT_PRIVATE, request);
+	// wait for an in-progress connection to the same host to offer HTTP/2 multiplexing rather than opening another
+	curl_easy_setopt(session, CURLOPT_PIPEWAIT, 1L);
+
+	if(curl_multi_add_handle(m_multi, session) != CURLM_OK) {
+		request->response.errorMessage = "Failed to add cURL session to multi handle.";
+		request->session = nullptr;
+		releaseSession(session);
+		schedule(request->awaitingCoroutine);
+		return;
+	}
+
+	m_numberOfActiveRequests++;
+}
+
+void HTTPEventLoop::completeRequest(Request * request) {
+	CURL * session = request->session;
+
+	m_numberOfRequestsSent++;
+
+	long numberOfConnections = 0;
+	curl_easy_getinfo(session, CURLINFO_NUM_CONNECTS, &numberOfConnections);
+
+	if(numberOfConnections > 0) {
+		request->response.newConnection = true;
+		m_numberOfConnectionsOpened += static_cast<size_t>(numberOfConnections);
+	}
+
+	curl_multi_remove_handle(m_multi, session);
+	request->session = nullptr;
+	releaseSession(session);
+	m_numberOfActiveRequests--;
+
+	schedule(request->awaitingCoroutine);
+
+	if(!m_pendingRequests.empty()) {
+		Request * pendingRequest = m_pendingRequests.front();
+		m_pendingRequests.pop_front();
+
+		startRequest(pendingRequest);
+	}
+}
+
+void HTTPEventLoop::addTimer(std::chrono::steady_clock::time_point dueTime, std::coroutine_handle<> coroutine) {
+	m_timers.push({ dueTime, m_nextTimerSequenceNumber++, coroutine });
+}
+
+void * HTTPEventLoop::acquireSession() {
+	if(!m_idleSessions.empty()) {
+		void * session = m_idleSessions.back();
+		m_idleSessions.pop_back();
+
+		return session;
+	}
+
+	return curl_easy_init();
+}
+
+void HTTPEventLoop::releaseSession(void * session) {
+	// connections belong to the multi handle, so a reset session can be handed to any later request
+	curl_easy_reset(session);
+
+	m_idleSessions.push_back(session);
+}
+
+bool HTTPEventLoop::runOnce() {
+	// coroutines resumed here may schedule further coroutines, which run on the next pass so that network activity is never starved
+	std::deque<std::coroutine_handle<>> readyCoroutines;
+	readyCoroutines.swap(m_readyCoroutines);
+
+	for(std::coroutine_handle<> coroutine : readyCoroutines) {
+		coroutine.resume();
+	}
+
+	if(m_multi != nullptr && m_numberOfActiveRequests != 0) {
+		int numberOfRunningTransfers = 0;
+		curl_multi_perform(m_multi, &numberOfRunningTransfers);
+
+		CURLMsg * message = nullptr;
+		int numberOfQueuedMessages = 0;
+
+		while((message = curl_multi_info_read(m_multi, &numberOfQueuedMessages)) != nullptr) {
+			if(message->msg != CURLMSG_DONE) {
+				continue;
+			}
+
+			Request * request = nullptr;
+			curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &request);
+
+			if(message->data.result != CURLE_OK) {
+				request->response.errorMessage = request->errorBuffer[0] != '\0' ? std::string(request->errorBuffer.data()) : std::string(curl_easy_strerror(message->data.result));
+			}
+			else {
+				long statusCode = 0;
+				curl_easy_getinfo(message->easy_handle, CURLINFO_RESPONSE_CODE, &statusCode);
+
+				request->response.completed = true;
+				request->response.statusCode = static_cast<uint16_t>(statusCode);
+			}
+
+			completeRequest(request);
+		}
+	}
+
+	std::chrono::steady_clock::time_point currentTime(std::chrono::steady_clock::now());
+
+	while(!m_timers.empty() && m_timers.top().dueTime <= currentTime) {
+		schedule(m_timers.top().coroutine);
+		m_timers.pop();
+	}
+
+	if(!m_readyCoroutines.empty()) {
+		return true;
+	}
+
+	if(m_numberOfActiveRequests == 0 && m_timers.empty()) {
+		return false;
+	}
+
+	std::chrono::milliseconds pollTimeout(MAXIMUM_POLL_INTERVAL);
+
+	if(!m_timers.empty()) {
+		pollTimeout = std::min(pollTimeout, std::chrono::ceil<std::chrono::milliseconds>(m_timers.top().dueTime - currentTime));
+	}
+
+	if(m_multi != nullptr && m_numberOfActiveRequests != 0) {
+		// also returns early when cURL's own timeouts are due
+		curl_multi_poll(m_multi, nullptr, 0, static_cast<int>(pollTimeout.count()), nullptr);
+	}
+	else {
+		std::this_thread::sleep_for(pollTimeout);
+	}
+
+	return true;
+}
@@ -0,0 +1,133 @@
+#ifndef _HTTP_EVENT_LOOP_H_
+#define _HTTP_EVENT_LOOP_H_
+
+#include "HTTPSessionPool.h"
+#include "Scheduling/Task.h"
+
+#include <array>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+// drives coroutine tasks and their HTTP requests from whichever single thread calls run, multiplexing every in-flight request over one cURL multi handle,
+// so thousands of requests can be outstanding at once without a thread per request, requests beyond the active request limit wait in arrival order
+class HTTPEventLoop final {
+public:
+	class RequestAwaitable;
+	class SleepAwaitable;
+
+	HTTPEventLoop(const HTTPSessionPool::Configuration & configuration, size_t maximumActiveRequests = DEFAULT_MAXIMUM_ACTIVE_REQUESTS);
+	~HTTPEventLoop();
+
+	bool isValid() const;
+	const HTTPSessionPool::Configuration & getConfiguration() const;
+	size_t getMaximumActiveRequests() const;
+	size_t numberOfActiveRequests() const;
+	size_t numberOfPendingRequests() const;
+	size_t numberOfRequestsSent() const;
+	size_t numberOfConnectionsOpened() const;
+
+	RequestAwaitable get(const std::string & url, const HTTPSessionPool::QueryParameters & queryParameters = {});
+	SleepAwaitable sleepFor(std::chrono::steady_clock::duration delay);
+	SleepAwaitable sleepUntil(std::chrono::steady_clock::time_point dueTime);
+	// for awaitables implemented outside of the event loop, only safe to call from the thread running it
+	void schedule(std::coroutine_handle<> coroutine);
+	void addTimer(std::chrono::steady_clock::time_point dueTime, std::coroutine_handle<> coroutine);
+
+	template <typename T>
+	T run(Task<T> task);
+	void run(std::vector<Task<void>> & tasks);
+
+	static const size_t DEFAULT_MAXIMUM_ACTIVE_REQUESTS;
+	static const std::chrono::milliseconds MAXIMUM_POLL_INTERVAL;
+
+private:
+	struct Request {
+		std::string url;
+		std::vector<std::pair<std::string, std::string>> queryParameters;
+		HTTPSessionPool::Response response;
+		std::coroutine_handle<> awaitingCoroutine;
+		void * session = nullptr;
+		std::string fullURL;
+		std::array<char, 256> errorBuffer;
+	};
+
+	struct Timer {
+		std::chrono::steady_clock::time_point dueTime;
+		uint64_t sequenceNumber;
+		std::coroutine_handle<> coroutine;
+
+		bool operator > (const Timer & timer) const;
+	};
+
+public:
+	class RequestAwaitable final {
+	public:
+		RequestAwaitable(HTTPEventLoop & eventLoop, const std::string & url, const HTTPSessionPool::QueryParameters & queryParameters);
+
+		bool await_ready() const noexcept;
+		void await_suspend(std::coroutine_handle<> awaitingCoroutine);
+		HTTPSessionPool::Response await_resume();
+
+	private:
+		HTTPEventLoop & m_eventLoop;
+		Request m_request;
+	};
+
+	class SleepAwaitable final {
+	public:
+		SleepAwaitable(HTTPEventLoop & eventLoop, std::chrono::steady_clock::time_point dueTime);
+
+		bool await_ready() const noexcept;
+		void await_suspend(std::coroutine_handle<> awaitingCoroutine);
+		void await_resume() const noexcept;
+
+	private:
+		HTTPEventLoop & m_eventLoop;
+		std::chrono::steady_clock::time_point m_dueTime;
+	};
+
+private:
+	void submitRequest(Request * request);
+	void startRequest(Request * request);
+	void completeRequest(Request * request);
+	void * acquireSession();
+	void releaseSession(void * session);
+	// runs ready coroutines and waits for network activity or the next timer, returns false once there is nothing left to wait for
+	bool runOnce();
+
+	HTTPSessionPool::Configuration m_configuration;
+	size_t m_maximumActiveRequests;
+	void * m_multi;
+	std::vector<void *> m_idleSessions;
+	size_t m_numberOfActiveRequests;
+	std::deque<Request *> m_pendingRequests;
+	std::deque<std::coroutine_handle<>> m_readyCoroutines;
+	std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> m_timers;
+	uint64_t m_nextTimerSequenceNumber;
+	size_t m_numberOfRequestsSent;
+	size_t m_numberOfConnectionsOpened;
+	std::mutex m_runMutex;
+
+	HTTPEventLoop(const HTTPEventLoop &) = delete;
+	const HTTPEventLoop & operator = (const HTTPEventLoop &) = delete;
+};
+
+template <typename T>
+T HTTPEventLoop::run(Task<T> task) {
+	std::lock_guard<std::mutex> lock(m_runMutex);
+
+	schedule(task.getHandle());
+
+	while(!task.isDone() && runOnce()) { }
+
+	return task.getResult();
+}
+
+#endif // _HTTP_EVENT_LOOP_H_
@@ -0,0 +1,234 @@
+#include "HTTPSessionPool.h"
+
+#include <spdlog/spdlog.h>
+
+#include <curl/curl.h>
+
+static_assert(CURL_LOCK_DATA_LAST <= 8, "Not enough share locks for every category of cURL shared data.");
+
+typedef std::array<std::mutex, 8> ShareMutexes;
+
+static void lockShareData(CURL *, curl_lock_data data, curl_lock_access, void * shareMutexes) {
+	(*static_cast<ShareMutexes *>(shareMutexes))[data].lock();
+}
+
+static void unlockShareData(CURL *, curl_lock_data data, void * shareMutexes) {
+	(*static_cast<ShareMutexes *>(shareMutexes))[data].unlock();
+}
+
+static int onTransferProgress(void * cancelled, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+	return static_cast<const std::atomic<bool> *>(cancelled)->load() ? 1 : 0;
+}
+
+bool HTTPSessionPool::Response::isFailure() const {
+	return !completed;
+}
+
+bool HTTPSessionPool::Response::isFailureStatusCode() const {
+	return statusCode < 200 || statusCode >= 300;
+}
+
+HTTPSessionPool::HTTPSessionPool(const Configuration & configuration)
+	: m_configuration(configuration)
+	, m_share(nullptr)
+	, m_numberOfRequestsSent(0)
+	, m_numberOfConnectionsOpened(0) {
+	// reference counted by cURL, safe to call alongside the HTTP service
+	if(curl_global_init(CURL_GLOBAL_DEFAULT) != CURLE_OK) {
+		spdlog::error("Failed to initialize cURL for HTTP session pool.");
+		return;
+	}
+
+	CURLSH * share = curl_share_init();
+
+	if(share == nullptr) {
+		spdlog::error("Failed to create cURL share handle for HTTP session pool.");
+		return;
+	}
+
+	curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lockShareData);
+	curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlockShareData);
+	curl_share_setopt(share, CURLSHOPT_USERDATA, &m_shareMutexes);
+	// connections are deliberately not shared, cURL does not support using a shared connection cache from concurrent threads,
+	// instead each pooled session keeps its own connections alive between requests
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+
+	m_share = share;
+}
+
+HTTPSessionPool::~HTTPSessionPool() {
+	for(void * session : m_idleSessions) {
+		curl_easy_cleanup(session);
+	}
+
+	m_idleSessions.clear();
+
+	if(m_share != nullptr) {
+		curl_share_cleanup(m_share);
+		m_share = nullptr;
+
+		curl_global_cleanup();
+	}
+}
+
+bool HTTPSessionPool::isValid() const {
+	return m_share != nullptr;
+}
+
+const HTTPSessionPool::Configuration & HTTPSessionPool::getConfiguration() const {
+	return m_configuration;
+}
+
+size_t HTTPSessionPool::numberOfIdleSessions() const {
+	std::lock_guard<std::mutex> lock(m_idleSessionsMutex);
+
+	return m_idleSessions.size();
+}
+
+size_t HTTPSessionPool::numberOfRequestsSent() const {
+	return m_numberOfRequestsSent;
+}
+
+size_t HTTPSessionPool::numberOfConnectionsOpened() const {
+	return m_numberOfConnectionsOpened;
+}
+
+void * HTTPSessionPool::acquireSession() {
+	{
+		std::lock_guard<std::mutex> lock(m_idleSessionsMutex);
+
+		if(!m_idleSessions.empty()) {
+			void * session = m_idleSessions.back();
+			m_idleSessions.pop_back();
+
+			return session;
+		}
+	}
+
+	return curl_easy_init();
+}
+
+void HTTPSessionPool::releaseSession(void * session) {
+	// resetting clears per-request options but keeps the session's open connections, the shared caches are re-attached on the next request
+	curl_easy_reset(session);
+
+	std::lock_guard<std::mutex> lock(m_idleSessionsMutex);
+
+	m_idleSessions.push_back(session);
+}
+
+std::string HTTPSessionPool::createURL(void * session, const std::string & url, const QueryParameters & queryParameters) {
+	std::string fullURL(url);
+
+	for(QueryParameters::const_iterator queryParameterIterator = queryParameters.cbegin(); queryParameterIterator != queryParameters.cend(); ++queryParameterIterator) {
+		char * encodedName = curl_easy_escape(session, queryParameterIterator->first.data(), static_cast<int>(queryParameterIterator->first.length()));
+		char * encodedValue = curl_easy_escape(session, queryParameterIterator->second.data(), static_cast<int>(queryParameterIterator->second.length()));
+
+		fullURL.append(queryParameterIterator == queryParameters.cbegin() && fullURL.find('?') == std::string::npos ? "?" : "&");
+		fullURL.append(encodedName != nullptr ? encodedName : "");
+		fullURL.append("=");
+		fullURL.append(encodedValue != nullptr ? encodedValue : "");
+
+		curl_free(encodedName);
+		curl_free(encodedValue);
+	}
+
+	return fullURL;
+}
+
+void HTTPSessionPool::configureSession(void * session, const Configuration & configuration) {
+	curl_easy_setopt(session, CURLOPT_HTTPGET, 1L);
+	curl_easy_setopt(session, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(session, CURLOPT_WRITEFUNCTION, onBodyDataReceived);
+	curl_easy_setopt(session, CURLOPT_TCP_KEEPALIVE, 1L);
+	curl_easy_setopt(session, CURLOPT_CONNECTTIMEOUT, static_cast<long>(configuration.connectionTimeout.count()));
+	curl_easy_setopt(session, CURLOPT_TIMEOUT, static_cast<long>(configuration.transferTimeout.count()));
+	curl_easy_setopt(session, CURLOPT_VERBOSE, configuration.verboseLoggingEnabled ? 1L : 0L);
+
+	if(configuration.networkTimeout.count() > 0) {
+		// abort if the transfer stalls rather than capping the total duration
+		curl_easy_setopt(session, CURLOPT_LOW_SPEED_LIMIT, 1L);
+		curl_easy_setopt(session, CURLOPT_LOW_SPEED_TIME, static_cast<long>(configuration.networkTimeout.count()));
+	}
+
+	if(configuration.http2Enabled) {
+		// negotiate HTTP/2 over TLS through ALPN, falling back to HTTP/1.1 when the server does not offer it
+		curl_easy_setopt(session, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_2TLS));
+	}
+	else {
+		curl_easy_setopt(session, CURLOPT_HTTP_VERSION, static_cast<long>(CURL_HTTP_VERSION_1_1));
+	}
+
+	if(!configuration.certificateAuthorityFilePath.empty()) {
+		curl_easy_setopt(session, CURLOPT_CAINFO, configuration.certificateAuthorityFilePath.c_str());
+	}
+
+	if(!configuration.userAgent.empty()) {
+		curl_easy_setopt(session, CURLOPT_USERAGENT, configuration.userAgent.c_str());
+	}
+}
+
+size_t HTTPSessionPool::onBodyDataReceived(char * data, size_t size, size_t count, void * body) {
+	static_cast<std::string *>(body)->append(data, size * count);
+
+	return size * count;
+}
+
+HTTPSessionPool::Response HTTPSessionPool::get(const std::string & url, const QueryParameters & queryParameters, const std::atomic<bool> * cancelled) {
+	Response response;
+
+	if(m_share == nullptr) {
+		response.errorMessage = "HTTP session pool is not initialized.";
+		return response;
+	}
+
+	CURL * session = acquireSession();
+
+	if(session == nullptr) {
+		response.errorMessage = "Failed to create cURL session.";
+		return response;
+	}
+
+	std::string fullURL(createURL(session, url, queryParameters));
+	char errorBuffer[CURL_ERROR_SIZE] = { '\0' };
+
+	configureSession(session, m_configuration);
+	curl_easy_setopt(session, CURLOPT_SHARE, m_share);
+	curl_easy_setopt(session, CURLOPT_URL, fullURL.c_str());
+	curl_easy_setopt(session, CURLOPT_ERRORBUFFER, errorBuffer);
+	curl_easy_setopt(session, CURLOPT_WRITEDATA, &response.body);
+
+	if(cancelled != nullptr) {
+		curl_easy_setopt(session, CURLOPT_NOPROGRESS, 0L);
+		curl_easy_setopt(session, CURLOPT_XFERINFOFUNCTION, onTransferProgress);
+		curl_easy_setopt(session, CURLOPT_XFERINFODATA, cancelled);
+	}
+
+	CURLcode result = curl_easy_perform(session);
+
+	m_numberOfRequestsSent++;
+
+	long numberOfConnections = 0;
+	curl_easy_getinfo(session, CURLINFO_NUM_CONNECTS, &numberOfConnections);
+
+	if(numberOfConnections > 0) {
+		response.newConnection = true;
+		m_numberOfConnectionsOpened += static_cast<size_t>(numberOfConnections);
+	}
+
+	if(result != CURLE_OK) {
+		response.errorMessage = errorBuffer[0] != '\0' ? std::string(errorBuffer) : std::string(curl_easy_strerror(result));
+	}
+	else {
+		long statusCode = 0;
+		curl_easy_getinfo(session, CURLINFO_RESPONSE_CODE, &statusCode);
+
+		response.completed = true;
+		response.statusCode = static_cast<uint16_t>(statusCode);
+	}
+
+	releaseSession(session);
+
+	return response;
+}
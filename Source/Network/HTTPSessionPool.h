@@ -0,0 +1,75 @@
+#ifndef _HTTP_SESSION_POOL_H_
+#define _HTTP_SESSION_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// pool of persistent cURL sessions which keep their connections alive between requests and share one DNS cache and TLS session cache,
+// so that repeated requests to the same host reuse an open connection or resume a TLS session instead of performing a full handshake each time
+class HTTPSessionPool final {
+public:
+	struct Configuration {
+		std::string certificateAuthorityFilePath;
+		std::string userAgent;
+		std::chrono::seconds connectionTimeout = std::chrono::seconds(15);
+		std::chrono::seconds networkTimeout = std::chrono::seconds(30);
+		std::chrono::seconds transferTimeout = std::chrono::seconds(0);
+		bool http2Enabled = true;
+		bool verboseLoggingEnabled = false;
+	};
+
+	struct Response {
+		bool completed = false;
+		uint16_t statusCode = 0;
+		std::string body;
+		std::string errorMessage;
+		bool newConnection = false;
+
+		bool isFailure() const;
+		bool isFailureStatusCode() const;
+	};
+
+	typedef std::vector<std::pair<std::string_view, std::string_view>> QueryParameters;
+
+	HTTPSessionPool(const Configuration & configuration);
+	~HTTPSessionPool();
+
+	bool isValid() const;
+	const Configuration & getConfiguration() const;
+	size_t numberOfIdleSessions() const;
+	size_t numberOfRequestsSent() const;
+	size_t numberOfConnectionsOpened() const;
+
+	// the request is aborted as soon as possible once the optional cancelled flag is set
+	Response get(const std::string & url, const QueryParameters & queryParameters = {}, const std::atomic<bool> * cancelled = nullptr);
+
+	// cURL easy and share handles are opaque pointers, kept as void pointers so that this header does not depend on cURL
+	static void configureSession(void * session, const Configuration & configuration);
+	static std::string createURL(void * session, const std::string & url, const QueryParameters & queryParameters);
+	static size_t onBodyDataReceived(char * data, size_t size, size_t count, void * body);
+
+private:
+	void * acquireSession();
+	void releaseSession(void * session);
+
+	Configuration m_configuration;
+	void * m_share;
+	std::vector<void *> m_idleSessions;
+	mutable std::mutex m_idleSessionsMutex;
+	// one lock per category of shared data, indexed by curl_lock_data
+	std::array<std::mutex, 8> m_shareMutexes;
+	std::atomic<size_t> m_numberOfRequestsSent;
+	std::atomic<size_t> m_numberOfConnectionsOpened;
+
+	HTTPSessionPool(const HTTPSessionPool &) = delete;
+	const HTTPSessionPool & operator = (const HTTPSessionPool &) = delete;
+};
+
+#endif // _HTTP_SESSION_POOL_H_
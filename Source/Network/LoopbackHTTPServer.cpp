@@ -0,0 +1,303 @@
+#include "LoopbackHTTPServer.h"
+
+#include <fmt/core.h>
+#include <spdlog/spdlog.h>
+
+#if _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+#if _WIN32
+static constexpr uintptr_t INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#define pollSockets WSAPoll
+#else
+static constexpr int INVALID_SOCKET_HANDLE = -1;
+#define pollSockets poll
+#endif
+
+// a client disconnecting mid-response must fail the send rather than raise SIGPIPE and terminate the process
+#if defined(MSG_NOSIGNAL)
+static constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+static constexpr int SEND_FLAGS = 0;
+#endif
+
+static constexpr int SOCKET_POLL_INTERVAL_MS = 100;
+static constexpr size_t RECEIVE_BUFFER_SIZE = 4096;
+static const std::string HTTP_HEADER_TERMINATOR("\r\n\r\n");
+
+LoopbackHTTPServer::LoopbackHTTPServer(uint16_t statusCode, const std::string & contentType, const std::string & responseBody)
+	: m_response(createResponse(statusCode, contentType, responseBody))
+	, m_contentType(contentType)
+	, m_listeningSocket(INVALID_SOCKET_HANDLE)
+	, m_port(0)
+	, m_running(false)
+	, m_numberOfRequestsServed(0) { }
+
+LoopbackHTTPServer::LoopbackHTTPServer(ResponseBodyFunction responseBodyFunction, const std::string & contentType)
+	: m_responseBodyFunction(responseBodyFunction)
+	, m_contentType(contentType)
+	, m_listeningSocket(INVALID_SOCKET_HANDLE)
+	, m_port(0)
+	, m_running(false)
+	, m_numberOfRequestsServed(0) { }
+
+LoopbackHTTPServer::~LoopbackHTTPServer() {
+	stop();
+}
+
+bool LoopbackHTTPServer::isRunning() const {
+	return m_running;
+}
+
+uint16_t LoopbackHTTPServer::getPort() const {
+	return m_port;
+}
+
+std::string LoopbackHTTPServer::getBaseURL() const {
+	return fmt::format("http://127.0.0.1:{}", m_port);
+}
+
+size_t LoopbackHTTPServer::numberOfRequestsServed() const {
+	return m_numberOfRequestsServed;
+}
+
+bool LoopbackHTTPServer::start(uint16_t port) {
+	if(m_running) {
+		return true;
+	}
+
+#if _WIN32
+	WSADATA windowsSocketsData;
+
+	if(WSAStartup(MAKEWORD(2, 2), &windowsSocketsData) != 0) {
+		spdlog::error("Failed to initialize Windows sockets.");
+		return false;
+	}
+#endif
+
+	m_listeningSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+
+	if(m_listeningSocket == INVALID_SOCKET_HANDLE) {
+		spdlog::error("Failed to create loopback HTTP server socket.");
+		return false;
+	}
+
+	int reuseAddress = 1;
+	setsockopt(m_listeningSocket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&reuseAddress), sizeof(reuseAddress));
+
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+
+	if(bind(m_listeningSocket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 || listen(m_listeningSocket, SOMAXCONN) != 0) {
+		spdlog::error("Failed to bind loopback HTTP server to port {}.", port);
+		closeSocket(m_listeningSocket);
+		m_listeningSocket = INVALID_SOCKET_HANDLE;
+		return false;
+	}
+
+	socklen_t addressLength = sizeof(address);
+
+	if(getsockname(m_listeningSocket, reinterpret_cast<sockaddr *>(&address), &addressLength) != 0) {
+		closeSocket(m_listeningSocket);
+		m_listeningSocket = INVALID_SOCKET_HANDLE;
+		return false;
+	}
+
+	m_port = ntohs(address.sin_port);
+	m_numberOfRequestsServed = 0;
+	m_running = true;
+	m_acceptThread = std::thread(&LoopbackHTTPServer::acceptConnections, this);
+
+	spdlog::debug("Loopback HTTP server listening on port {}.", m_port);
+
+	return true;
+}
+
+void LoopbackHTTPServer::stop() {
+	if(!m_running) {
+		return;
+	}
+
+	m_running = false;
+
+	if(m_acceptThread.joinable()) {
+		m_acceptThread.join();
+	}
+
+	std::vector<std::thread> connectionThreads;
+
+	{
+		std::lock_guard<std::mutex> lock(m_connectionThreadsMutex);
+		connectionThreads.swap(m_connectionThreads);
+		m_finishedConnectionThreadIDs.clear();
+	}
+
+	for(std::thread & connectionThread : connectionThreads) {
+		connectionThread.join();
+	}
+
+	closeSocket(m_listeningSocket);
+	m_listeningSocket = INVALID_SOCKET_HANDLE;
+	m_port = 0;
+
+#if _WIN32
+	WSACleanup();
+#endif
+}
+
+void LoopbackHTTPServer::acceptConnections() {
+	pollfd listeningSocketPollEntry;
+	listeningSocketPollEntry.fd = m_listeningSocket;
+	listeningSocketPollEntry.events = POLLIN;
+
+	while(m_running) {
+		listeningSocketPollEntry.revents = 0;
+
+		if(pollSockets(&listeningSocketPollEntry, 1, SOCKET_POLL_INTERVAL_MS) <= 0 || !(listeningSocketPollEntry.revents & POLLIN)) {
+			continue;
+		}
+
+		SocketHandle connectionSocket = accept(m_listeningSocket, nullptr, nullptr);
+
+		if(connectionSocket == INVALID_SOCKET_HANDLE) {
+			continue;
+		}
+
+#if defined(SO_NOSIGPIPE)
+		int noSignalPipe = 1;
+		setsockopt(connectionSocket, SOL_SOCKET, SO_NOSIGPIPE, &noSignalPipe, sizeof(noSignalPipe));
+#endif
+
+		reapConnectionThreads();
+
+		std::lock_guard<std::mutex> lock(m_connectionThreadsMutex);
+		m_connectionThreads.emplace_back(&LoopbackHTTPServer::handleConnection, this, connectionSocket);
+	}
+}
+
+void LoopbackHTTPServer::reapConnectionThreads() {
+	std::vector<std::thread> finishedConnectionThreads;
+
+	{
+		std::lock_guard<std::mutex> lock(m_connectionThreadsMutex);
+
+		if(m_finishedConnectionThreadIDs.empty()) {
+			return;
+		}
+
+		for(std::vector<std::thread>::iterator i = m_connectionThreads.begin(); i != m_connectionThreads.end();) {
+			std::vector<std::thread::id>::iterator finishedConnectionThreadIDIterator(std::find(m_finishedConnectionThreadIDs.begin(), m_finishedConnectionThreadIDs.end(), i->get_id()));
+
+			if(finishedConnectionThreadIDIterator == m_finishedConnectionThreadIDs.end()) {
+				++i;
+				continue;
+			}
+
+			m_finishedConnectionThreadIDs.erase(finishedConnectionThreadIDIterator);
+			finishedConnectionThreads.push_back(std::move(*i));
+			i = m_connectionThreads.erase(i);
+		}
+	}
+
+	// finished threads have at most their return left to run, so joining them does not hold up accepting connections
+	for(std::thread & finishedConnectionThread : finishedConnectionThreads) {
+		finishedConnectionThread.join();
+	}
+}
+
+void LoopbackHTTPServer::handleConnection(SocketHandle connectionSocket) {
+	pollfd connectionSocketPollEntry;
+	connectionSocketPollEntry.fd = connectionSocket;
+	connectionSocketPollEntry.events = POLLIN;
+
+	std::string requestData;
+	char receiveBuffer[RECEIVE_BUFFER_SIZE];
+
+	while(m_running) {
+		connectionSocketPollEntry.revents = 0;
+
+		if(pollSockets(&connectionSocketPollEntry, 1, SOCKET_POLL_INTERVAL_MS) <= 0) {
+			continue;
+		}
+
+		int numberOfBytesReceived = recv(connectionSocket, receiveBuffer, sizeof(receiveBuffer), 0);
+
+		if(numberOfBytesReceived <= 0) {
+			break;
+		}
+
+		requestData.append(receiveBuffer, numberOfBytesReceived);
+
+		// requests are bodyless, so every header terminator marks the end of a complete request
+		size_t headerTerminatorIndex = 0;
+		bool sendFailed = false;
+
+		while((headerTerminatorIndex = requestData.find(HTTP_HEADER_TERMINATOR)) != std::string::npos) {
+			requestData.erase(0, headerTerminatorIndex + HTTP_HEADER_TERMINATOR.length());
+			m_numberOfRequestsServed++;
+
+			std::string generatedResponse;
+
+			if(m_responseBodyFunction != nullptr) {
+				generatedResponse = createResponse(200, m_contentType, m_responseBodyFunction());
+			}
+
+			const std::string & response = m_responseBodyFunction != nullptr ? generatedResponse : m_response;
+			size_t numberOfBytesSent = 0;
+
+			while(numberOfBytesSent < response.length()) {
+				int sendResult = send(connectionSocket, response.data() + numberOfBytesSent, static_cast<int>(response.length() - numberOfBytesSent), SEND_FLAGS);
+
+				if(sendResult <= 0) {
+					sendFailed = true;
+					break;
+				}
+
+				numberOfBytesSent += sendResult;
+			}
+
+			if(sendFailed) {
+				break;
+			}
+		}
+
+		if(sendFailed) {
+			break;
+		}
+	}
+
+	closeSocket(connectionSocket);
+
+	std::lock_guard<std::mutex> lock(m_connectionThreadsMutex);
+	m_finishedConnectionThreadIDs.push_back(std::this_thread::get_id());
+}
+
+std::string LoopbackHTTPServer::createResponse(uint16_t statusCode, const std::string & contentType, const std::string & responseBody) {
+	return fmt::format("HTTP/1.1 {} {}\r\nContent-Type: {}\r\nContent-Length: {}\r\nConnection: keep-alive\r\n\r\n{}", statusCode, statusCode >= 200 && statusCode < 300 ? "OK" : "Error", contentType, responseBody.length(), responseBody);
+}
+
+void LoopbackHTTPServer::closeSocket(SocketHandle socket) {
+	if(socket == INVALID_SOCKET_HANDLE) {
+		return;
+	}
+
+#if _WIN32
+	closesocket(socket);
+#else
+	close(socket);
+#endif
+}
@@ -0,0 +1,60 @@
+#ifndef _LOOPBACK_HTTP_SERVER_H_
+#define _LOOPBACK_HTTP_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// minimal HTTP/1.1 server bound to the loopback interface which answers every request with the same canned response,
+// used as a local stand-in for remote endpoints when benchmarking or testing request handling,
+// or with a freshly generated body to expose local state such as metrics
+class LoopbackHTTPServer final {
+public:
+	typedef std::function<std::string()> ResponseBodyFunction;
+
+	LoopbackHTTPServer(uint16_t statusCode = 200, const std::string & contentType = "text/plain", const std::string & responseBody = {});
+	LoopbackHTTPServer(ResponseBodyFunction responseBodyFunction, const std::string & contentType = "text/plain");
+	~LoopbackHTTPServer();
+
+	bool isRunning() const;
+	uint16_t getPort() const;
+	std::string getBaseURL() const;
+	size_t numberOfRequestsServed() const;
+	bool start(uint16_t port = 0);
+	void stop();
+
+private:
+#if _WIN32
+	typedef uintptr_t SocketHandle;
+#else
+	typedef int SocketHandle;
+#endif
+
+	void acceptConnections();
+	void handleConnection(SocketHandle connectionSocket);
+	// joins connection threads which have finished, so that a long running server does not accumulate one thread per connection
+	void reapConnectionThreads();
+	static std::string createResponse(uint16_t statusCode, const std::string & contentType, const std::string & responseBody);
+	static void closeSocket(SocketHandle socket);
+
+	std::string m_response;
+	ResponseBodyFunction m_responseBodyFunction;
+	std::string m_contentType;
+	SocketHandle m_listeningSocket;
+	uint16_t m_port;
+	std::atomic<bool> m_running;
+	std::atomic<size_t> m_numberOfRequestsServed;
+	std::thread m_acceptThread;
+	std::vector<std::thread> m_connectionThreads;
+	std::vector<std::thread::id> m_finishedConnectionThreadIDs;
+	std::mutex m_connectionThreadsMutex;
+
+	LoopbackHTTPServer(const LoopbackHTTPServer &) = delete;
+	const LoopbackHTTPServer & operator = (const LoopbackHTTPServer &) = delete;
+};
+
+#endif // _LOOPBACK_HTTP_SERVER_H_
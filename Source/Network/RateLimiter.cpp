@@ -0,0 +1,234 @@
+#include "RateLimiter.h"
+
+#include "HTTPEventLoop.h"
+
+#include <Utilities/StringUtilities.h>
+
+#include <algorithm>
+
+const double RateLimiter::DEFAULT_REQUESTS_PER_SECOND = 5.0;
+const size_t RateLimiter::DEFAULT_BURST_SIZE = 10;
+const double RateLimiter::DEFAULT_DOMAIN_REQUESTS_PER_SECOND = 2.0;
+const size_t RateLimiter::DEFAULT_DOMAIN_BURST_SIZE = 5;
+
+static constexpr size_t DOMAIN_TOKEN_BUCKET_PRUNE_THRESHOLD = 256;
+
+RateLimiter::GrantAwaitable::GrantAwaitable(RateLimiter & rateLimiter, std::list<Waiter>::iterator waiterIterator)
+	: m_rateLimiter(rateLimiter)
+	, m_waiterIterator(waiterIterator) { }
+
+bool RateLimiter::GrantAwaitable::await_ready() const noexcept {
+	return false;
+}
+
+bool RateLimiter::GrantAwaitable::await_suspend(std::coroutine_handle<> awaitingCoroutine) {
+	std::lock_guard<std::mutex> lock(m_rateLimiter.m_mutex);
+
+	std::chrono::steady_clock::time_point nextGrantTime(m_rateLimiter.grantWaiters(std::chrono::steady_clock::now()));
+
+	if(m_waiterIterator->granted) {
+		return false;
+	}
+
+	m_waiterIterator->coroutine = awaitingCoroutine;
+	m_rateLimiter.scheduleGrantTimer(nextGrantTime);
+
+	return true;
+}
+
+void RateLimiter::GrantAwaitable::await_resume() {
+	std::lock_guard<std::mutex> lock(m_rateLimiter.m_mutex);
+
+	m_waiterIterator->coroutine = nullptr;
+
+	if(m_waiterIterator->timerScheduled) {
+		m_waiterIterator->timerScheduled = false;
+		m_rateLimiter.m_grantTimerScheduled = false;
+	}
+}
+
+RateLimiter::RateLimiter(double requestsPerSecond, size_t burstSize, double domainRequestsPerSecond, size_t domainBurstSize)
+	: m_tokenBucket(requestsPerSecond, burstSize)
+	, m_domainRequestsPerSecond(domainRequestsPerSecond)
+	, m_domainBurstSize(std::max(domainBurstSize, static_cast<size_t>(1)))
+	, m_grantTimerScheduled(false) { }
+
+RateLimiter::~RateLimiter() = default;
+
+double RateLimiter::getRequestsPerSecond() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_tokenBucket.getTokensPerSecond();
+}
+
+size_t RateLimiter::getBurstSize() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_tokenBucket.getBurstSize();
+}
+
+double RateLimiter::getDomainRequestsPerSecond() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_domainRequestsPerSecond;
+}
+
+size_t RateLimiter::getDomainBurstSize() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_domainBurstSize;
+}
+
+void RateLimiter::configure(double requestsPerSecond, size_t burstSize, double domainRequestsPerSecond, size_t domainBurstSize) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_tokenBucket.configure(requestsPerSecond, burstSize);
+	m_domainRequestsPerSecond = domainRequestsPerSecond;
+	m_domainBurstSize = std::max(domainBurstSize, static_cast<size_t>(1));
+
+	for(std::unordered_map<std::string, TokenBucket>::iterator i = m_domainTokenBuckets.begin(); i != m_domainTokenBuckets.end(); ++i) {
+		i->second.configure(m_domainRequestsPerSecond, m_domainBurstSize);
+	}
+
+	m_waitersChanged.notify_all();
+}
+
+size_t RateLimiter::numberOfWaitingRequests() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_waiters.size();
+}
+
+TokenBucket & RateLimiter::getDomainTokenBucket(const std::string & domainKey) {
+	return m_domainTokenBuckets.try_emplace(domainKey, m_domainRequestsPerSecond, m_domainBurstSize).first->second;
+}
+
+std::chrono::steady_clock::time_point RateLimiter::grantWaiters(std::chrono::steady_clock::time_point currentTime) {
+	std::chrono::steady_clock::time_point nextGrantTime(std::chrono::steady_clock::time_point::max());
+	bool waitersGranted = false;
+
+	for(Waiter & waiter : m_waiters) {
+		if(waiter.granted) {
+			continue;
+		}
+
+		if(!m_tokenBucket.hasToken(currentTime)) {
+			nextGrantTime = std::min(nextGrantTime, m_tokenBucket.getNextTokenTime(currentTime));
+			break;
+		}
+
+		TokenBucket & domainTokenBucket = getDomainTokenBucket(waiter.domainKey);
+
+		// skip past domains which are over their own limit, the first waiter reached for any other domain is its oldest
+		if(!domainTokenBucket.hasToken(currentTime)) {
+			nextGrantTime = std::min(nextGrantTime, domainTokenBucket.getNextTokenTime(currentTime));
+			continue;
+		}
+
+		m_tokenBucket.tryConsume(currentTime);
+		domainTokenBucket.tryConsume(currentTime);
+		waiter.granted = true;
+		waitersGranted = true;
+
+		// a coroutine holding the grant timer is resumed by it instead, so that it is never resumed twice
+		if(waiter.coroutine && !waiter.timerScheduled) {
+			waiter.eventLoop->schedule(waiter.coroutine);
+		}
+	}
+
+	if(waitersGranted) {
+		m_waitersChanged.notify_all();
+	}
+
+	scheduleGrantTimer(nextGrantTime);
+
+	return nextGrantTime;
+}
+
+void RateLimiter::scheduleGrantTimer(std::chrono::steady_clock::time_point nextGrantTime) {
+	if(m_grantTimerScheduled || nextGrantTime == std::chrono::steady_clock::time_point::max()) {
+		return;
+	}
+
+	for(Waiter & waiter : m_waiters) {
+		if(waiter.granted || !waiter.coroutine) {
+			continue;
+		}
+
+		waiter.timerScheduled = true;
+		m_grantTimerScheduled = true;
+		waiter.eventLoop->addTimer(nextGrantTime, waiter.coroutine);
+
+		break;
+	}
+}
+
+void RateLimiter::pruneDomainTokenBuckets(std::chrono::steady_clock::time_point currentTime) {
+	for(std::unordered_map<std::string, TokenBucket>::iterator i = m_domainTokenBuckets.begin(); i != m_domainTokenBuckets.end();) {
+		// a full bucket is indistinguishable from a newly created one, so it can be dropped as long as nobody is waiting on it
+		if(i->second.isFull(currentTime) && std::find_if(m_waiters.cbegin(), m_waiters.cend(), [&i](const Waiter & waiter) { return waiter.domainKey == i->first; }) == m_waiters.cend()) {
+			i = m_domainTokenBuckets.erase(i);
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+std::chrono::steady_clock::duration RateLimiter::acquire(std::string_view domain) {
+	std::chrono::steady_clock::time_point acquireStartTime(std::chrono::steady_clock::now());
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	if(m_domainTokenBuckets.size() >= DOMAIN_TOKEN_BUCKET_PRUNE_THRESHOLD) {
+		pruneDomainTokenBuckets(acquireStartTime);
+	}
+
+	std::list<Waiter>::iterator waiterIterator(m_waiters.insert(m_waiters.end(), { Utilities::toLowerCase(std::string(domain)), false }));
+
+	while(true) {
+		std::chrono::steady_clock::time_point nextGrantTime(grantWaiters(std::chrono::steady_clock::now()));
+
+		if(waiterIterator->granted) {
+			break;
+		}
+
+		if(nextGrantTime == std::chrono::steady_clock::time_point::max()) {
+			m_waitersChanged.wait(lock);
+		}
+		else {
+			m_waitersChanged.wait_until(lock, nextGrantTime);
+		}
+	}
+
+	m_waiters.erase(waiterIterator);
+
+	return std::chrono::steady_clock::now() - acquireStartTime;
+}
+
+Task<std::chrono::steady_clock::duration> RateLimiter::acquireAsync(std::string_view domain, HTTPEventLoop & eventLoop) {
+	std::chrono::steady_clock::time_point acquireStartTime(std::chrono::steady_clock::now());
+	std::list<Waiter>::iterator waiterIterator;
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if(m_domainTokenBuckets.size() >= DOMAIN_TOKEN_BUCKET_PRUNE_THRESHOLD) {
+			pruneDomainTokenBuckets(acquireStartTime);
+		}
+
+		waiterIterator = m_waiters.insert(m_waiters.end(), { Utilities::toLowerCase(std::string(domain)), false, nullptr, &eventLoop, false });
+	}
+
+	// only suspends when the request cannot be granted straight away, and is only resumed early by the grant timer
+	do {
+		co_await GrantAwaitable(*this, waiterIterator);
+	} while(!waiterIterator->granted);
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		m_waiters.erase(waiterIterator);
+	}
+
+	co_return std::chrono::steady_clock::now() - acquireStartTime;
+}
@@ -0,0 +1,87 @@
+#ifndef _RATE_LIMITER_H_
+#define _RATE_LIMITER_H_
+
+#include "TokenBucket.h"
+#include "Scheduling/Task.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+class HTTPEventLoop;
+
+// limits outbound requests with a global token bucket and a token bucket per domain, callers over the limit wait rather than fail,
+// waiters are released in arrival order among those whose domain has a token available, so a single busy domain cannot hold up the rest
+class RateLimiter final {
+public:
+	RateLimiter(double requestsPerSecond = DEFAULT_REQUESTS_PER_SECOND, size_t burstSize = DEFAULT_BURST_SIZE, double domainRequestsPerSecond = DEFAULT_DOMAIN_REQUESTS_PER_SECOND, size_t domainBurstSize = DEFAULT_DOMAIN_BURST_SIZE);
+	~RateLimiter();
+
+	double getRequestsPerSecond() const;
+	size_t getBurstSize() const;
+	double getDomainRequestsPerSecond() const;
+	size_t getDomainBurstSize() const;
+	void configure(double requestsPerSecond, size_t burstSize, double domainRequestsPerSecond, size_t domainBurstSize);
+	size_t numberOfWaitingRequests() const;
+
+	// blocks until a request for the domain may be sent, returns how long the caller waited
+	std::chrono::steady_clock::duration acquire(std::string_view domain);
+	// suspends the calling coroutine rather than its thread, queued alongside blocked callers and resumed on the event loop once granted,
+	// so a rate limiter must not be shared between an event loop and blocking callers running at the same time
+	Task<std::chrono::steady_clock::duration> acquireAsync(std::string_view domain, HTTPEventLoop & eventLoop);
+
+	static const double DEFAULT_REQUESTS_PER_SECOND;
+	static const size_t DEFAULT_BURST_SIZE;
+	static const double DEFAULT_DOMAIN_REQUESTS_PER_SECOND;
+	static const size_t DEFAULT_DOMAIN_BURST_SIZE;
+
+private:
+	struct Waiter {
+		std::string domainKey;
+		bool granted = false;
+		// set while a coroutine is suspended waiting for the grant, which schedules it on its event loop
+		std::coroutine_handle<> coroutine;
+		HTTPEventLoop * eventLoop = nullptr;
+		// whether the coroutine is instead resumed by a timer due when the next waiter can be granted
+		bool timerScheduled = false;
+	};
+
+	class GrantAwaitable final {
+	public:
+		GrantAwaitable(RateLimiter & rateLimiter, std::list<Waiter>::iterator waiterIterator);
+
+		bool await_ready() const noexcept;
+		bool await_suspend(std::coroutine_handle<> awaitingCoroutine);
+		void await_resume();
+
+	private:
+		RateLimiter & m_rateLimiter;
+		std::list<Waiter>::iterator m_waiterIterator;
+	};
+
+	TokenBucket & getDomainTokenBucket(const std::string & domainKey);
+	std::chrono::steady_clock::time_point grantWaiters(std::chrono::steady_clock::time_point currentTime);
+	// only the oldest suspended coroutine sleeps until the next grant time, the rest are resumed as they are granted
+	void scheduleGrantTimer(std::chrono::steady_clock::time_point nextGrantTime);
+	void pruneDomainTokenBuckets(std::chrono::steady_clock::time_point currentTime);
+
+	TokenBucket m_tokenBucket;
+	double m_domainRequestsPerSecond;
+	size_t m_domainBurstSize;
+	std::unordered_map<std::string, TokenBucket> m_domainTokenBuckets;
+	std::list<Waiter> m_waiters;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_waitersChanged;
+	bool m_grantTimerScheduled;
+
+	RateLimiter(const RateLimiter &) = delete;
+	const RateLimiter & operator = (const RateLimiter &) = delete;
+};
+
+#endif // _RATE_LIMITER_H_
@@ -0,0 +1,111 @@
+#include "RetryPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+const size_t RetryPolicy::DEFAULT_MAXIMUM_ATTEMPTS = 3;
+const std::chrono::milliseconds RetryPolicy::DEFAULT_INITIAL_DELAY(1000);
+const std::chrono::milliseconds RetryPolicy::DEFAULT_MAXIMUM_DELAY(30000);
+const double RetryPolicy::DEFAULT_BACKOFF_MULTIPLIER = 2.0;
+const double RetryPolicy::DEFAULT_JITTER = 0.5;
+
+RetryPolicy::RetryPolicy(size_t maximumAttempts, std::chrono::milliseconds initialDelay, std::chrono::milliseconds maximumDelay, double backoffMultiplier, double jitter)
+	: m_maximumAttempts(1)
+	, m_initialDelay(0)
+	, m_maximumDelay(0)
+	, m_backoffMultiplier(1.0)
+	, m_jitter(0.0) {
+	setMaximumAttempts(maximumAttempts);
+	setInitialDelay(initialDelay);
+	setMaximumDelay(maximumDelay);
+	setBackoffMultiplier(backoffMultiplier);
+	setJitter(jitter);
+}
+
+RetryPolicy::RetryPolicy(const RetryPolicy & retryPolicy)
+	: m_maximumAttempts(retryPolicy.m_maximumAttempts)
+	, m_initialDelay(retryPolicy.m_initialDelay)
+	, m_maximumDelay(retryPolicy.m_maximumDelay)
+	, m_backoffMultiplier(retryPolicy.m_backoffMultiplier)
+	, m_jitter(retryPolicy.m_jitter) { }
+
+RetryPolicy & RetryPolicy::operator = (const RetryPolicy & retryPolicy) {
+	m_maximumAttempts = retryPolicy.m_maximumAttempts;
+	m_initialDelay = retryPolicy.m_initialDelay;
+	m_maximumDelay = retryPolicy.m_maximumDelay;
+	m_backoffMultiplier = retryPolicy.m_backoffMultiplier;
+	m_jitter = retryPolicy.m_jitter;
+
+	return *this;
+}
+
+RetryPolicy::~RetryPolicy() { }
+
+size_t RetryPolicy::getMaximumAttempts() const {
+	return m_maximumAttempts;
+}
+
+void RetryPolicy::setMaximumAttempts(size_t maximumAttempts) {
+	m_maximumAttempts = std::max(maximumAttempts, static_cast<size_t>(1));
+}
+
+std::chrono::milliseconds RetryPolicy::getInitialDelay() const {
+	return m_initialDelay;
+}
+
+void RetryPolicy::setInitialDelay(std::chrono::milliseconds initialDelay) {
+	m_initialDelay = std::max(initialDelay, std::chrono::milliseconds(0));
+}
+
+std::chrono::milliseconds RetryPolicy::getMaximumDelay() const {
+	return m_maximumDelay;
+}
+
+void RetryPolicy::setMaximumDelay(std::chrono::milliseconds maximumDelay) {
+	m_maximumDelay = std::max(maximumDelay, std::chrono::milliseconds(0));
+}
+
+double RetryPolicy::getBackoffMultiplier() const {
+	return m_backoffMultiplier;
+}
+
+void RetryPolicy::setBackoffMultiplier(double backoffMultiplier) {
+	m_backoffMultiplier = std::isfinite(backoffMultiplier) ? std::max(backoffMultiplier, 1.0) : 1.0;
+}
+
+double RetryPolicy::getJitter() const {
+	return m_jitter;
+}
+
+void RetryPolicy::setJitter(double jitter) {
+	m_jitter = std::isfinite(jitter) ? std::clamp(jitter, 0.0, 1.0) : 0.0;
+}
+
+bool RetryPolicy::shouldRetry(size_t attempt) const {
+	return attempt < m_maximumAttempts;
+}
+
+std::chrono::milliseconds RetryPolicy::getBackoffDelay(size_t attempt) const {
+	if(attempt == 0) {
+		return std::chrono::milliseconds(0);
+	}
+
+	double delay = static_cast<double>(m_initialDelay.count()) * std::pow(m_backoffMultiplier, static_cast<double>(attempt - 1));
+
+	return std::chrono::milliseconds(static_cast<int64_t>(std::min(delay, static_cast<double>(m_maximumDelay.count()))));
+}
+
+std::chrono::milliseconds RetryPolicy::getRetryDelay(size_t attempt) const {
+	std::chrono::milliseconds backoffDelay(getBackoffDelay(attempt));
+
+	if(m_jitter == 0.0 || backoffDelay.count() == 0) {
+		return backoffDelay;
+	}
+
+	// randomly shorten each delay by up to the jitter fraction so that hosts which failed together do not retry in lockstep
+	thread_local std::mt19937_64 s_randomNumberGenerator(std::random_device{}());
+	std::uniform_real_distribution<double> jitterDistribution(1.0 - m_jitter, 1.0);
+
+	return std::chrono::milliseconds(static_cast<int64_t>(static_cast<double>(backoffDelay.count()) * jitterDistribution(s_randomNumberGenerator)));
+}
@@ -0,0 +1,43 @@
+#ifndef _RETRY_POLICY_H_
+#define _RETRY_POLICY_H_
+
+#include <chrono>
+#include <cstdint>
+
+class RetryPolicy final {
+public:
+	RetryPolicy(size_t maximumAttempts = DEFAULT_MAXIMUM_ATTEMPTS, std::chrono::milliseconds initialDelay = DEFAULT_INITIAL_DELAY, std::chrono::milliseconds maximumDelay = DEFAULT_MAXIMUM_DELAY, double backoffMultiplier = DEFAULT_BACKOFF_MULTIPLIER, double jitter = DEFAULT_JITTER);
+	RetryPolicy(const RetryPolicy & retryPolicy);
+	RetryPolicy & operator = (const RetryPolicy & retryPolicy);
+	~RetryPolicy();
+
+	size_t getMaximumAttempts() const;
+	void setMaximumAttempts(size_t maximumAttempts);
+	std::chrono::milliseconds getInitialDelay() const;
+	void setInitialDelay(std::chrono::milliseconds initialDelay);
+	std::chrono::milliseconds getMaximumDelay() const;
+	void setMaximumDelay(std::chrono::milliseconds maximumDelay);
+	double getBackoffMultiplier() const;
+	void setBackoffMultiplier(double backoffMultiplier);
+	double getJitter() const;
+	void setJitter(double jitter);
+
+	bool shouldRetry(size_t attempt) const;
+	std::chrono::milliseconds getBackoffDelay(size_t attempt) const;
+	std::chrono::milliseconds getRetryDelay(size_t attempt) const;
+
+	static const size_t DEFAULT_MAXIMUM_ATTEMPTS;
+	static const std::chrono::milliseconds DEFAULT_INITIAL_DELAY;
+	static const std::chrono::milliseconds DEFAULT_MAXIMUM_DELAY;
+	static const double DEFAULT_BACKOFF_MULTIPLIER;
+	static const double DEFAULT_JITTER;
+
+private:
+	size_t m_maximumAttempts;
+	std::chrono::milliseconds m_initialDelay;
+	std::chrono::milliseconds m_maximumDelay;
+	double m_backoffMultiplier;
+	double m_jitter;
+};
+
+#endif // _RETRY_POLICY_H_
@@ -0,0 +1,90 @@
+#include "TokenBucket.h"
+
+#include <algorithm>
+
+TokenBucket::TokenBucket(double tokensPerSecond, size_t burstSize)
+	: m_tokensPerSecond(tokensPerSecond)
+	, m_burstSize(std::max(burstSize, static_cast<size_t>(1)))
+	, m_tokens(static_cast<double>(m_burstSize))
+	, m_lastRefillTime(std::chrono::steady_clock::now()) { }
+
+TokenBucket::TokenBucket(const TokenBucket & tokenBucket)
+	: m_tokensPerSecond(tokenBucket.m_tokensPerSecond)
+	, m_burstSize(tokenBucket.m_burstSize)
+	, m_tokens(tokenBucket.m_tokens)
+	, m_lastRefillTime(tokenBucket.m_lastRefillTime) { }
+
+TokenBucket & TokenBucket::operator = (const TokenBucket & tokenBucket) {
+	m_tokensPerSecond = tokenBucket.m_tokensPerSecond;
+	m_burstSize = tokenBucket.m_burstSize;
+	m_tokens = tokenBucket.m_tokens;
+	m_lastRefillTime = tokenBucket.m_lastRefillTime;
+
+	return *this;
+}
+
+TokenBucket::~TokenBucket() = default;
+
+bool TokenBucket::isUnlimited() const {
+	return m_tokensPerSecond <= 0.0;
+}
+
+double TokenBucket::getTokensPerSecond() const {
+	return m_tokensPerSecond;
+}
+
+size_t TokenBucket::getBurstSize() const {
+	return m_burstSize;
+}
+
+void TokenBucket::configure(double tokensPerSecond, size_t burstSize) {
+	refill(std::chrono::steady_clock::now());
+
+	m_tokensPerSecond = tokensPerSecond;
+	m_burstSize = std::max(burstSize, static_cast<size_t>(1));
+	m_tokens = std::min(m_tokens, static_cast<double>(m_burstSize));
+}
+
+void TokenBucket::refill(std::chrono::steady_clock::time_point currentTime) {
+	if(currentTime <= m_lastRefillTime) {
+		return;
+	}
+
+	if(!isUnlimited()) {
+		m_tokens = std::min(m_tokens + std::chrono::duration<double>(currentTime - m_lastRefillTime).count() * m_tokensPerSecond, static_cast<double>(m_burstSize));
+	}
+
+	m_lastRefillTime = currentTime;
+}
+
+bool TokenBucket::isFull(std::chrono::steady_clock::time_point currentTime) {
+	refill(currentTime);
+
+	return isUnlimited() || m_tokens >= static_cast<double>(m_burstSize);
+}
+
+bool TokenBucket::hasToken(std::chrono::steady_clock::time_point currentTime) {
+	refill(currentTime);
+
+	return isUnlimited() || m_tokens >= 1.0;
+}
+
+bool TokenBucket::tryConsume(std::chrono::steady_clock::time_point currentTime) {
+	if(!hasToken(currentTime)) {
+		return false;
+	}
+
+	if(!isUnlimited()) {
+		m_tokens -= 1.0;
+	}
+
+	return true;
+}
+
+std::chrono::steady_clock::time_point TokenBucket::getNextTokenTime(std::chrono::steady_clock::time_point currentTime) {
+	if(hasToken(currentTime)) {
+		return currentTime;
+	}
+
+	return currentTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>((1.0 - m_tokens) / m_tokensPerSecond));
+}
@@ -0,0 +1,35 @@
+#ifndef _TOKEN_BUCKET_H_
+#define _TOKEN_BUCKET_H_
+
+#include <chrono>
+#include <cstdint>
+
+// refills at a fixed rate up to a burst capacity, each request consumes one token,
+// not synchronized since it is only ever used while its owner holds a lock
+class TokenBucket final {
+public:
+	TokenBucket(double tokensPerSecond = 0.0, size_t burstSize = 1);
+	TokenBucket(const TokenBucket & tokenBucket);
+	TokenBucket & operator = (const TokenBucket & tokenBucket);
+	~TokenBucket();
+
+	// a rate of zero or less disables the bucket, so that it always has tokens available
+	bool isUnlimited() const;
+	double getTokensPerSecond() const;
+	size_t getBurstSize() const;
+	void configure(double tokensPerSecond, size_t burstSize);
+	bool isFull(std::chrono::steady_clock::time_point currentTime);
+	bool hasToken(std::chrono::steady_clock::time_point currentTime);
+	bool tryConsume(std::chrono::steady_clock::time_point currentTime);
+	std::chrono::steady_clock::time_point getNextTokenTime(std::chrono::steady_clock::time_point currentTime);
+
+private:
+	void refill(std::chrono::steady_clock::time_point currentTime);
+
+	double m_tokensPerSecond;
+	size_t m_burstSize;
+	double m_tokens;
+	std::chrono::steady_clock::time_point m_lastRefillTime;
+};
+
+#endif // _TOKEN_BUCKET_H_
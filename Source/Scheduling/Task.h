@@ -0,0 +1,171 @@
+#ifndef _TASK_H_
+#define _TASK_H_
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+template <typename T = void>
+class Task;
+
+class TaskPromiseBase {
+public:
+	// resumes whichever coroutine awaited the task once it completes, without growing the stack
+	struct FinalAwaiter {
+		bool await_ready() const noexcept {
+			return false;
+		}
+
+		template <typename Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+			std::coroutine_handle<> continuation(handle.promise().getContinuation());
+
+			return continuation ? continuation : std::noop_coroutine();
+		}
+
+		void await_resume() const noexcept { }
+	};
+
+	std::suspend_always initial_suspend() const noexcept {
+		return {};
+	}
+
+	FinalAwaiter final_suspend() const noexcept {
+		return {};
+	}
+
+	// errors are reported through return values throughout, an exception escaping a task is a bug
+	void unhandled_exception() const noexcept {
+		std::terminate();
+	}
+
+	std::coroutine_handle<> getContinuation() const {
+		return m_continuation;
+	}
+
+	void setContinuation(std::coroutine_handle<> continuation) {
+		m_continuation = continuation;
+	}
+
+private:
+	std::coroutine_handle<> m_continuation;
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase {
+public:
+	Task<T> get_return_object() noexcept {
+		return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+	}
+
+	void return_value(T value) {
+		m_value.emplace(std::move(value));
+	}
+
+	T getValue() {
+		return std::move(m_value.value());
+	}
+
+private:
+	std::optional<T> m_value;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase {
+public:
+	Task<void> get_return_object() noexcept;
+
+	void return_void() const noexcept { }
+
+	void getValue() const { }
+};
+
+// lazily started coroutine, it does not run until it is awaited by another coroutine or scheduled on an event loop
+template <typename T>
+class Task final {
+public:
+	typedef TaskPromise<T> promise_type;
+
+	class Awaiter final {
+	public:
+		Awaiter(std::coroutine_handle<promise_type> handle) noexcept
+			: m_handle(handle) { }
+
+		bool await_ready() const noexcept {
+			return !m_handle || m_handle.done();
+		}
+
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaitingCoroutine) noexcept {
+			m_handle.promise().setContinuation(awaitingCoroutine);
+
+			return m_handle;
+		}
+
+		T await_resume() {
+			return m_handle.promise().getValue();
+		}
+
+	private:
+		std::coroutine_handle<promise_type> m_handle;
+	};
+
+	Task() noexcept
+		: m_handle(nullptr) { }
+
+	explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+		: m_handle(handle) { }
+
+	Task(Task && task) noexcept
+		: m_handle(std::exchange(task.m_handle, nullptr)) { }
+
+	Task & operator = (Task && task) noexcept {
+		if(this != &task) {
+			if(m_handle) {
+				m_handle.destroy();
+			}
+
+			m_handle = std::exchange(task.m_handle, nullptr);
+		}
+
+		return *this;
+	}
+
+	~Task() {
+		if(m_handle) {
+			m_handle.destroy();
+		}
+	}
+
+	bool isValid() const {
+		return static_cast<bool>(m_handle);
+	}
+
+	bool isDone() const {
+		return !m_handle || m_handle.done();
+	}
+
+	std::coroutine_handle<> getHandle() const {
+		return m_handle;
+	}
+
+	T getResult() {
+		return m_handle.promise().getValue();
+	}
+
+	Awaiter operator co_await() && noexcept {
+		return Awaiter(m_handle);
+	}
+
+private:
+	std::coroutine_handle<promise_type> m_handle;
+
+	Task(const Task &) = delete;
+	const Task & operator = (const Task &) = delete;
+};
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+	return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+#endif // _TASK_H_
@@ -0,0 +1,178 @@
+#include "TaskScheduler.h"
+
+#include <spdlog/spdlog.h>
+
+using namespace std::chrono_literals;
+
+const TaskScheduler::TaskID TaskScheduler::INVALID_TASK_ID = 0;
+const std::chrono::milliseconds TaskScheduler::MAXIMUM_STOP_POLL_INTERVAL = 250ms;
+
+bool TaskScheduler::QueueEntry::operator > (const QueueEntry & queueEntry) const {
+	if(dueTime == queueEntry.dueTime) {
+		return taskID > queueEntry.taskID;
+	}
+
+	return dueTime > queueEntry.dueTime;
+}
+
+TaskScheduler::TaskScheduler()
+	: m_nextTaskID(INVALID_TASK_ID + 1)
+	, m_running(false)
+	, m_stopRequested(false) { }
+
+TaskScheduler::~TaskScheduler() = default;
+
+size_t TaskScheduler::numberOfScheduledTasks() const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_tasks.size();
+}
+
+bool TaskScheduler::hasTask(TaskID taskID) const {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_tasks.find(taskID) != m_tasks.cend();
+}
+
+TaskScheduler::TaskID TaskScheduler::scheduleTask(Task task, std::chrono::milliseconds delay) {
+	return addTask(std::move(task), 0ms, delay);
+}
+
+TaskScheduler::TaskID TaskScheduler::scheduleRepeatingTask(Task task, std::chrono::milliseconds interval, std::chrono::milliseconds initialDelay) {
+	if(interval <= 0ms) {
+		spdlog::error("Repeating task interval must be greater than zero.");
+		return INVALID_TASK_ID;
+	}
+
+	return addTask(std::move(task), interval, initialDelay);
+}
+
+TaskScheduler::TaskID TaskScheduler::addTask(Task task, std::chrono::milliseconds interval, std::chrono::milliseconds delay) {
+	if(!task) {
+		return INVALID_TASK_ID;
+	}
+
+	std::chrono::steady_clock::time_point dueTime(std::chrono::steady_clock::now() + std::max(delay, 0ms));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	TaskID taskID = m_nextTaskID++;
+
+	m_tasks.emplace(taskID, ScheduledTask({ std::move(task), interval, dueTime }));
+	m_queue.push({ dueTime, taskID });
+	m_waitCondition.notify_all();
+
+	return taskID;
+}
+
+bool TaskScheduler::triggerTask(TaskID taskID) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::unordered_map<TaskID, ScheduledTask>::iterator taskIterator(m_tasks.find(taskID));
+
+	if(taskIterator == m_tasks.end()) {
+		return false;
+	}
+
+	// any queue entry with a stale due time is discarded when it is popped
+	taskIterator->second.nextDueTime = std::chrono::steady_clock::now();
+	m_queue.push({ taskIterator->second.nextDueTime, taskID });
+	m_waitCondition.notify_all();
+
+	return true;
+}
+
+bool TaskScheduler::cancelTask(TaskID taskID) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	return m_tasks.erase(taskID) != 0;
+}
+
+void TaskScheduler::cancelAllTasks() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_tasks.clear();
+	m_queue = decltype(m_queue)();
+}
+
+bool TaskScheduler::isRunning() const {
+	return m_running;
+}
+
+void TaskScheduler::run(const std::atomic<bool> * stopRequested) {
+	bool expectedRunning = false;
+
+	if(!m_running.compare_exchange_strong(expectedRunning, true)) {
+		spdlog::error("Task scheduler is already running.");
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	m_stopRequested = false;
+
+	while(true) {
+		if(m_stopRequested || (stopRequested != nullptr && *stopRequested)) {
+			break;
+		}
+
+		if(m_queue.empty()) {
+			if(stopRequested != nullptr) {
+				m_waitCondition.wait_for(lock, MAXIMUM_STOP_POLL_INTERVAL);
+			}
+			else {
+				m_waitCondition.wait(lock);
+			}
+
+			continue;
+		}
+
+		QueueEntry nextEntry(m_queue.top());
+		std::unordered_map<TaskID, ScheduledTask>::iterator taskIterator(m_tasks.find(nextEntry.taskID));
+
+		if(taskIterator == m_tasks.end() || taskIterator->second.nextDueTime != nextEntry.dueTime) {
+			m_queue.pop();
+			continue;
+		}
+
+		std::chrono::steady_clock::time_point currentTime(std::chrono::steady_clock::now());
+
+		if(nextEntry.dueTime > currentTime) {
+			std::chrono::steady_clock::time_point wakeTime(nextEntry.dueTime);
+
+			// stop signals cannot notify the condition variable, so wake up periodically to check for them
+			if(stopRequested != nullptr) {
+				wakeTime = std::min(wakeTime, currentTime + MAXIMUM_STOP_POLL_INTERVAL);
+			}
+
+			m_waitCondition.wait_until(lock, wakeTime);
+
+			continue;
+		}
+
+		m_queue.pop();
+
+		Task task(taskIterator->second.task);
+
+		if(taskIterator->second.interval > 0ms) {
+			taskIterator->second.nextDueTime = currentTime + taskIterator->second.interval;
+			m_queue.push({ taskIterator->second.nextDueTime, nextEntry.taskID });
+		}
+		else {
+			m_tasks.erase(taskIterator);
+		}
+
+		lock.unlock();
+		task();
+		lock.lock();
+	}
+
+	m_running = false;
+}
+
+void TaskScheduler::stop() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	m_stopRequested = true;
+	m_waitCondition.notify_all();
+}
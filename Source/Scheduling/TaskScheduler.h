@@ -0,0 +1,65 @@
+#ifndef _TASK_SCHEDULER_H_
+#define _TASK_SCHEDULER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+class TaskScheduler final {
+public:
+	typedef uint64_t TaskID;
+	typedef std::function<void()> Task;
+
+	TaskScheduler();
+	~TaskScheduler();
+
+	size_t numberOfScheduledTasks() const;
+	bool hasTask(TaskID taskID) const;
+	TaskID scheduleTask(Task task, std::chrono::milliseconds delay = std::chrono::milliseconds(0));
+	TaskID scheduleRepeatingTask(Task task, std::chrono::milliseconds interval, std::chrono::milliseconds initialDelay = std::chrono::milliseconds(0));
+	bool triggerTask(TaskID taskID);
+	bool cancelTask(TaskID taskID);
+	void cancelAllTasks();
+
+	bool isRunning() const;
+	void run(const std::atomic<bool> * stopRequested = nullptr);
+	void stop();
+
+	static const TaskID INVALID_TASK_ID;
+	static const std::chrono::milliseconds MAXIMUM_STOP_POLL_INTERVAL;
+
+private:
+	struct ScheduledTask {
+		Task task;
+		std::chrono::milliseconds interval;
+		std::chrono::steady_clock::time_point nextDueTime;
+	};
+
+	struct QueueEntry {
+		std::chrono::steady_clock::time_point dueTime;
+		TaskID taskID;
+
+		bool operator > (const QueueEntry & queueEntry) const;
+	};
+
+	TaskID addTask(Task task, std::chrono::milliseconds interval, std::chrono::milliseconds delay);
+
+	std::unordered_map<TaskID, ScheduledTask> m_tasks;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> m_queue;
+	TaskID m_nextTaskID;
+	std::atomic<bool> m_running;
+	bool m_stopRequested;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_waitCondition;
+
+	TaskScheduler(const TaskScheduler &) = delete;
+	const TaskScheduler & operator = (const TaskScheduler &) = delete;
+};
+
+#endif // _TASK_SCHEDULER_H_